@@ -10,9 +10,15 @@
 #include <memory>
 #include <vector>
 
+#include "AssetCache.hpp"
+#include "AudioMathSimd.hpp"
 #include "Config.hpp"
 #include "NodeRegistry.hpp"
 #include "Server.hpp"
+#include "HttpConnectionPool.hpp"
+#include "nodes/FileInputNode.hpp"
+#include "RTPStreamer.hpp"
+#include "TranscodeCache.hpp"
 #include "Types.hpp"
 
 using namespace hermes::net;
@@ -64,6 +70,12 @@ int main(int argc, char* argv[]) {
     auto cfg = std::move(*cfg_result);
 
     hermes::audio::register_builtin_nodes();
+    hermes::infra::AssetCache::instance().configure(cfg.cache.max_bytes,
+                                                    cfg.cache.max_file_bytes);
+    hermes::infra::TranscodeCache::instance().configure(cfg.transcode);
+    hermes::net::http::HttpConnectionPool::configure(cfg.http_pool);
+    hermes::audio::FileInputNode::configure(cfg.progressive);
+    hermes::net::rtp::RTPStreamer::configure(cfg.rtcp);
 
     asio::io_context main_ioc;
     auto server_result = Server::create(main_ioc, cfg);
@@ -85,6 +97,7 @@ int main(int argc, char* argv[]) {
 
     spdlog::info("Hermes Flow Server starting on {}:{}", cfg.server.address,
                  cfg.server.port);
+    spdlog::info("Mixer kernels: {}", simd::to_string(simd::active_isa()));
 
     server->start();
 
@@ -2,6 +2,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <filesystem>
 #include <toml++/toml.hpp>
@@ -69,6 +70,10 @@ std::expected<AppConfig, ErrorInfo> load_config(const std::string& path) {
     config.s3.bucket = s3["bucket"].value_or("audio-files");
     config.s3.region = s3["region"].value_or("us-east-1");
     config.s3.service = s3["service"].value_or("s3");
+    config.s3.part_size = static_cast<size_t>(s3["part_size"].value_or<int64_t>(
+        static_cast<int64_t>(config.s3.part_size)));
+    config.s3.part_concurrency = s3["part_concurrency"].value_or<size_t>(
+        config.s3.part_concurrency);
 
     if (const char* env_ak = std::getenv("S3_ACCESS_KEY")) {
       config.s3.access_key = env_ak;
@@ -101,6 +106,59 @@ std::expected<AppConfig, ErrorInfo> load_config(const std::string& path) {
         janus["port_end"].value_or<uint16_t>(uint16_t{DEFAULT_JANUS_PORT_END});
   }
 
+  if (auto cache = tbl["cache"]) {
+    config.cache.max_bytes =
+        static_cast<size_t>(cache["max_bytes"].value_or<int64_t>(
+            static_cast<int64_t>(config.cache.max_bytes)));
+    config.cache.max_file_bytes =
+        static_cast<size_t>(cache["max_file_bytes"].value_or<int64_t>(
+            static_cast<int64_t>(config.cache.max_file_bytes)));
+  }
+
+  if (auto transcode = tbl["transcode"]) {
+    config.transcode.enabled =
+        transcode["enabled"].value_or(config.transcode.enabled);
+    config.transcode.alaw = transcode["alaw"].value_or(config.transcode.alaw);
+    config.transcode.threads = transcode["threads"].value_or<unsigned int>(
+        config.transcode.threads);
+  }
+
+  if (auto pool = tbl["http_pool"]) {
+    config.http_pool.max_per_host = pool["max_per_host"].value_or<size_t>(
+        config.http_pool.max_per_host);
+    config.http_pool.idle_timeout_s =
+        pool["idle_timeout_s"].value_or<unsigned int>(
+            config.http_pool.idle_timeout_s);
+    config.http_pool.pipeline_depth = pool["pipeline_depth"].value_or<size_t>(
+        config.http_pool.pipeline_depth);
+  }
+
+  if (auto progressive = tbl["progressive"]) {
+    config.progressive.enabled =
+        progressive["enabled"].value_or(config.progressive.enabled);
+    config.progressive.prebuffer_buffers =
+        progressive["prebuffer_buffers"].value_or<size_t>(
+            config.progressive.prebuffer_buffers);
+  }
+
+  if (auto egress = tbl["egress"]) {
+    config.egress.sockets_per_thread =
+        egress["sockets_per_thread"].value_or<unsigned int>(
+            config.egress.sockets_per_thread);
+    config.egress.source_port =
+        egress["source_port"].value_or<uint16_t>(config.egress.source_port);
+    config.egress.reuse_port =
+        egress["reuse_port"].value_or(config.egress.reuse_port);
+  }
+
+  if (auto rtcp = tbl["rtcp"]) {
+    config.rtcp.enabled = rtcp["enabled"].value_or(config.rtcp.enabled);
+    config.rtcp.interval_ms = std::max(
+        rtcp["interval_ms"].value_or<unsigned int>(config.rtcp.interval_ms),
+        1U);
+    config.rtcp.mux = rtcp["mux"].value_or(config.rtcp.mux);
+  }
+
   if (auto crypto_node = tbl["crypto"]) {
     std::string key_hex = crypto_node["master_key"].value_or("");
     std::string salt_hex = crypto_node["salt"].value_or("");
@@ -112,6 +170,19 @@ std::expected<AppConfig, ErrorInfo> load_config(const std::string& path) {
 
     config.crypto.master_key = hex_to_bytes(key_hex);
     config.crypto.salt = hex_to_bytes(salt_hex);
+    config.crypto.srtp = crypto_node["srtp"].value_or(false);
+
+    // SRTP needs a 16-byte master key and at least the 14-byte master salt.
+    // Legacy configs are taken as they always were.
+    constexpr size_t SRTP_KEY_BYTES = 16;
+    constexpr size_t SRTP_SALT_BYTES = 14;
+    if (config.crypto.srtp &&
+        (config.crypto.master_key.size() != SRTP_KEY_BYTES ||
+         config.crypto.salt.size() < SRTP_SALT_BYTES)) {
+      throw std::runtime_error(
+          "With srtp = true, master_key must be 16 bytes (32 hex chars) and "
+          "salt at least 14 bytes (28 hex chars)");
+    }
   } else {
     throw std::runtime_error("Missing [crypto] section in config.toml");
   }
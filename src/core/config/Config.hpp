@@ -23,8 +23,56 @@ inline constexpr size_t FRAME_SIZE_BYTES =
 inline constexpr size_t WAV_HEADER_SIZE = 44;
 inline constexpr int MS = 20;
 inline constexpr size_t PAYLOAD_TYPE = 8;  // PCMA (G.711 A-law)
+// Opus target bitrate (bit/s) when a session streams Opus
+inline constexpr int OPUS_BITRATE = 32000;
 inline constexpr size_t BUFFER_SIZE = 1024UZ * 128UZ;
+// Idle BUFFER_SIZE blocks kept for reuse by streaming nodes, per BufferPool
+// shard, i.e. per io_context thread (8 MB)
+inline constexpr size_t BUFFER_POOL_MAX_IDLE_BLOCKS = 64;
 inline constexpr size_t RTP_HEADER_SIZE = 12;
+// Datagrams queued in a UdpEgress before it flushes without waiting for the tick
+inline constexpr size_t EGRESS_MAX_BATCH = 4096;
+// madvise(WILLNEED) window kept ahead of the play head for mmap'd assets
+inline constexpr size_t MMAP_READAHEAD_BYTES = BUFFER_SIZE * 2;
+// Source sample frames read per step when an asset needs resampling
+// (a power of two, so 1/2/4-channel chunks tile BUFFER_SIZE exactly)
+inline constexpr size_t RESAMPLER_CHUNK_FRAMES = 256;
+
+// Largest supported frame (48 kHz x 40 ms); sizes fixed per-node scratch
+inline constexpr size_t MAX_SAMPLES_PER_FRAME = 1920;
+inline constexpr size_t MAX_FRAME_SIZE_BYTES =
+    MAX_SAMPLES_PER_FRAME * BYTES_PER_SAMPLE;
+
+/**
+ * @brief Per-session audio frame geometry: sample rate x frame duration.
+ * The defaults are the historical 8 kHz / 20 ms (160 samples, 320 bytes).
+ */
+struct FrameGeometry {
+  uint32_t sample_rate = SAMPLE_RATE;
+  uint32_t frame_ms = FRAME_DURATION;
+
+  [[nodiscard]] constexpr size_t samples_per_frame() const {
+    return static_cast<size_t>(sample_rate) * frame_ms / 1000;
+  }
+
+  [[nodiscard]] constexpr size_t frame_bytes() const {
+    return samples_per_frame() * BYTES_PER_SAMPLE;
+  }
+
+  /// 8/16/48 kHz with 10/20/40 ms frames.
+  [[nodiscard]] constexpr bool is_supported() const {
+    bool rate_ok =
+        sample_rate == 8000 || sample_rate == 16000 || sample_rate == 48000;
+    bool ms_ok = frame_ms == 10 || frame_ms == 20 || frame_ms == 40;
+    return rate_ok && ms_ok;
+  }
+
+  constexpr bool operator==(const FrameGeometry&) const = default;
+};
+
+static_assert(FrameGeometry{}.frame_bytes() == FRAME_SIZE_BYTES);
+static_assert(FrameGeometry{48000, 40}.samples_per_frame() ==
+              MAX_SAMPLES_PER_FRAME);
 
 // Audio Soft-Clipping Limits (to avoid hardware distortion near max/min)
 inline constexpr float MAX_INT16 = 32767.0F;
@@ -44,6 +92,8 @@ struct S3Config {
   std::string port;
   std::string service;
   std::string bucket;
+  size_t part_size = 8UZ * 1024UZ * 1024UZ;  // Range GET size (0 = one GET)
+  size_t part_concurrency = 4;               // Ranges in flight per object
 };
 
 struct JnausConfig {
@@ -55,6 +105,48 @@ struct JnausConfig {
 struct CryptoConfig {
   std::vector<uint8_t> master_key;
   std::vector<uint8_t> salt;
+  bool srtp = false;  // RFC 3711 (salt[0..13] is the master salt); else legacy
+};
+
+struct CacheConfig {
+  size_t max_bytes = 64UZ * 1024UZ * 1024UZ;       // Resident decoded PCM
+  size_t max_file_bytes = 8UZ * 1024UZ * 1024UZ;   // Larger files stream
+};
+
+struct TranscodeConfig {
+  bool enabled = true;       // Convert downloads to canonical PCM once
+  bool alaw = true;          // Also precompute A-law for 8 kHz sessions
+  unsigned int threads = 1;  // Background workers (never io threads)
+};
+
+struct HttpPoolConfig {
+  size_t max_per_host = 4;           // Connections per host, per io thread
+  unsigned int idle_timeout_s = 30;  // Idle keep-alive connections close
+  size_t pipeline_depth = 4;         // Requests per connection (1 = off)
+};
+
+struct ProgressiveConfig {
+  bool enabled = true;           // Play assets while they download
+  size_t prebuffer_buffers = 2;  // BUFFER_SIZE blocks on disk before playing
+};
+
+struct EgressConfig {
+  unsigned int sockets_per_thread = 1;
+  uint16_t source_port = 0;  // 0 = ephemeral (per socket)
+  bool reuse_port = false;   // SO_REUSEPORT, lets threads share source_port
+};
+
+/// Socket options of one multicast target (a dedicated egress socket).
+struct MulticastConfig {
+  uint8_t ttl = 1;              // IP_MULTICAST_TTL: 1 = this subnet only
+  bool loopback = false;        // IP_MULTICAST_LOOP: also deliver locally
+  std::string interface_address;  // IP_MULTICAST_IF (IPv4); empty = default
+};
+
+struct RtcpConfig {
+  bool enabled = true;               // SR out, RR / NACK in (plain RTP only)
+  unsigned int interval_ms = 5000;   // Sender report period
+  bool mux = false;                  // RFC 5761: RTCP on the RTP port, not +1
 };
 
 struct AppConfig {
@@ -62,6 +154,12 @@ struct AppConfig {
   S3Config s3;
   JnausConfig janus;
   CryptoConfig crypto;
+  CacheConfig cache;
+  TranscodeConfig transcode;
+  HttpPoolConfig http_pool;
+  ProgressiveConfig progressive;
+  EgressConfig egress;
+  RtcpConfig rtcp;
 };
 
 enum class SessionType { Standard, StandartEncrypted, WebRTC };
@@ -6,6 +6,7 @@
 #include <boost/json.hpp>
 #include <cstdint>
 #include <string_view>
+#include <type_traits>
 
 namespace hermes::config {
 namespace json = boost::json;
@@ -20,6 +21,16 @@ using udp = boost::asio::ip::udp;
 /// The real-time audio frame tick interval (20ms = 50 frames/sec, 160 PCM samples @ 8kHz)
 constexpr auto AUDIO_TICK_INTERVAL = std::chrono::milliseconds(20);
 
+/// A FrameClock tick firing later than this counts as late (core overloaded)
+constexpr auto FRAME_CLOCK_LATE_THRESHOLD = std::chrono::milliseconds(5);
+/// Log one warning per this many late ticks
+constexpr uint64_t FRAME_CLOCK_LATE_LOG_EVERY = 250;
+/// Beyond this many missed ticks the clock resyncs instead of catching up
+constexpr int FRAME_CLOCK_MAX_CATCHUP_TICKS = 10;
+
+/// Log one warning per this many audio underruns in a session
+constexpr uint64_t UNDERRUN_LOG_EVERY = 250;
+
 enum class NodeErrorCode : std::uint8_t {
   Success = 0,
   Underrun,
@@ -58,6 +69,25 @@ struct NodeError {
                      node_id};
   }
 };
+/**
+ * @brief Per-frame result of the audio path.
+ *
+ * Trivially copyable and allocation-free: just the code and the execution
+ * plan stage that produced it. The human-readable NodeError is only built
+ * when someone needs it (AudioExecutor::describe()), i.e. off the 20ms path.
+ */
+struct FrameStatus {
+  static constexpr std::uint16_t NO_STAGE = 0xFFFF;
+
+  NodeErrorCode code = NodeErrorCode::Success;
+  std::uint16_t stage = NO_STAGE;
+
+  [[nodiscard]] constexpr bool ok() const {
+    return code == NodeErrorCode::Success;
+  }
+};
+static_assert(std::is_trivially_copyable_v<FrameStatus>);
+
 struct ErrorInfo {
   AppError code;
   std::string message;
@@ -91,6 +121,8 @@ inline std::string_view to_string(NodeErrorCode err) {
       return "InternalError";
     case NodeErrorCode::InitializationFailed:
       return "InitializationFailed";
+    case NodeErrorCode::NotSupported:
+      return "NotSupported";
 
     default:
       return "Unknown Error";
@@ -7,6 +7,7 @@
 #include <expected>
 #include <vector>
 
+#include "Alaw.hpp"
 #include "Nodes.hpp"
 #include "Types.hpp"
 
@@ -76,7 +77,7 @@ await_all_dynamic(boost::asio::io_context& io, const std::vector<T*>& items,
 
 #include "core/graph/Node.hpp"
 #include "spdlog/spdlog.h"
-#include "unordered_set"
+#include "unordered_map"
 using namespace hermes::service;
 
 namespace hermes::audio {
@@ -95,60 +96,103 @@ AudioExecutor::create(boost::asio::io_context& io, const Graph& graph,
 
 AudioExecutor::AudioExecutor(boost::asio::io_context& io, const Graph& graph,
                              config::S3Config s3_config)
-    : io_(io), graph_(graph), s3_config_(std::move(s3_config)) {
-  current_node_ = graph_.start_node;
-}
+    : io_(io), graph_(graph), s3_config_(std::move(s3_config)) {}
 
 SessionStats& AudioExecutor::get_stats() { return stats_; }
 
-void AudioExecutor::detect_and_flag_loops() const {
-  Node* curr = graph_.start_node;
-  std::unordered_set<Node*> visited;
-  Node* cycle_start = nullptr;
+void AudioExecutor::compile_plan() {
+  plan_.clear();
+  plan_inputs_.clear();
+
+  std::unordered_map<Node*, int32_t> stage_of;
+  int32_t prev = -1;
 
-  while (curr != nullptr) {
-    if (!visited.insert(curr).second) {
-      cycle_start = curr;  // Found the start of the cycle
+  for (Node* node = graph_.start_node; node != nullptr; node = node->next()) {
+    if (auto it = stage_of.find(node); it != stage_of.end()) {
+      // Back-edge: the loop body is every stage from the target onwards.
+      spdlog::info("Loop detected in graph! Flagging loop nodes...");
+      plan_[prev].next = it->second;
+      for (auto i = it->second; i <= prev; ++i) {
+        plan_[i].node->set_in_loop(true);
+      }
       break;
     }
-    curr = curr->next();
-  }
 
-  if (cycle_start != nullptr) {
-    spdlog::info("Loop detected in graph! Flagging loop nodes...");
-    Node* loop_node = cycle_start;
-    do {
-      loop_node->set_in_loop(true);
-      loop_node = loop_node->next();
-    } while (loop_node != cycle_start);
+    PlanStage stage{.kind = StageKind::Sink,
+                    .next = -1,
+                    .first_input = 0,
+                    .input_count = 0,
+                    .node = node};
+
+    switch (node->kind()) {
+      case NodeKind::FileInput:
+        stage.kind = StageKind::File;
+        break;
+      case NodeKind::Mixer: {
+        auto* mixer = static_cast<MixerNode*>(node);
+        mixer->set_max_frames();
+        stage.kind = StageKind::Mixer;
+        stage.first_input = static_cast<uint32_t>(plan_inputs_.size());
+        stage.input_count = static_cast<uint32_t>(mixer->inputs_.size());
+        plan_inputs_.insert(plan_inputs_.end(), mixer->inputs_.begin(),
+                            mixer->inputs_.end());
+        break;
+      }
+      case NodeKind::Delay:
+        stage.kind = StageKind::Silence;
+        break;
+      default:
+        // Clients / options: not audio processors, the graph ends here.
+        break;
+    }
+
+    auto index = static_cast<int32_t>(plan_.size());
+    stage_of.emplace(node, index);
+    if (prev >= 0) {
+      plan_[prev].next = index;
+    }
+    plan_.push_back(stage);
+    prev = index;
   }
+
+  spdlog::debug("Compiled execution plan: {} stages, {} mixer inputs",
+                plan_.size(), plan_inputs_.size());
 }
 
 boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
 AudioExecutor::prepare() {
   spdlog::info("Preparing Audio Graph...");
 
-  if (current_node_ == nullptr) {
+  if (graph_.start_node == nullptr) {
     co_return error(config::AppError::LogicError,
                     "Invalid Graph: No start node");
   }
 
+  // Frame sizes and durations must be fixed before any asset is resolved or
+  // buffer is sized.
+  for (const auto& node : graph_.nodes) {
+    node->set_geometry(graph_.geometry);
+  }
+
   auto fetch_res = co_await ensure_assets_exist();
   if (!fetch_res) {
     co_return std::unexpected(fetch_res.error());
   }
 
+  // Decided before initialize_nodes() so a passthrough file never loads
+  // its PCM.
+  passthrough_ = try_enable_passthrough();
+
   auto init_res = co_await initialize_nodes();
   if (!init_res) {
     co_return std::unexpected(init_res.error());
   }
 
-  update_mixers();
-
-  detect_and_flag_loops();
+  // Frame counts are only known once the nodes are initialized.
+  compile_plan();
 
-  current_node_ = graph_.start_node;
-  stats_.current_node_id = current_node_->id();
+  current_stage_ = plan_.empty() ? -1 : 0;
+  stats_.current_node_id = graph_.start_node->id();
   stats_.total_bytes_sent = 0;
 
   co_return std::expected<void, config::ErrorInfo>();
@@ -163,6 +207,35 @@ AudioExecutor::ensure_assets_exist() {
       [this](auto* node) { return node->ensure_file_exists(s3_config_); });
 }
 
+bool AudioExecutor::try_enable_passthrough() {
+  if (graph_.file_nodes.size() != 1 ||
+      graph_.start_node != graph_.file_nodes.front() ||
+      graph_.geometry.sample_rate != config::SAMPLE_RATE) {
+    return false;
+  }
+  if (graph_.clients_node != nullptr &&
+      graph_.clients_node->codec != CodecKind::Pcma) {
+    return false;
+  }
+
+  // Playback ends at the first sink; a self-loop replays the same file.
+  // Anything else after the file needs the PCM path.
+  auto* file = graph_.file_nodes.front();
+  if (Node* next = file->next(); next != nullptr && next != file &&
+                                 (next->kind() == NodeKind::FileInput ||
+                                  next->kind() == NodeKind::Mixer ||
+                                  next->kind() == NodeKind::Delay)) {
+    return false;
+  }
+
+  if (!file->attach_encoded()) {
+    return false;
+  }
+  spdlog::info("[AudioExecutor] Passthrough: [{}] streams pre-encoded PCMA.",
+               file->id());
+  return true;
+}
+
 boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
 AudioExecutor::initialize_nodes() {
   spdlog::info("Initializing async nodes...");
@@ -174,65 +247,123 @@ AudioExecutor::initialize_nodes() {
   co_return std::expected<void, config::ErrorInfo>();
 }
 
-void AudioExecutor::update_mixers() {
-  for (auto* mixer : graph_.mixer_nodes) {
-    mixer->set_max_frames();
-  }
-}
-std::pair<bool, config::NodeError> AudioExecutor::get_next_frame(
+std::pair<bool, config::FrameStatus> AudioExecutor::get_next_frame(
     std::span<uint8_t> output_buffer) {
-  if (current_node_ == nullptr || output_buffer.empty()) {
+  if (current_stage_ < 0 || output_buffer.empty()) {
     spdlog::error(
         "Invalid state: current node is null or output buffer is empty");
-    return {false, config::NodeError{config::NodeErrorCode::FormatError,
-                                     "Invalid state or buffer", ""}};
+    return {false, config::FrameStatus{config::NodeErrorCode::FormatError}};
   }
 
-  std::fill(output_buffer.begin(), output_buffer.end(), 0);
+  std::fill(output_buffer.begin(), output_buffer.end(),
+            passthrough_ ? ALAW_SILENCE : 0);
 
-  auto result = current_node_->process_frame(output_buffer);
+  const auto stage_index = static_cast<uint16_t>(current_stage_);
+  const PlanStage& stage = plan_[current_stage_];
+  auto code = config::NodeErrorCode::Success;
 
-  if (!result && result.error().code == config::NodeErrorCode::NotSupported) {
-    // Current node is not an audio processor, stop.
-    return {false, config::NodeError{config::NodeErrorCode::Success, "", ""}};
+  // Qualified calls: the stage kind already fixes the dynamic type.
+  switch (stage.kind) {
+    case StageKind::File: {
+      auto* file = static_cast<FileInputNode*>(stage.node);
+      if (!file->is_complete()) {
+        code = file->next_frame(output_buffer);
+      }
+      break;
+    }
+    case StageKind::Mixer:
+      code = static_cast<MixerNode*>(stage.node)->mix(
+          std::span<FileInputNode* const>(
+              plan_inputs_.data() + stage.first_input, stage.input_count),
+          output_buffer);
+      break;
+    case StageKind::Silence:
+      code = static_cast<DelayNode*>(stage.node)->next_frame(output_buffer);
+      break;
+    case StageKind::Sink:
+      // Current node is not an audio processor, stop.
+      return {false, config::FrameStatus{}};
   }
 
-  if (!result && result.error().code != config::NodeErrorCode::EndOfStream) {
+  if (code != config::NodeErrorCode::Success &&
+      code != config::NodeErrorCode::EndOfStream) {
     // Underruns are non-critical, we tell the caller to continue (true)
-    bool is_recoverable =
-        (result.error().code == config::NodeErrorCode::Underrun);
-    return {is_recoverable, result.error()};
+    bool is_recoverable = (code == config::NodeErrorCode::Underrun);
+    return {is_recoverable, config::FrameStatus{code, stage_index}};
   }
 
-  bool is_eos =
-      (!result && result.error().code == config::NodeErrorCode::EndOfStream);
-  if (is_eos || current_node_->is_complete()) {
-    auto transition_result = advance_to_next_node();
+  bool is_eos = (code == config::NodeErrorCode::EndOfStream);
+  if (is_eos || stage.node->is_complete()) {
+    auto transition_result = advance_stage();
     if (!transition_result) {
-      return {false, transition_result.error()};
+      last_error_ = std::move(transition_result.error());
+      return {false, config::FrameStatus{last_error_.code, stage_index}};
     }
   }
 
-  stats_.total_bytes_sent += hermes::config::FRAME_SIZE_BYTES;
+  // Passthrough frames are A-law, one byte per sample.
+  stats_.total_bytes_sent += passthrough_ ? graph_.geometry.samples_per_frame()
+                                          : graph_.geometry.frame_bytes();
 
-  return {(current_node_ != nullptr),
-          config::NodeError{config::NodeErrorCode::Success, "", ""}};
+  return {(current_stage_ >= 0), config::FrameStatus{}};
 }
 
-std::expected<void, config::NodeError> AudioExecutor::advance_to_next_node() {
-  auto close_result = current_node_->close();
+config::NodeError AudioExecutor::describe(config::FrameStatus status) const {
+  if (status.ok()) {
+    return config::NodeError{config::NodeErrorCode::Success, "", ""};
+  }
+
+  // A failed close() already carries its own message.
+  if (!last_error_.message.empty() && last_error_.code == status.code) {
+    return last_error_;
+  }
+
+  std::string node_id;
+  if (status.stage < plan_.size()) {
+    node_id = plan_[status.stage].node->id();
+  }
+
+  switch (status.code) {
+    case config::NodeErrorCode::Underrun:
+      return config::NodeError::From(status.code, node_id,
+                                     "Buffer underrun in [{}]", node_id);
+    case config::NodeErrorCode::EndOfStream:
+      return config::NodeError::From(status.code, node_id,
+                                     "End of stream for [{}]", node_id);
+    case config::NodeErrorCode::FormatError:
+      if (status.stage == config::FrameStatus::NO_STAGE) {
+        return config::NodeError{status.code, "Invalid state or buffer", ""};
+      }
+      [[fallthrough]];
+    default:
+      return config::NodeError::From(status.code, node_id, "[{}] {}", node_id,
+                                     config::to_string(status.code));
+  }
+}
+
+std::string_view AudioExecutor::stage_id(config::FrameStatus status) const {
+  if (status.stage < plan_.size()) {
+    return plan_[status.stage].node->id();
+  }
+  return "";
+}
+
+std::expected<void, config::NodeError> AudioExecutor::advance_stage() {
+  const PlanStage& stage = plan_[current_stage_];
+
+  auto close_result = stage.node->close();
   if (!close_result) {
     return std::unexpected(close_result.error());
   }
 
-  spdlog::info(
-      "Node [{}] finished. Transitioning to [{}]", current_node_->id(),
-      current_node_->next() != nullptr ? current_node_->next()->id() : "END");
+  Node* next = stage.next >= 0 ? plan_[stage.next].node : nullptr;
+  spdlog::info("Node [{}] finished. Transitioning to [{}]", stage.node->id(),
+               next != nullptr ? next->id() : "END");
 
-  current_node_ = current_node_->next();
+  current_stage_ = stage.next;
 
-  if (current_node_ != nullptr) {
-    stats_.current_node_id = current_node_->id();
+  if (next != nullptr) {
+    stats_.current_node_id = next->id();
   }
 
   return {};
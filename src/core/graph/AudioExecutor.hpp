@@ -11,6 +11,21 @@
 #include "Node.hpp"
 namespace hermes::audio {
 
+enum class StageKind : uint8_t { File, Mixer, Silence, Sink };
+
+/**
+ * @brief One step of the compiled execution plan.
+ * Kept small and trivially copyable so the whole plan sits in a few cache
+ * lines.
+ */
+struct PlanStage {
+  StageKind kind;
+  int32_t next;          ///< Index of the following stage, -1 = end of graph
+  uint32_t first_input;  ///< Mixer: first entry in the plan's input table
+  uint32_t input_count;  ///< Mixer: number of inputs
+  Node* node;            ///< Node owning the stage's state
+};
+
 class AudioExecutor {
  public:
   /**
@@ -44,13 +59,36 @@ class AudioExecutor {
   boost::asio::awaitable<std::expected<void, config::ErrorInfo>> prepare();
 
   /**
-   * @brief pull data from the current node that is being proccesed
+   * @brief Runs the compiled plan for one frame.
+   * No virtual dispatch, no allocation and no logging per frame: problems
+   * come back as a FrameStatus, see describe().
    * @param output_buffer buffer for the mixed PCM audio.
    * @return true if a frame was produced, false if the graph is over .
    */
-  std::pair<bool, config::NodeError> get_next_frame(
+  std::pair<bool, config::FrameStatus> get_next_frame(
       std::span<uint8_t> output_buffer);
 
+  /**
+   * @brief Expands a FrameStatus into a full NodeError (message + node id).
+   * Allocates: call it when reporting, not on every frame.
+   */
+  config::NodeError describe(config::FrameStatus status) const;
+
+  /**
+   * @brief Id of the node behind a FrameStatus ("" if none).
+   */
+  std::string_view stage_id(config::FrameStatus status) const;
+
+  /** @brief Frame geometry every node of this graph runs at. */
+  const config::FrameGeometry& geometry() const { return graph_.geometry; }
+
+  /**
+   * @brief True when prepare() found the graph to be a single effect-free
+   * file with a precomputed A-law copy. get_next_frame() then yields
+   * ready-to-send PCMA payloads of samples_per_frame() bytes instead of PCM.
+   */
+  bool is_passthrough() const { return passthrough_; }
+
  private:
   /**
    * @brief Helper to iterate all nodes and ensure files exist locally.
@@ -59,30 +97,31 @@ class AudioExecutor {
   boost::asio::awaitable<std::expected<void, config::ErrorInfo>> fetch_files();
 
   /**
-   * @brief Configures mixer nodes based on their inputs.
-   * Calculates total frame duration for mixers to know when to stop.
+   * @brief Lowers the linked Graph into plan_: one stage per node in play
+   * order, mixer inputs flattened into plan_inputs_, frame counts resolved,
+   * and the loop back-edge (if any) resolved to a stage index with the loop
+   * body flagged.
    */
-  void update_mixers();
+  void compile_plan();
 
   /**
-   * @brief Handles the lifecycle teardown of the current node and advances the
-   * graph.
+   * @brief Closes the current stage's node and moves to its successor.
    * @return std::expected containing void on success, or a NodeError if close()
    * fails.
    */
-  std::expected<void, config::NodeError> advance_to_next_node();
-
-  /**
-   * @brief Traverses the graph to find any cycles (loops) and flags the
-   * involved nodes.
-   */
-  void detect_and_flag_loops() const;
+  std::expected<void, config::NodeError> advance_stage();
 
   boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
   ensure_assets_exist();
 
   boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
   initialize_nodes();
+
+  /**
+   * @brief Switches a lone, effect-free file input to its A-law copy when
+   * the session streams PCMA at 8 kHz (no mixing, no encoding per frame).
+   */
+  bool try_enable_passthrough();
   template <typename... Args>
   std::unexpected<config::ErrorInfo> error(config::AppError code,
                                            std::format_string<Args...> fmt,
@@ -93,8 +132,12 @@ class AudioExecutor {
   }
   boost::asio::io_context& io_;
   const Graph& graph_;
-  Node* current_node_ = nullptr;
+  std::vector<PlanStage> plan_;
+  std::vector<FileInputNode*> plan_inputs_;
+  int32_t current_stage_ = -1;
+  config::NodeError last_error_{config::NodeErrorCode::Success, "", ""};
   service::SessionStats stats_;
   config::S3Config s3_config_;
+  bool passthrough_ = false;
 };
 };  // namespace hermes::audio
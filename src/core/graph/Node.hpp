@@ -2,6 +2,7 @@
 #include <spdlog/spdlog.h>
 #include <stdlib.h>
 
+#include <Config.hpp>
 #include <Types.hpp>
 #include <expected>
 #include <memory>
@@ -38,6 +39,18 @@ struct Node : public std::enable_shared_from_this<Node> {
   }
 [[nodiscard]] bool is_in_loop() const { return is_in_loop_; }
   virtual void set_in_loop(bool val);
+
+  [[nodiscard]] const config::FrameGeometry& geometry() const {
+    return geometry_;
+  }
+  /**
+   * @brief Applies the session's frame geometry. Called once before
+   * initialize_buffers(); nodes that size anything per frame override it.
+   */
+  virtual void set_geometry(const config::FrameGeometry& geometry) {
+    geometry_ = geometry;
+  }
+
   /** * @brief Resets counters. Essential for re-using the graph.
    */
   virtual void reset_state() {
@@ -70,6 +83,7 @@ struct Node : public std::enable_shared_from_this<Node> {
   int total_frames_{0};
   int in_buffer_processed_frames_{0};
   bool is_in_loop_{false};
+  config::FrameGeometry geometry_{};
 
   template <typename... Args>
   std::unexpected<config::NodeError> error(config::NodeErrorCode code,
@@ -93,5 +107,6 @@ struct Graph {
   std::vector<FileInputNode*> file_nodes;
   std::vector<MixerNode*> mixer_nodes;
   ClientsNode* clients_node = nullptr;
+  config::FrameGeometry geometry{};  ///< Flow-level "audio" settings
 };
 }  // namespace hermes::audio
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <boost/asio/io_context.hpp>
+#include <atomic>
 #include <boost/json.hpp>
 #include <concepts>
 #include <expected>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 
@@ -17,6 +19,43 @@ using NodeCreatorSignature =
         boost::asio::io_context&, const boost::json::object&);
 using NodeCreator = std::function<NodeCreatorSignature>;
 
+/**
+ * @brief Pool resource backing the graph nodes built on the calling thread.
+ * One per thread, so concurrent graph builds do not share a lock; still
+ * synchronized because graphs are torn down on session threads (the
+ * allocator in each node's control block frees into the resource it came
+ * from). Freed nodes are recycled for the next session burst instead of
+ * going back to malloc. Leaked on purpose (outlives all graphs).
+ */
+inline std::pmr::memory_resource* node_memory_resource() {
+  thread_local auto* pool =
+      new std::pmr::synchronized_pool_resource();  // NOLINT
+  return pool;
+}
+
+/**
+ * @brief Whether make_pooled_node() draws from node_memory_resource() (the
+ * default) or plain new/delete. Only benchmarks turn it off, to compare;
+ * nodes already built still free into the resource they came from.
+ */
+inline std::atomic<bool>& node_pooling_enabled() {
+  static std::atomic<bool> enabled{true};
+  return enabled;
+}
+
+/**
+ * @brief make_shared for graph nodes: object and control block in a single
+ * allocation from node_memory_resource().
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> make_pooled_node(Args&&... args) {
+  auto* resource = node_pooling_enabled().load(std::memory_order_relaxed)
+                       ? node_memory_resource()
+                       : std::pmr::new_delete_resource();
+  return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource),
+                                 std::forward<Args>(args)...);
+}
+
 template <typename F>
 concept IsNodeCreator = requires(F f, boost::asio::io_context& io,
                                  const boost::json::object& data) {
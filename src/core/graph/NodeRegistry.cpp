@@ -2,6 +2,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include <boost/asio/ip/address_v4.hpp>
 #include <charconv>
 #include <cstdint>
 #include <expected>
@@ -94,12 +95,12 @@ std::expected<std::shared_ptr<Node>, ErrorInfo> create_file_input(
   std::string name = *name_res;
   std::string path = std::string(DOWNLOADS_DIR) + name;
 
-  return std::make_unique<FileInputNode>(io, name, path);
+  return make_pooled_node<FileInputNode>(io, name, path);
 }
 
 std::expected<std::shared_ptr<Node>, ErrorInfo> create_mixer(
     boost::asio::io_context&, const json::object&) {
-  return std::make_unique<MixerNode>();
+  return make_pooled_node<MixerNode>();
 }
 
 std::expected<std::shared_ptr<Node>, ErrorInfo> create_delay(
@@ -113,13 +114,13 @@ std::expected<std::shared_ptr<Node>, ErrorInfo> create_delay(
         return delay_sec;
       })
       .transform([](float delay_sec) {
-        return std::make_unique<DelayNode>(delay_sec);
+        return make_pooled_node<DelayNode>(delay_sec);
       });
 }
 
 std::expected<std::shared_ptr<Node>, ErrorInfo> create_file_options(
     boost::asio::io_context&, const json::object& data) {
-  auto node = std::make_unique<FileOptionsNode>();
+  auto node = make_pooled_node<FileOptionsNode>();
 
   auto gain_res = require_json<double>(data, "gain");
   if (!gain_res) return std::unexpected(gain_res.error());
@@ -132,9 +133,86 @@ std::expected<std::shared_ptr<Node>, ErrorInfo> create_file_options(
   return node;
 }
 
+/**
+ * @brief Multicast settings of a client entry, or nullopt for unicast.
+ * A client is a multicast target if its "type" is "multicast" or its "ip" is
+ * an IPv4 multicast group; "ttl", "interface" (IPv4 address of the outgoing
+ * NIC) and "loopback" are optional.
+ */
+std::expected<std::optional<MulticastConfig>, ErrorInfo> parse_multicast(
+    const json::object& client, const std::string& ip) {
+  std::string type = "unicast";
+  if (client.contains("type")) {
+    auto type_res = require_json<std::string>(client, "type");
+    if (!type_res) return std::unexpected(type_res.error());
+    type = *type_res;
+    if (type != "unicast" && type != "multicast") {
+      return std::unexpected(ErrorInfo::From(
+          AppError::ParseError, "Unknown client type '{}' for {}", type, ip));
+    }
+  }
+
+  boost::system::error_code ec;
+  auto address = boost::asio::ip::make_address_v4(ip, ec);
+  const bool is_group = !ec && address.is_multicast();
+  if (type == "multicast" && !is_group) {
+    return std::unexpected(ErrorInfo::From(
+        AppError::ParseError, "{} is not an IPv4 multicast group", ip));
+  }
+  if (!is_group) {
+    return std::nullopt;
+  }
+
+  MulticastConfig cfg;
+  if (client.contains("ttl")) {
+    auto ttl_res = require_json<int64_t>(client, "ttl");
+    if (!ttl_res) return std::unexpected(ttl_res.error());
+    constexpr int64_t MAX_TTL = 255;
+    if (*ttl_res < 0 || *ttl_res > MAX_TTL) {
+      return std::unexpected(ErrorInfo::From(
+          AppError::ParseError, "Multicast ttl for {} must be 0-255", ip));
+    }
+    cfg.ttl = static_cast<uint8_t>(*ttl_res);
+  }
+  if (client.contains("interface")) {
+    auto if_res = require_json<std::string>(client, "interface");
+    if (!if_res) return std::unexpected(if_res.error());
+    boost::asio::ip::make_address_v4(*if_res, ec);
+    if (ec) {
+      return std::unexpected(ErrorInfo::From(
+          AppError::ParseError, "Multicast interface for {} must be an IPv4 "
+          "address, got '{}'", ip, *if_res));
+    }
+    cfg.interface_address = *if_res;
+  }
+  if (client.contains("loopback")) {
+    auto loop_res = require_json<bool>(client, "loopback");
+    if (!loop_res) return std::unexpected(loop_res.error());
+    cfg.loopback = *loop_res;
+  }
+  return cfg;
+}
+
 std::expected<std::shared_ptr<Node>, ErrorInfo> create_clients(
     boost::asio::io_context&, const json::object& data) {
-  auto node = std::make_unique<ClientsNode>();
+  auto node = make_pooled_node<ClientsNode>();
+
+  if (data.contains("codec")) {
+    auto codec_res = require_json<std::string>(data, "codec");
+    if (!codec_res) return std::unexpected(codec_res.error());
+
+    auto codec = parse_codec_kind(*codec_res);
+    if (!codec) {
+      return std::unexpected(ErrorInfo::From(
+          AppError::ParseError, "Unknown codec '{}'", *codec_res));
+    }
+    if (!is_codec_available(*codec)) {
+      return std::unexpected(ErrorInfo::From(
+          AppError::ParseError, "Codec '{}' is not available in this build",
+          *codec_res));
+    }
+    node->codec = *codec;
+  }
 
   if (data.contains("clients")) {
     auto arr_res = require_json<json::array>(data, "clients");
@@ -166,7 +244,10 @@ std::expected<std::shared_ptr<Node>, ErrorInfo> create_clients(
         loss_ratio = *loss_res;
       }
 
-      node->add_client(ip, *port_res, loss_ratio);
+      auto multicast_res = parse_multicast(client_ojson, ip);
+      if (!multicast_res) return std::unexpected(multicast_res.error());
+
+      node->add_client(ip, *port_res, loss_ratio, std::move(*multicast_res));
     }
   }
   return node;
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <expected>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "CodecStrategy.hpp"
 #include "Config.hpp"
 #include "Node.hpp"
 
@@ -33,16 +35,21 @@ struct ClientConfig {
   std::string ip;
   uint16_t port;
   double packet_loss_ratio = 0.0;  // 0.0 עד 1.0
+  /// Set for a multicast group: sent once per frame for all its listeners.
+  std::optional<config::MulticastConfig> multicast;
 };
 struct ClientsNode : Node {
   std::vector<ClientConfig> clients;
+  CodecKind codec{CodecKind::Pcma};  ///< Wire codec for every client
 
   explicit ClientsNode(Node* t = nullptr) : Node(t) {
     kind_ = NodeKind::Clients;
   }
 
-  void add_client(std::string ip, uint16_t port, double packet_loss_ratio) {
-    clients.push_back({std::move(ip), port, packet_loss_ratio});
+  void add_client(std::string ip, uint16_t port, double packet_loss_ratio,
+                  std::optional<config::MulticastConfig> multicast = {}) {
+    clients.push_back(
+        {std::move(ip), port, packet_loss_ratio, std::move(multicast)});
   }
 
   void set_in_loop(bool val) override { is_in_loop_ = val; };
@@ -72,14 +79,26 @@ struct DelayNode : Node {
   }
 
   void set_in_loop(bool val) override { is_in_loop_ = val; };
+
+  // The frame count depends on the frame duration
+  void set_geometry(const config::FrameGeometry& geometry) override {
+    Node::set_geometry(geometry);
+    total_frames_ =
+        static_cast<int>(delay_ms_ / static_cast<float>(geometry.frame_ms));
+  }
   std::expected<void, config::NodeError> process_frame(
       std::span<uint8_t> frame_buffer) override {
+    next_frame(frame_buffer);
+    return {};
+  }
+
+  config::NodeErrorCode next_frame(std::span<uint8_t> frame_buffer) {
     // Fill buffer with silence (0)
     std::fill(frame_buffer.begin(), frame_buffer.end(), 0);
 
     in_buffer_processed_frames_++;
     processed_frames_++;
-    return {};
+    return config::NodeErrorCode::Success;
   }
 
   std::expected<void, config::NodeError> close() override {
@@ -7,17 +7,45 @@
 #include <expected>
 
 #include "BasicNodes.hpp"
-#include "FileSink.hpp"
+#include "Alaw.hpp"
+#include "DownloadProgress.hpp"
+#include "DownloadRegistry.hpp"
+#include "TranscodeCache.hpp"
 #include "core/config/Config.hpp"
 #include "core/config/Types.hpp"
 #include "infra/audio/PcmCast.hpp"
 #include "infra/audio/WavUtils.hpp"
-#include "network/s3/S3Session.hpp"  // Corrected header path for S3Session
+#include "network/s3/S3RangedDownloader.hpp"
 
 using namespace hermes::config;
 
 namespace hermes::audio {
 
+namespace {
+
+config::ProgressiveConfig& progressive_settings() {
+  static config::ProgressiveConfig cfg;
+  return cfg;
+}
+
+}  // namespace
+
+void FileInputNode::configure(const config::ProgressiveConfig& cfg) {
+  progressive_settings() = cfg;
+#ifdef _WIN32
+  // The downloader renames "<path>.part" into place on completion, which
+  // fails while a session still has it open (no FILE_SHARE_DELETE).
+  if (cfg.enabled) {
+    spdlog::warn("[FileInput] Progressive playback is not supported on "
+                 "Windows; assets play once downloaded.");
+    progressive_settings().enabled = false;
+  }
+#endif
+  spdlog::info("[FileInput] Progressive playback {}, prebuffer {} buffers.",
+               progressive_settings().enabled ? "on" : "off",
+               progressive_settings().prebuffer_buffers);
+}
+
 FileInputNode::FileInputNode(boost::asio::io_context& io, std::string name,
                              std::string path)
     : file_name_(std::move(name)),
@@ -25,9 +53,6 @@ FileInputNode::FileInputNode(boost::asio::io_context& io, std::string name,
       file_handle_(io),
       io_(io) {
   kind_ = NodeKind::FileInput;
-
-  buffer_controller_ = std::make_shared<AsyncBufferController>(
-      io_, [this](std::span<uint8_t> dest) { return fetch_bytes(dest); });
 }
 
 std::expected<void, NodeError> FileInputNode::open() {
@@ -36,10 +61,17 @@ std::expected<void, NodeError> FileInputNode::open() {
   boost::system::error_code ec;
 
   while (attempt < max_retries) {
-    file_handle_.open(file_path_,
+    auto path = streaming_path();
+    file_handle_.open(path,
                       boost::asio::file_base::
                           read_only,  // NOLINT(bugprone-unused-return-value)
                       ec);
+    if (ec && path != file_path_) {
+      // The download finished and renamed the partial file in between.
+      path = file_path_;
+      file_handle_.open(path, boost::asio::file_base::read_only,  // NOLINT
+                        ec);
+    }
 
     if (!ec && file_handle_.is_open()) {
       constexpr size_t HEADER_BUF_SIZE = 256;
@@ -48,9 +80,21 @@ std::expected<void, NodeError> FileInputNode::open() {
           file_handle_.read_some(boost::asio::buffer(header_buf), ec);
 
       size_t offset = 0;
+      std::optional<wav::WavFormat> format;
       if (!ec && bytes_read > 0) {
-        offset = wav::get_audio_data_offset(
-            std::span<uint8_t>(header_buf.data(), bytes_read));
+        auto header = std::span<const uint8_t>(header_buf.data(), bytes_read);
+        offset = wav::get_audio_data_offset(header);
+        format = wav::parse_format(header);
+      }
+
+      if (!configure_source(format)) {
+        file_handle_.close(ec);  // NOLINT
+        total_frames_ = 0;
+        return error(NodeErrorCode::FormatError,
+                     "{}: unsupported WAV encoding (format {}, {} bits, {} Hz);"
+                     " only 16-bit PCM up to {} Hz is supported",
+                     file_name_, format->audio_format, format->bits_per_sample,
+                     format->sample_rate, wav::WavFormat::MAX_SAMPLE_RATE);
       }
 
       file_handle_.seek(static_cast<int64_t>(offset),
@@ -62,12 +106,15 @@ std::expected<void, NodeError> FileInputNode::open() {
         file_handle_.seek(0, boost::asio::file_base::seek_set, ec);
       }
 
-      uint64_t file_size = file_handle_.size(ec);
-      total_frames_ =
-          static_cast<int>((file_size > static_cast<uint64_t>(offset)
-                                ? file_size - static_cast<uint64_t>(offset)
-                                : 0ULL) /
-                           FRAME_SIZE_BYTES);
+      stream_offset_ = payload_offset_ = static_cast<uint64_t>(offset);
+
+      // A partial file is only as long as what has arrived so far.
+      uint64_t file_size = progress_ && progress_->total()
+                               ? *progress_->total()
+                               : file_handle_.size(ec);
+      total_frames_ = frames_in(file_size > static_cast<uint64_t>(offset)
+                                    ? file_size - static_cast<uint64_t>(offset)
+                                    : 0ULL);
 
       spdlog::info("[{}] Opened file. Offset: {}, Total frames: {}", file_name_,
                    offset, total_frames_);
@@ -75,7 +122,7 @@ std::expected<void, NodeError> FileInputNode::open() {
     }
 
     spdlog::warn("[{}] Attempt {}: Failed to open file {}: {}", file_name_,
-                 attempt + 1, file_path_, ec.message());
+                 attempt + 1, path, ec.message());
     attempt++;
   }
 
@@ -96,10 +143,22 @@ std::expected<void, NodeError> FileInputNode::close() {
   spdlog::info("closed file input {}", file_name_);
   // Reset internal state for potential reuse
   processed_frames_ = 0;
+  source_offset_ = 0;
   pitch_shifter_.reset();
+  if (resampler_) {
+    resampler_->reset();
+  }
+
+  // Cached/mapped PCM (or A-law) is immutable and already resident; nothing
+  // to refill.
+  if (!resident_pcm_.empty()) {
+    return {};
+  }
 
   // Reset the buffer component
-  buffer_controller_->reset();
+  if (buffer_controller_) {
+    buffer_controller_->reset();
+  }
 
   if (this->is_in_loop()) {
     spdlog::info("[{}] Node is in a loop. Refilling buffers asynchronously...",
@@ -124,25 +183,310 @@ std::expected<void, NodeError> FileInputNode::close() {
 void FileInputNode::set_in_loop(bool val) { is_in_loop_ = val; }
 
 boost::asio::awaitable<void> FileInputNode::initialize_buffers() {
+  // A download that finished since the last pass is an ordinary file now.
+  if (progress_ && progress_->done() && progress_->result()) {
+    progress_.reset();
+  }
+
+  if (!resident_pcm_.empty() ||
+      (!progress_ && (co_await attach_cached_asset() || attach_mapped_file()))) {
+    co_return;
+  }
+
+  if (!buffer_controller_) {
+    // A refill may wait on the download for a long time: it must not keep
+    // a finished session's node alive, nor touch it once it is gone.
+    std::weak_ptr<Node> weak = shared_from_this();
+    buffer_controller_ = std::make_shared<AsyncBufferController>(
+        io_,
+        [weak](std::span<uint8_t> dest) -> boost::asio::awaitable<size_t> {
+          auto self = std::static_pointer_cast<FileInputNode>(weak.lock());
+          if (!self) {
+            co_return 0;
+          }
+          co_return co_await self->fetch_bytes(dest);
+        });
+  }
   co_await buffer_controller_->initialize_buffers();
 }
 
+boost::asio::awaitable<bool> FileInputNode::attach_cached_asset() {
+  auto& cache = infra::AssetCache::instance();
+
+  std::error_code fs_ec;
+  auto file_size = std::filesystem::file_size(file_path_, fs_ec);
+  if (fs_ec || !cache.accepts(file_size)) {
+    co_return false;
+  }
+  auto mtime = std::filesystem::last_write_time(file_path_, fs_ec);
+  if (fs_ec) {
+    co_return false;
+  }
+
+  auto asset = cache.lookup(file_path_, mtime);
+  if (!asset) {
+    asset = co_await load_asset(file_size, mtime);
+    if (!asset) {
+      co_return false;
+    }
+    asset = cache.publish(std::move(asset));
+  }
+
+  if (!configure_source(asset->format)) {
+    co_return false;
+  }
+
+  cached_asset_ = std::move(asset);
+  resident_pcm_ = cached_asset_->pcm;
+  total_frames_ = frames_in(resident_pcm_.size());
+  spdlog::info("[{}] Serving from asset cache. Total frames: {}", file_name_,
+               total_frames_);
+  co_return true;
+}
+
+boost::asio::awaitable<std::shared_ptr<const infra::CachedAsset>>
+FileInputNode::load_asset(std::uintmax_t file_size,
+                          std::filesystem::file_time_type mtime) {
+  boost::asio::stream_file file(io_);
+  boost::system::error_code ec;
+  file.open(file_path_, boost::asio::file_base::read_only,  // NOLINT
+            ec);
+  if (ec) {
+    spdlog::warn("[{}] Cache load: failed to open {}: {}", file_name_,
+                 file_path_, ec.message());
+    co_return nullptr;
+  }
+
+  auto asset = std::make_shared<infra::CachedAsset>();
+  asset->path = file_path_;
+  asset->mtime = mtime;
+  asset->pcm.resize(static_cast<size_t>(file_size));
+
+  auto [read_ec, bytes_read] = co_await boost::asio::async_read(
+      file, boost::asio::buffer(asset->pcm),
+      boost::asio::as_tuple(boost::asio::use_awaitable));
+  file.close(ec);  // NOLINT
+
+  if (read_ec && read_ec != boost::asio::error::eof) {
+    spdlog::warn("[{}] Cache load: read failed: {}", file_name_,
+                 read_ec.message());
+    co_return nullptr;
+  }
+
+  // Strip the header in place and keep whole sample frames only. The asset
+  // is shared across geometries, so frames are counted by each node.
+  auto& pcm = asset->pcm;
+  pcm.resize(bytes_read);
+  asset->format = wav::parse_format(pcm);
+  if (asset->format && !asset->format->is_pcm16()) {
+    co_return nullptr;  // Rejected with a message by the streaming path
+  }
+  const size_t block_align =
+      asset->format ? asset->format->block_align : BYTES_PER_SAMPLE;
+  size_t offset = std::min(wav::get_audio_data_offset(pcm), pcm.size());
+  size_t payload = ((pcm.size() - offset) / block_align) * block_align;
+  pcm.erase(pcm.begin(), pcm.begin() + static_cast<std::ptrdiff_t>(offset));
+  pcm.resize(payload);
+  pcm.shrink_to_fit();
+
+  co_return asset;
+}
+
+bool FileInputNode::attach_encoded() {
+  if (!encoded_path_ || has_effects()) {
+    return false;
+  }
+
+  auto mapped = infra::MappedFile::open(*encoded_path_);
+  if (!mapped) {
+    spdlog::debug("[{}] Cannot map {} ({}), encoding per frame.", file_name_,
+                  *encoded_path_, mapped.error());
+    return false;
+  }
+
+  // One byte per sample: a frame is samples_per_frame() bytes.
+  auto bytes = (*mapped)->bytes();
+  const size_t frame_size = geometry_.samples_per_frame();
+  const auto frames = static_cast<int>(bytes.size() / frame_size);
+  if (frames == 0) {
+    return false;
+  }
+
+  mapped_file_ = std::move(*mapped);
+  resident_pcm_ = bytes.first(static_cast<size_t>(frames) * frame_size);
+  mapped_file_->prefetch(0, MMAP_READAHEAD_BYTES);
+  resampler_.reset();
+  total_frames_ = frames;
+  encoded_ = true;
+
+  spdlog::info("[{}] Passthrough from {}. Total frames: {}", file_name_,
+               *encoded_path_, total_frames_);
+  return true;
+}
+
+bool FileInputNode::attach_mapped_file() {
+  auto mapped = infra::MappedFile::open(file_path_);
+  if (!mapped) {
+    spdlog::debug("[{}] mmap unavailable ({}), streaming instead.", file_name_,
+                  mapped.error());
+    return false;
+  }
+
+  auto bytes = (*mapped)->bytes();
+  if (!configure_source(wav::parse_format(bytes))) {
+    return false;
+  }
+
+  size_t offset = std::min(wav::get_audio_data_offset(bytes), bytes.size());
+  int frames = frames_in(bytes.size() - offset);
+  if (frames == 0) {
+    return false;
+  }
+
+  // Direct playback reads whole frames; conversion reads whole sample frames.
+  size_t unit = resampler_ ? source_block_align_ : geometry_.frame_bytes();
+  size_t payload = resampler_ ? ((bytes.size() - offset) / unit) * unit
+                              : static_cast<size_t>(frames) * unit;
+
+  mapped_file_ = std::move(*mapped);
+  resident_pcm_ = bytes.subspan(offset, payload);
+  mapped_file_->prefetch(offset, MMAP_READAHEAD_BYTES);
+  total_frames_ = frames;
+
+  spdlog::info("[{}] Mapped file. Offset: {}, Total frames: {}", file_name_,
+               offset, total_frames_);
+  return true;
+}
+
 std::expected<void, config::NodeError> FileInputNode::process_frame(
     std::span<uint8_t> buffer) {
-  if (processed_frames_ >= total_frames_ && total_frames_ > 0) {
-    std::fill(buffer.begin(), buffer.end(), 0);
-    return error(NodeErrorCode::EndOfStream, "End of stream for {}", id_);
+  switch (next_frame(buffer)) {
+    case NodeErrorCode::Success:
+      return {};
+    case NodeErrorCode::EndOfStream:
+      return error(NodeErrorCode::EndOfStream, "End of stream for {}", id_);
+    case NodeErrorCode::Underrun:
+      return error(NodeErrorCode::Underrun, "Buffer underrun");
+    default:
+      return error(NodeErrorCode::InternalError,
+                   "Node {} processed before initialize_buffers()", id_);
   }
+}
 
-  auto result = buffer_controller_->get_frame(buffer, 0);
+NodeErrorCode FileInputNode::next_frame(std::span<uint8_t> buffer) {
+  if (processed_frames_ >= total_frames_ && total_frames_ > 0) {
+    std::fill(buffer.begin(), buffer.end(), encoded_ ? ALAW_SILENCE : 0);
+    return NodeErrorCode::EndOfStream;
+  }
 
-  if (!result) {
-    return result;
+  auto code = resampler_ ? convert_frame(buffer) : read_source(buffer);
+  if (code != NodeErrorCode::Success) {
+    return code;
   }
   apply_effects(buffer);
 
   processed_frames_++;
-  return {};
+  return NodeErrorCode::Success;
+}
+
+NodeErrorCode FileInputNode::read_source(std::span<uint8_t> dest) {
+  if (!resident_pcm_.empty()) {
+    const size_t offset = source_offset_;
+    if (offset >= resident_pcm_.size()) {
+      std::fill(dest.begin(), dest.end(), 0);
+      return NodeErrorCode::EndOfStream;
+    }
+
+    // Entering a new window: keep the kernel one window ahead of the play
+    // head.
+    if (mapped_file_ && offset % MMAP_READAHEAD_BYTES < dest.size()) {
+      auto base = static_cast<size_t>(resident_pcm_.data() -
+                                      mapped_file_->bytes().data());
+      mapped_file_->prefetch(base + offset + MMAP_READAHEAD_BYTES,
+                             MMAP_READAHEAD_BYTES);
+    }
+
+    auto chunk = resident_pcm_.subspan(
+        offset, std::min(dest.size(), resident_pcm_.size() - offset));
+    auto tail = std::copy(chunk.begin(), chunk.end(), dest.begin());
+    std::fill(tail, dest.end(), 0);
+    source_offset_ += chunk.size();
+    return NodeErrorCode::Success;
+  }
+
+  if (buffer_controller_) {
+    return buffer_controller_->get_frame(dest, 0);
+  }
+
+  std::fill(dest.begin(), dest.end(), 0);
+  return NodeErrorCode::InternalError;
+}
+
+NodeErrorCode FileInputNode::convert_frame(std::span<uint8_t> buffer) {
+  auto out = pcm::as_samples(buffer);
+
+  while (!resampler_->can_produce(out.size())) {
+    auto code = read_source(source_chunk_);
+    if (code != NodeErrorCode::Success &&
+        code != NodeErrorCode::EndOfStream) {
+      // Nothing was consumed; the next tick resumes from here.
+      std::fill(buffer.begin(), buffer.end(), 0);
+      return code;
+    }
+    // At EndOfStream source_chunk_ is silence, which flushes the filter.
+    resampler_->push(
+        pcm::as_samples(std::span<const uint8_t>(source_chunk_)));
+  }
+
+  resampler_->pull(out);
+  return NodeErrorCode::Success;
+}
+
+bool FileInputNode::configure_source(
+    const std::optional<wav::WavFormat>& format) {
+  if (format && !format->is_pcm16()) {
+    return false;
+  }
+
+  // Headerless PCM is assumed to already be in the session format.
+  const bool matches =
+      !format || (format->sample_rate == geometry_.sample_rate &&
+                  format->channels == config::CHANNELS);
+  if (matches) {
+    source_block_align_ = static_cast<uint16_t>(BYTES_PER_SAMPLE);
+    resampler_.reset();
+    return true;
+  }
+
+  source_block_align_ = format->block_align;
+  if (resampler_ && resampler_->input_rate() == format->sample_rate &&
+      resampler_->output_rate() == geometry_.sample_rate &&
+      resampler_->channels() == format->channels) {
+    resampler_->reset();
+    return true;
+  }
+
+  // Built once per source (and again only if the file changes format).
+  resampler_ = std::make_unique<Resampler>(
+      format->sample_rate, geometry_.sample_rate, format->channels,
+      geometry_.samples_per_frame(), RESAMPLER_CHUNK_FRAMES);
+  source_chunk_.assign(RESAMPLER_CHUNK_FRAMES * source_block_align_, 0);
+
+  spdlog::info("[{}] Converting {} Hz / {} ch to {} Hz mono ({} taps/phase, "
+               "{})",
+               file_name_, format->sample_rate, format->channels,
+               geometry_.sample_rate, resampler_->taps_per_phase(),
+               Resampler::active_isa());
+  return true;
+}
+
+int FileInputNode::frames_in(uint64_t payload_bytes) const {
+  if (!resampler_) {
+    return static_cast<int>(payload_bytes / geometry_.frame_bytes());
+  }
+  uint64_t samples =
+      resampler_->output_length(payload_bytes / source_block_align_);
+  return static_cast<int>(samples / geometry_.samples_per_frame());
 }
 
 // -----------------------------
@@ -158,6 +502,23 @@ boost::asio::awaitable<size_t> FileInputNode::fetch_bytes(
     }
   }
 
+  // Never read past the downloaded prefix: wait for it instead, which the
+  // controller reports as Underrun if playback gets there first.
+  if (progress_ && !progress_->done()) {
+    const uint64_t want =
+        std::min(stream_offset_ + dest.size(),
+                 progress_->total().value_or(stream_offset_ + dest.size()));
+    co_await progress_->wait_for(want);
+    if (progress_->done() && !progress_->result()) {
+      spdlog::error("[{}] Download failed during playback: {}", file_name_,
+                    progress_->result().error().message);
+      // End the asset with what was already buffered.
+      total_frames_ = std::min(total_frames_,
+                               frames_in(stream_offset_ - payload_offset_));
+      co_return 0;
+    }
+  }
+
   constexpr int max_retries = 3;
   int attempt = 0;
 
@@ -167,6 +528,7 @@ boost::asio::awaitable<size_t> FileInputNode::fetch_bytes(
         boost::asio::as_tuple(boost::asio::use_awaitable));
 
     if (!ec || ec == boost::asio::error::eof) {
+      stream_offset_ += bytes_read;
       co_return bytes_read;
     } else {
       spdlog::warn("[{}] Read attempt {} failed: {}", file_name_, attempt + 1,
@@ -183,8 +545,13 @@ boost::asio::awaitable<size_t> FileInputNode::fetch_bytes(
   co_return 0;
 }
 
+bool FileInputNode::has_effects() const {
+  return options_ != nullptr &&
+         (options_->gain != 1.0 || options_->pitch_shift != 0.0);
+}
+
 void FileInputNode::apply_effects(std::span<uint8_t> frame_buffer) {
-  if (options_ == nullptr) {
+  if (!has_effects()) {
     return;
   }
 
@@ -207,41 +574,113 @@ void FileInputNode::apply_effects(std::span<uint8_t> frame_buffer) {
 }
 
 boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
-FileInputNode::download_from_s3(const config::S3Config& s3_config) {
-  auto session_result = hermes::net::s3::S3Session::create(io_, s3_config);
-  if (!session_result) {
-    co_return std::unexpected(session_result.error());
+FileInputNode::download_from_s3(
+    boost::asio::io_context& io, const config::S3Config& s3_config,
+    const std::string& file_key, const std::string& file_path,
+    std::shared_ptr<infra::DownloadProgress> progress) {
+  auto downloader = hermes::net::s3::S3RangedDownloader::create(io, s3_config);
+  if (!downloader) {
+    co_return std::unexpected(downloader.error());
   }
 
-  auto s3_session = std::move(session_result.value());
-  infra::FileSink sink(io_);
-
-  if (auto res = sink.Prepare(file_path_); !res) {
-    co_return std::unexpected(config::ErrorInfo::From(
-        config::AppError::FileSystemError, "Sink Prep Failed: " + res.error()));
-  }
-
-  auto download_result = co_await s3_session->request_file(file_name_, sink);
+  // Written to "<path>.part" and renamed into place only when complete.
+  auto download_result = co_await (*downloader)->download(
+      file_key, file_path, std::move(progress));
   if (!download_result) {
-    // Note: PartialFileGuard handles cleanup automatically here
+    spdlog::error("[{}] Download failed: {}", file_key,
+                  download_result.error().message);
     co_return std::unexpected(download_result.error());
   }
-
-  sink.Commit();
-  spdlog::info("[{}] Download complete.", file_name_);
+  spdlog::info("[{}] Download complete.", file_key);
 
   co_return std::expected<void, config::ErrorInfo>{};
 }
 
 boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
 FileInputNode::ensure_file_exists(const config::S3Config& s3_config) {
-  if (std::filesystem::exists(file_path_)) {
-    co_return std::expected<void, config::ErrorInfo>{};
+  // Concurrent sessions share one transfer per object. It runs detached
+  // from this node, so it only captures values.
+  auto* io = &io_;
+  auto progress = infra::DownloadRegistry::instance().start(
+      io_.get_executor(), file_name_, file_path_,
+      [io, s3_config, key = file_name_, path = file_path_](
+          std::shared_ptr<infra::DownloadProgress> progress)
+          -> boost::asio::awaitable<std::expected<void, config::ErrorInfo>> {
+        spdlog::info("[{}] File missing, initiating S3 download...", key);
+        co_return co_await download_from_s3(*io, s3_config, key, path,
+                                            std::move(progress));
+      });
+
+  if (progress) {
+    auto progressive = co_await await_prebuffer(progress);
+    if (!progressive) {
+      co_return std::unexpected(progressive.error());
+    }
+    if (*progressive) {
+      // Canonical copies can only be built from the complete file.
+      boost::asio::co_spawn(
+          io_,
+          [progress, path = file_path_,
+           rate = geometry_.sample_rate]() -> boost::asio::awaitable<void> {
+            if (co_await progress->wait_done()) {
+              infra::TranscodeCache::instance().schedule(path, rate);
+            }
+          },
+          boost::asio::detached);
+      co_return std::expected<void, config::ErrorInfo>{};
+    }
+  }
+
+  // Prefer the canonical copy: headerless PCM at the session rate needs no
+  // parsing or resampling. Without one, build it for the next session.
+  auto& transcoder = infra::TranscodeCache::instance();
+  if (geometry_.sample_rate == SAMPLE_RATE) {
+    encoded_path_ = transcoder.lookup_alaw(file_path_);
+  }
+  if (auto canonical =
+          transcoder.lookup_pcm(file_path_, geometry_.sample_rate)) {
+    spdlog::info("[{}] Using transcoded {}", file_name_, *canonical);
+    file_path_ = std::move(*canonical);
+  } else {
+    transcoder.schedule(file_path_, geometry_.sample_rate);
   }
 
-  spdlog::info("[{}] File missing, initiating S3 download...", file_name_);
+  co_return std::expected<void, config::ErrorInfo>{};
+}
 
-  co_return co_await download_from_s3(s3_config);
+boost::asio::awaitable<std::expected<bool, config::ErrorInfo>>
+FileInputNode::await_prebuffer(
+    std::shared_ptr<infra::DownloadProgress> progress) {
+  const auto& cfg = progressive_settings();
+  if (cfg.enabled) {
+    // The WAV header rides along with the first buffer.
+    const uint64_t prebuffer =
+        static_cast<uint64_t>(std::max<size_t>(cfg.prebuffer_buffers, 1)) *
+        BUFFER_SIZE;
+    co_await progress->wait_for(prebuffer);
+
+    // Without a known size the node could not tell the end of the asset
+    // from a slow download; play it once complete.
+    if (!progress->done() && progress->total()) {
+      progress_ = std::move(progress);
+      spdlog::info("[{}] Progressive playback: {} of {} bytes downloaded.",
+                   file_name_, progress_->available(), *progress_->total());
+      co_return true;
+    }
+  }
+
+  auto result = co_await progress->wait_done();
+  if (!result) {
+    co_return std::unexpected(result.error());
+  }
+  co_return false;
+}
+
+std::string FileInputNode::streaming_path() const {
+  if (progress_ && !progress_->done()) {
+    return file_path_ + ".part";
+  }
+  return file_path_;
 }
 
 void FileInputNode::set_options(FileOptionsNode* options_node) {
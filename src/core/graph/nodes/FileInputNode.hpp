@@ -8,16 +8,38 @@
 #include <span>
 #include <expected>
 
+#include "AssetCache.hpp"
 #include "AsyncBufferController.hpp" // Replaced AsyncAudioSource
+#include "DownloadProgress.hpp"
+#include "MappedFile.hpp"
 #include "BasicNodes.hpp"
 #include "PitchShifter.hpp"
+#include "Resampler.hpp"
+#include "WavUtils.hpp"
 #include "core/config/Types.hpp"
 
 namespace hermes::audio {
 
 /**
  * @brief Specific implementation for Disk Files.
- * Inherits buffering magic from AsyncBufferController via composition.
+ * Small files are served straight from the shared infra::AssetCache, larger
+ * ones from a read-only mmap of the file. Either way frames are read from
+ * resident_pcm_ with no intermediate buffers. Where neither is possible the
+ * node streams through an AsyncBufferController (composition).
+ *
+ * WAV files whose fmt chunk does not match the session geometry (other rate,
+ * more channels) are downmixed and resampled on the fly, between the source
+ * and apply_effects().
+ *
+ * In passthrough mode (attach_encoded()) the node serves precomputed G.711
+ * A-law instead of PCM: frames are samples_per_frame() bytes and go to the
+ * packetizer as they are.
+ *
+ * Progressive playback: when the asset is still downloading, the node only
+ * waits for the first few buffers, then streams from the growing
+ * "<path>.part" file. Reads never pass the downloaded prefix; if playback
+ * catches up with the download the refill waits and the node reports
+ * Underrun (silence) rather than EndOfStream.
  */
 struct FileInputNode : public Node {
   // --- File Specific Members ---
@@ -30,15 +52,29 @@ struct FileInputNode : public Node {
   explicit FileInputNode(boost::asio::io_context& io, std::string name,
                          std::string path);
 
+  /**
+   * @brief Process-wide progressive playback settings; call before the io
+   * threads start.
+   */
+  static void configure(const config::ProgressiveConfig& cfg);
+
+  /**
+   * @brief Makes the asset playable: on disk, or (progressive playback)
+   * downloading with its first prebuffer_buffers buffers already written.
+   */
   boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
   ensure_file_exists(const config::S3Config& s3_config);
 
   /**
    * @brief Internal helper to handle the S3 download logic.
-   * Separates infrastructure (networking) from audio domain logic.
+   * Separates infrastructure (networking) from audio domain logic. Static:
+   * the transfer is shared and may outlive the node that started it.
    */
-  boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
-  download_from_s3(const config::S3Config& s3_config);
+  static boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
+  download_from_s3(boost::asio::io_context& io,
+                   const config::S3Config& s3_config,
+                   const std::string& file_key, const std::string& file_path,
+                   std::shared_ptr<infra::DownloadProgress> progress);
 
   virtual std::expected<void, config::NodeError> connect_input(
       Node* source) override;
@@ -56,6 +92,23 @@ struct FileInputNode : public Node {
    */
   void apply_effects(std::span<uint8_t> frame_buffer);
 
+  /**
+   * @brief Whether apply_effects() would change the audio (gain != 1 or a
+   * pitch shift).
+   */
+  [[nodiscard]] bool has_effects() const;
+
+  /**
+   * @brief Switches the node to its precomputed A-law file (found by
+   * ensure_file_exists()), bypassing decode and effects. Call before
+   * initialize_buffers().
+   * @return false if there is no fresh A-law file, the node has effects, or
+   * the file cannot be mapped; the node then plays PCM as usual.
+   */
+  bool attach_encoded();
+
+  [[nodiscard]] bool is_encoded() const { return encoded_; }
+
 
   std::expected<void, config::NodeError> open();
   std::expected<void, config::NodeError> close() override;
@@ -69,9 +122,86 @@ struct FileInputNode : public Node {
   boost::asio::awaitable<void> initialize_buffers() override;
   std::expected<void, config::NodeError> process_frame(std::span<uint8_t> buffer) override;
 
+  /**
+   * @brief Per-frame hot path behind process_frame(): same behaviour, but
+   * reports a bare code so no message is formatted or logged per frame.
+   */
+  config::NodeErrorCode next_frame(std::span<uint8_t> buffer);
+
  private:
+  /**
+   * @brief Attaches the decoded asset from the shared cache, loading and
+   * publishing it on a miss.
+   * @return false if the file is not cacheable (too large / unreadable); the
+   * caller then falls back to streaming.
+   */
+  boost::asio::awaitable<bool> attach_cached_asset();
+
+  /**
+   * @brief Waits for the prebuffer of a download in progress.
+   * @return true if the node should play it progressively; false if the
+   * download has already finished (or has no known size) and the file is
+   * to be used as complete.
+   */
+  boost::asio::awaitable<std::expected<bool, config::ErrorInfo>>
+  await_prebuffer(std::shared_ptr<infra::DownloadProgress> progress);
+
+  /**
+   * @brief Path to stream from: the partial file while downloading.
+   */
+  std::string streaming_path() const;
+
+  boost::asio::awaitable<std::shared_ptr<const infra::CachedAsset>> load_asset(
+      std::uintmax_t file_size, std::filesystem::file_time_type mtime);
+
+  /**
+   * @brief Maps the file and points resident_pcm_ at its PCM payload.
+   * @return false if mapping is unavailable; the caller falls back to
+   * streaming.
+   */
+  bool attach_mapped_file();
+
+  /**
+   * @brief Sets up the conversion stage for the source format (none when it
+   * already matches the geometry, or for headerless PCM).
+   * @return false for encodings other than 16-bit integer PCM.
+   */
+  bool configure_source(const std::optional<wav::WavFormat>& format);
+
+  /**
+   * @brief Whole output frames in `payload_bytes` of source PCM.
+   */
+  int frames_in(uint64_t payload_bytes) const;
+
+  /**
+   * @brief Reads the next dest.size() source bytes (zero-padded at the end
+   * of a resident asset).
+   */
+  config::NodeErrorCode read_source(std::span<uint8_t> dest);
+
+  /**
+   * @brief Fills one output frame through resampler_, pulling source chunks
+   * as needed. Past the end of the source the filter is flushed with silence.
+   */
+  config::NodeErrorCode convert_frame(std::span<uint8_t> buffer);
+
   boost::asio::io_context& io_;
-  std::shared_ptr<AsyncBufferController> buffer_controller_;
+  std::shared_ptr<const infra::CachedAsset> cached_asset_;
+  std::unique_ptr<infra::MappedFile> mapped_file_;
+  std::span<const uint8_t> resident_pcm_;  // View into cached_asset_/mapped_file_
+  std::shared_ptr<AsyncBufferController> buffer_controller_;  // Streaming only
+
+  size_t source_offset_ = 0;  ///< Read position in resident_pcm_
+  uint16_t source_block_align_ = config::BYTES_PER_SAMPLE;
+  std::unique_ptr<Resampler> resampler_;  ///< Only for mismatched formats
+  std::vector<uint8_t> source_chunk_;     ///< One source read for resampler_
+
+  std::optional<std::string> encoded_path_;  ///< Fresh 8 kHz A-law, if any
+  bool encoded_ = false;  ///< resident_pcm_ holds A-law, not PCM
+
+  std::shared_ptr<infra::DownloadProgress> progress_;  ///< Still downloading
+  uint64_t stream_offset_ = 0;   ///< Next file byte fetch_bytes() reads
+  uint64_t payload_offset_ = 0;  ///< First PCM byte (after the header)
 };
 
 }  // namespace hermes::audio
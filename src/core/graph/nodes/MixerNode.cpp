@@ -56,7 +56,7 @@ std::expected<void, NodeError> MixerNode::connect_input(Node* source) {
   // node can be that since delay cant be mixed but can still be connected do
   // delay for garph traversal
   if (source->kind() == NodeKind::FileInput) {
-    inputs_.push_back(source);
+    inputs_.push_back(static_cast<FileInputNode*>(source));
   }
 
   wire_standard(source);
@@ -85,37 +85,100 @@ std::expected<void, NodeError> MixerNode::close() {
 
 std::expected<void, NodeError> MixerNode::process_frame(
     std::span<uint8_t> frame_buffer) {
-  accumulator_.fill(0);
+  auto code = mix(inputs_, frame_buffer);
+  if (code != NodeErrorCode::Success) {
+    return error(code, "Mixer stream ended (no active inputs)");
+  }
+  return {};
+}
+
+NodeErrorCode MixerNode::mix(
+    std::span<FileInputNode* const> inputs, std::span<uint8_t> frame_buffer) {
+  return (this->*mix_fn_)(inputs, frame_buffer);
+}
+
+void MixerNode::set_geometry(const FrameGeometry& geometry) {
+  Node::set_geometry(geometry);
+
+  // Every supported geometry (8/16/48 kHz x 10/20/40 ms)
+  switch (geometry.samples_per_frame()) {
+    case 80:
+      mix_fn_ = &MixerNode::mix_impl<80>;
+      break;
+    case 160:
+      mix_fn_ = &MixerNode::mix_impl<160>;
+      break;
+    case 320:
+      mix_fn_ = &MixerNode::mix_impl<320>;
+      break;
+    case 480:
+      mix_fn_ = &MixerNode::mix_impl<480>;
+      break;
+    case 640:
+      mix_fn_ = &MixerNode::mix_impl<640>;
+      break;
+    case 960:
+      mix_fn_ = &MixerNode::mix_impl<960>;
+      break;
+    case 1920:
+      mix_fn_ = &MixerNode::mix_impl<1920>;
+      break;
+    default:
+      mix_fn_ = &MixerNode::mix_impl<std::dynamic_extent>;
+      break;
+  }
+}
+
+template <size_t Samples>
+NodeErrorCode MixerNode::mix_impl(
+    std::span<FileInputNode* const> inputs, std::span<uint8_t> frame_buffer) {
+  static_assert(Samples == std::dynamic_extent ||
+                Samples <= MAX_SAMPLES_PER_FRAME);
+
+  const size_t samples = (Samples == std::dynamic_extent)
+                             ? geometry_.samples_per_frame()
+                             : Samples;
+  auto accumulator =
+      std::span<int32_t, Samples>(accumulator_.data(), samples);
+  auto input_bytes = std::span<uint8_t, Samples == std::dynamic_extent
+                                            ? std::dynamic_extent
+                                            : Samples * BYTES_PER_SAMPLE>(
+      temp_input_buffer_.data(), samples * BYTES_PER_SAMPLE);
+
+  std::ranges::fill(accumulator, 0);
   bool has_active_inputs = false;
 
-  for (auto* source : inputs_) {
-    auto result = source->process_frame(temp_input_buffer_);
-    if (!result) {
+  for (auto* source : inputs) {
+    if (source->is_complete()) {
+      continue;  // Would only report EndOfStream again
+    }
+
+    auto code = source->next_frame(input_bytes);
+    if (code != NodeErrorCode::Success) {
       // Handle non-critical errors (Underrun, EOS) by skipping
-      if (result.error().code == NodeErrorCode::Critical)
-        return std::unexpected(result.error());
+      if (code == NodeErrorCode::Critical) return code;
       continue;
     }
 
     has_active_inputs = true;
 
     auto input_samples = pcm::as_samples(
-        std::span<const uint8_t>(temp_input_buffer_));
+        std::span<const uint8_t>(input_bytes));
 
-    AudioMath::sum_buffers(accumulator_, input_samples);
+    AudioMath::sum_buffers(accumulator, input_samples);
   }
 
   if (!has_active_inputs) {
     std::fill(frame_buffer.begin(), frame_buffer.end(), 0);
-    return error(NodeErrorCode::EndOfStream,
-                 "Mixer stream ended (no active inputs)");
+    return NodeErrorCode::EndOfStream;
   }
 
-  AudioMath::compress_and_export(accumulator_, frame_buffer);
+  AudioMath::compress_and_export(accumulator,
+                                 frame_buffer.first(samples * BYTES_PER_SAMPLE));
 
   in_buffer_processed_frames_++;
   processed_frames_++;
 
-  return {};
+  return NodeErrorCode::Success;
 }
 }  // namespace hermes::audio
@@ -9,17 +9,32 @@ namespace hermes::audio {
  */
 struct MixerNode : Node {
 
-  std::vector<Node*> inputs_;
-  std::array<int32_t, config::SAMPLES_PER_FRAME>
+  std::vector<FileInputNode*> inputs_;
+  std::array<int32_t, config::MAX_SAMPLES_PER_FRAME>
       accumulator_{}; /**< Intermediate mix buffer */
-  std::array<uint8_t, config::FRAME_SIZE_BYTES>
+  std::array<uint8_t, config::MAX_FRAME_SIZE_BYTES>
       temp_input_buffer_{}; /**< Temp buffer for input frames */
 
   explicit MixerNode(Node* t = nullptr);
 
   virtual void set_in_loop(bool val) override;
+
+  /**
+   * @brief Picks the mix loop instantiated for this frame size; geometries
+   * without one use the dynamic-extent loop.
+   */
+  void set_geometry(const config::FrameGeometry& geometry) override;
   std::expected<void, config::NodeError> process_frame(
       std::span<uint8_t> frame_buffer) override;
+
+  /**
+   * @brief Mixes one frame from `inputs` (non-virtual; used by the compiled
+   * execution plan with its own flattened input list).
+   * Finished inputs are skipped without being polled.
+   * @return Success, or EndOfStream once no input produced audio.
+   */
+  config::NodeErrorCode mix(
+      std::span<FileInputNode* const> inputs, std::span<uint8_t> frame_buffer);
   std::expected<void, config::NodeError> close() override;
 
   virtual std::expected<void, config::NodeError> connect_input(
@@ -27,5 +42,19 @@ struct MixerNode : Node {
 
   void set_max_frames();
   void add_input(FileInputNode* node);
+
+ private:
+  using MixFn = config::NodeErrorCode (MixerNode::*)(
+      std::span<FileInputNode* const>, std::span<uint8_t>);
+
+  /**
+   * @brief Mix loop over `Samples` samples per frame (std::dynamic_extent:
+   * geometry_.samples_per_frame(), decided per call).
+   */
+  template <size_t Samples>
+  config::NodeErrorCode mix_impl(std::span<FileInputNode* const> inputs,
+                                 std::span<uint8_t> frame_buffer);
+
+  MixFn mix_fn_ = &MixerNode::mix_impl<config::SAMPLES_PER_FRAME>;
 };
 }  // namespace hermes::audio
@@ -68,7 +68,8 @@ std::expected<std::string, ErrorInfo> ActiveSessions::create_session(
   } port_guard{this, allocated_port};
 
   auto session_result = Session::create(
-      io, session_id, std::move(*graph_result), cfg_.s3,cfg_.crypto,
+      io, pool_.get_frame_clock(io), pool_.get_udp_egress(io), session_id,
+      std::move(*graph_result), cfg_.s3, cfg_.crypto,
       (session_type == SessionType::WebRTC), cfg_.janus.address, allocated_port,
       (session_type == SessionType::StandartEncrypted));
 
@@ -132,13 +133,15 @@ std::shared_ptr<Session> ActiveSessions::get(const std::string& id) const {
 void ActiveSessions::spawn_session_coroutine(
     const std::string& id, std::shared_ptr<Session> session,
     std::shared_ptr<net::websocket::WebSocketSession> ws) {
-  // We spawn the coroutine on the session's specific io_context from the pool
+  // The coroutine must run on the io_context the session (and its FrameClock)
+  // is pinned to.
+  auto& session_io = session->get_io_context();
   asio::co_spawn(
-      pool_.get_io_context(),
+      session_io,
       [this, self = shared_from_this(), id, sess = std::move(session),
        websocket = std::move(ws)]() -> asio::awaitable<void> {
         try {
-          // The main audio loop runs here (20ms ticks)
+          // Suspends here while the FrameClock drives the 20ms ticks
           co_await sess->start();
         } catch (const std::exception& e) {
           spdlog::error("[{}] Unhandled session exception: {}", id, e.what());
@@ -232,8 +235,9 @@ std::vector<SessionRtpStats> ActiveSessions::get_all_session_rtp_stats() const {
   std::vector<SessionRtpStats> stats;
   stats.reserve(sessions_.size());
   for (const auto& [id, session] : sessions_) {
-    stats.push_back(
-        {id, session->get_rtp_bytes_sent(), session->get_rtp_packets_sent()});
+    stats.push_back({id, session->get_rtp_bytes_sent(),
+                     session->get_rtp_packets_sent(),
+                     session->get_rtcp_stats()});
   }
   return stats;
 }
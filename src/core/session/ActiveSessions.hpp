@@ -26,6 +26,7 @@ struct SessionRtpStats {
   std::string id;
   uint64_t bytes_sent;
   uint64_t packets_sent;
+  std::vector<net::rtp::RtcpClientStats> clients;
 };
 
 /**
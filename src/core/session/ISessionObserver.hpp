@@ -1,5 +1,8 @@
 #pragma once
 #include <string>
+#include <vector>
+
+#include "Rtcp.hpp"
 namespace hermes::service {
 struct SessionStats {
   std::string session_id;
@@ -7,6 +10,8 @@ struct SessionStats {
   size_t total_bytes_sent;
   size_t packets_sent = 0;
   size_t underruns = 0;
+  /// Link quality per RTP destination, from its RTCP receiver reports.
+  std::vector<net::rtp::RtcpClientStats> clients;
 };
 
 /**
@@ -24,7 +24,8 @@ using namespace hermes::net::rtp;
 namespace hermes::service {
 
 std::expected<std::shared_ptr<Session>, config::ErrorInfo> Session::create(
-    asio::io_context& io, std::string id, Graph&& g,
+    asio::io_context& io, infra::FrameClock& clock, infra::UdpEgress& egress,
+    std::string id, Graph&& g,
     const config::S3Config& s3_config,
     const config::CryptoConfig& crypto_config, bool is_web_rtc,
     std::string janus_ip, std::optional<uint16_t> janus_port,
@@ -36,23 +37,26 @@ std::expected<std::shared_ptr<Session>, config::ErrorInfo> Session::create(
     return std::unexpected(executor_result.error());
   }
 
-  auto RTPStremer = RTPStreamer::create(io, crypto_config);
+  auto RTPStremer =
+      RTPStreamer::create(egress, crypto_config, heap_graph->geometry);
 
   return std::make_shared<Session>(
-      io, std::move(id), std::move(heap_graph), std::move(*executor_result),
+      io, clock, std::move(id), std::move(heap_graph),
+      std::move(*executor_result),
       std::move(RTPStremer), is_web_rtc, std::move(janus_ip), janus_port,
       is_encrypted);
 }
 
-Session::Session(asio::io_context& io, std::string id, std::unique_ptr<Graph> g,
+Session::Session(asio::io_context& io, infra::FrameClock& clock,
+                 std::string id, std::unique_ptr<Graph> g,
                  std::unique_ptr<AudioExecutor> audio_executor,
                  std::unique_ptr<net::rtp::RTPStreamer> streamer,
                  bool is_web_rtc, std::string janus_ip,
                  std::optional<uint16_t> janus_port, bool is_encrypted)
     : io_(io),
       id_(std::move(id)),
-      resume_channel_(io_, 1),
-      timer_(io),
+      clock_(clock),
+      done_channel_(io_, 1),
       graph_(std::move(g)),
       audio_executor_(std::move(audio_executor)),
       streamer_(std::move(streamer)),  // Inject dependency
@@ -76,9 +80,13 @@ void Session::add_client(const std::string& ip, uint16_t port) {
 
 void Session::stop() {
   spdlog::info("[{}] Stopping session...", id_);
+  stop_requested_ = true;
   is_running_ = false;
 
-  timer_.cancel();
+  // The FrameClock is not thread-safe; tear down on the session's own thread.
+  asio::post(io_, [self = shared_from_this()]() {
+    self->finish(NodeError{NodeErrorCode::Success, "Session stopped", ""});
+  });
 }
 
 void Session::pause() {
@@ -90,15 +98,17 @@ void Session::pause() {
 void Session::resume() {
   if (is_paused_) {
     is_paused_ = false;
-
-    // Drop a dummy signal into the channel.
-    // try_send is synchronous, so it can be called from standard functions.
-    resume_channel_.try_send(boost::system::error_code{});
+    spdlog::info("[{}] Resumed.", id_);
   }
 }
 
 // TODO save the clients node in a data memeber in graph when parsing the graph
 void Session::configure_streamer_from_graph() {
+  if (graph_->clients_node != nullptr) {
+    // Encoder state is built here, once, never on the frame path.
+    streamer_->set_codec(graph_->clients_node->codec);
+  }
+
   if (is_webrtc_) {
     if (janus_port_.has_value()) {
       spdlog::info("[{}] Registering Janus WebRTC target: {}:{}", id_,
@@ -112,17 +122,29 @@ void Session::configure_streamer_from_graph() {
     }
   } else if (graph_->clients_node != nullptr) {
     for (const auto& client_config : graph_->clients_node->clients) {
-      spdlog::info("[{}] Auto-registering client: {}:{}", id_, client_config.ip,
-                   client_config.port);
-      streamer_->add_client(client_config.ip, client_config.port,
-                            client_config.packet_loss_ratio);
+      spdlog::info("[{}] Auto-registering {} client: {}:{}", id_,
+                   client_config.multicast ? "multicast" : "unicast",
+                   client_config.ip, client_config.port);
+      if (client_config.multicast) {
+        streamer_->add_multicast_client(client_config.ip, client_config.port,
+                                        *client_config.multicast,
+                                        client_config.packet_loss_ratio);
+      } else {
+        streamer_->add_client(client_config.ip, client_config.port,
+                              client_config.packet_loss_ratio);
+      }
     }
   }
 }
 
 asio::awaitable<void> Session::start() {
   spdlog::info("[{}] Starting session execution...", id_);
+  // stop() may already have run (e.g. the client hung up while the session
+  // was queued); re-checking after the store closes the window in between.
   is_running_ = true;
+  if (stop_requested_) {
+    is_running_ = false;
+  }
   NodeError exit_reason{NodeErrorCode::Success, "", ""};
 
   try {
@@ -150,80 +172,98 @@ asio::awaitable<void> Session::start() {
 
 asio::awaitable<std::expected<void, config::NodeError>>
 Session::run_main_audio_loop() {
-  auto next_tick = std::chrono::steady_clock::now();
-  auto last_stats_time = next_tick;
-  std::array<uint8_t, config::FRAME_SIZE_BYTES> pcm_buffer;
-
-  while (is_running_) {
-    if (is_paused_) {
-      co_await wait_for_resume(next_tick, last_stats_time);
-      continue;
-    }
+  if (!is_running_) {
+    // stop() raced the start-up; never join the clock.
+    co_return std::expected<void, config::NodeError>{std::in_place};
+  }
 
-    auto tick_result = co_await wait_for_next_tick(next_tick);
-    if (!tick_result) {
-      co_return std::unexpected(tick_result.error());
-    }
+  last_stats_time_ = std::chrono::steady_clock::now();
+  clock_.subscribe(shared_from_this());
+  subscribed_ = true;
 
-    auto frame_result =
-        process_and_stream_single_frame(pcm_buffer, last_stats_time);
-    if (!frame_result) {
-      co_return std::unexpected(frame_result.error());
-    }
+  // Frames are produced by on_tick(); finish() wakes us up.
+  boost::system::error_code ec;
+  co_await done_channel_.async_receive(
+      asio::redirect_error(asio::use_awaitable, ec));
+
+  // A finish() that ran before we subscribed left the slot full: the receive
+  // returned at once and the clock would keep ticking a dead session.
+  if (subscribed_) {
+    clock_.unsubscribe(this);
+    subscribed_ = false;
+  }
+
+  if (exit_reason_.code != NodeErrorCode::Success) {
+    co_return std::unexpected(exit_reason_);
   }
 
   co_return std::expected<void, config::NodeError>{
       std::in_place};  // Natural exit if is_running_ is set to false externally
 }
 
-asio::awaitable<void> Session::wait_for_resume(
-    std::chrono::steady_clock::time_point& next_tick,
-    std::chrono::steady_clock::time_point& last_stats_time) {
-  spdlog::info("[{}] Paused. Going to sleep...", id_);
+void Session::on_tick(std::chrono::steady_clock::time_point /*scheduled_tick*/) {
+  if (!is_running_ || is_paused_) {
+    // Paused sessions simply skip ticks; there is nothing to "catch up" on
+    // resume because the clock keeps running for the other sessions.
+    last_stats_time_ = std::chrono::steady_clock::now();
+    return;
+  }
 
-  boost::system::error_code ec;
-  co_await resume_channel_.async_receive(
-      asio::redirect_error(asio::use_awaitable, ec));
+  // The shared clock ticks every 20 ms whatever the session's frame length:
+  // 10 ms frames go out in pairs, 40 ms frames on every other tick.
+  // Passthrough frames are PCMA, one byte per sample.
+  const auto& geometry = audio_executor_->geometry();
+  auto pcm_frame = std::span(pcm_buffer_).first(
+      audio_executor_->is_passthrough() ? geometry.samples_per_frame()
+                                        : geometry.frame_bytes());
+  pending_ms_ += static_cast<uint32_t>(AUDIO_TICK_INTERVAL.count());
 
-  spdlog::info("[{}] Woke up!", id_);
+  while (pending_ms_ >= geometry.frame_ms) {
+    pending_ms_ -= geometry.frame_ms;
 
-  // Reset clocks so we don't try to "catch up" on missed ticks while paused
-  next_tick = std::chrono::steady_clock::now();
-  last_stats_time = next_tick;
+    auto frame_result =
+        process_and_stream_single_frame(pcm_frame, last_stats_time_);
+    if (!frame_result) {
+      // Only now is the status turned into a message.
+      finish(audio_executor_->describe(frame_result.error()));
+      return;
+    }
+  }
 }
 
-asio::awaitable<std::expected<void, config::NodeError>>
-Session::wait_for_next_tick(std::chrono::steady_clock::time_point& next_tick) {
-  next_tick += config::AUDIO_TICK_INTERVAL;
-  timer_.expires_at(next_tick);
-
-  boost::system::error_code timer_ec;
-  co_await timer_.async_wait(
-      asio::redirect_error(asio::use_awaitable, timer_ec));
-
-  if (timer_ec == boost::asio::error::operation_aborted) {
-    spdlog::debug("[{}] Timer cancelled, stopping loop.", id_);
-    // Using Success here assuming a cancelled timer means a graceful external
-    // stop command
-    co_return std::unexpected(config::NodeError{config::NodeErrorCode::Success,
-                                                "Timer aborted manually", ""});
+void Session::finish(config::NodeError reason) {
+  if (subscribed_) {
+    clock_.unsubscribe(this);
+    subscribed_ = false;
   }
 
-  co_return std::expected<void, config::NodeError>{std::in_place};
+  if (exit_reason_.code == NodeErrorCode::Success &&
+      exit_reason_.message.empty()) {
+    exit_reason_ = std::move(reason);
+  }
+
+  // try_send is synchronous; a second finish() finds the slot full and no-ops.
+  done_channel_.try_send(boost::system::error_code{});
 }
 
-std::expected<void, config::NodeError> Session::process_and_stream_single_frame(
+std::expected<void, config::FrameStatus>
+Session::process_and_stream_single_frame(
     std::span<uint8_t> pcm_buffer,
     std::chrono::steady_clock::time_point& last_stats_time) {
   auto [executor_wants_continue, status] =
       audio_executor_->get_next_frame(pcm_buffer);
 
   // Process Telemetry and Diagnostics
-  if (status.code != config::NodeErrorCode::Success) {
+  if (!status.ok()) {
     if (status.code == config::NodeErrorCode::Underrun) {
-      spdlog::warn("[{}] Audio underrun detected: {}", id_, status.message);
+      auto underruns = ++audio_executor_->get_stats().underruns;
+      if (underruns % UNDERRUN_LOG_EVERY == 1) {
+        spdlog::warn("[{}] Audio underrun in [{}] ({} so far)", id_,
+                     audio_executor_->stage_id(status), underruns);
+      }
     } else if (status.code != config::NodeErrorCode::EndOfStream) {
-      spdlog::error("[{}] Audio processing error: {}", id_, status.message);
+      spdlog::error("[{}] Audio processing error: {}", id_,
+                    audio_executor_->describe(status).message);
     }
   }
 
@@ -234,7 +274,11 @@ std::expected<void, config::NodeError> Session::process_and_stream_single_frame(
   }
 
   // Dispatch the Audio
-  streamer_->send_frame(pcm_buffer);
+  if (audio_executor_->is_passthrough()) {
+    streamer_->send_encoded(pcm_buffer);
+  } else {
+    streamer_->send_frame(pcm_buffer);
+  }
   audio_executor_->get_stats().packets_sent++;
 
   update_stats_if_needed(last_stats_time);
@@ -303,7 +347,12 @@ void Session::update_stats_if_needed(
   auto now = std::chrono::steady_clock::now();
   constexpr auto STATS_UPDATE_INTERVAL_MS = std::chrono::milliseconds(100);
   if (now - last_stats_time > STATS_UPDATE_INTERVAL_MS) {
-    observer_->on_stats_update(audio_executor_->get_stats());
+    auto& stats = audio_executor_->get_stats();
+    // Refilled in place: steady-state ticks do not allocate for this.
+    if (streamer_) {
+      streamer_->get_rtcp_stats(stats.clients);
+    }
+    observer_->on_stats_update(stats);
     last_stats_time = now;
   }
 }
@@ -318,5 +367,10 @@ uint64_t Session::get_rtp_packets_sent() const {
   return streamer_ ? streamer_->get_packets_sent() : 0;
 }
 
+std::vector<net::rtp::RtcpClientStats> Session::get_rtcp_stats() const {
+  return streamer_ ? streamer_->get_rtcp_stats()
+                   : std::vector<net::rtp::RtcpClientStats>{};
+}
+
 Session::~Session() = default;
 }  // namespace hermes::service
@@ -3,14 +3,18 @@
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/experimental/channel.hpp>
 #include <boost/asio/io_context.hpp>
+#include <array>
+#include <chrono>
 #include <memory>
 #include <string>
 
 #include "AudioExecutor.hpp"
 #include "Config.hpp"
+#include "FrameClock.hpp"
 #include "ISessionObserver.hpp"
 #include "RTPStreamer.hpp"
 #include "Types.hpp"
+#include "UdpEgress.hpp"
 
 namespace hermes::service {
 /**
@@ -20,17 +24,20 @@ namespace hermes::service {
  *
  * The Session class is responsible for:
  * 1. Initializing the AudioExecutor and fetching necessary resources (S3).
- * 2. Running the main 20ms real-time audio loop.
+ * 2. Running the main 20ms real-time audio loop, driven by the FrameClock
+ * shared by every session pinned to the same io_context.
  * 3. Streaming the resulting audio via RTP.
  * 4. Reporting statistics and errors to an attached observer (e.g., WebSocket).
  */
 
 using signal_channel =
     boost::asio::experimental::channel<void(boost::system::error_code)>;
-class Session : public std::enable_shared_from_this<Session> {
+class Session : public std::enable_shared_from_this<Session>,
+                public infra::ITickSubscriber {
  public:
   static std::expected<std::shared_ptr<Session>, config::ErrorInfo> create(
-      boost::asio::io_context& io, std::string id, audio::Graph&& g,
+      boost::asio::io_context& io, infra::FrameClock& clock,
+      infra::UdpEgress& egress, std::string id, audio::Graph&& g,
       const config::S3Config& s3_config,
       const config::CryptoConfig& crypto_config, bool is_web_rtc,
       std::string janus_ip, std::optional<uint16_t> janus_port,
@@ -40,11 +47,12 @@ class Session : public std::enable_shared_from_this<Session> {
    * @brief Constructs a new Session.
    *
    * @param io The IO context for async operations.
+   * @param clock The frame clock of `io` that drives the audio loop.
    * @param id A unique identifier for this session.
    * @param g The audio graph to execute (moved into the session).
    */
-  Session(boost::asio::io_context& io, std::string id,
-          std::unique_ptr<audio::Graph> g,
+  Session(boost::asio::io_context& io, infra::FrameClock& clock,
+          std::string id, std::unique_ptr<audio::Graph> g,
           std::unique_ptr<audio::AudioExecutor> audio_executor,std::unique_ptr<net::rtp::RTPStreamer> streamer, bool is_web_rtc,
           std::string janus_ip, std::optional<uint16_t> janus_port,
           bool is_encrypted);
@@ -61,16 +69,21 @@ class Session : public std::enable_shared_from_this<Session> {
 
    * Calls InitializeGraphExecution() to fetch files and prepare buffers.
    * Configures the streamer.
-   * Enters the main loop, ticking every 20ms to process frames.
+   * Subscribes to the FrameClock, which processes a frame every 20ms.
    */
   boost::asio::awaitable<void> start();
 
   /**
    * @brief Stops the session execution immediately.
-   *
+   * Thread-safe: the teardown is posted to the session's io_context.
    */
   void stop();
 
+  /**
+   * @brief FrameClock callback. Processes and streams a single frame.
+   */
+  void on_tick(std::chrono::steady_clock::time_point scheduled_tick) override;
+
   void pause();
 
   void resume();
@@ -78,7 +91,9 @@ class Session : public std::enable_shared_from_this<Session> {
   std::optional<uint16_t> get_webrtc_port() const { return janus_port_; }
   uint64_t get_rtp_bytes_sent() const;
   uint64_t get_rtp_packets_sent() const;
+  std::vector<net::rtp::RtcpClientStats> get_rtcp_stats() const;
   std::string get_id() const { return id_; }
+  boost::asio::io_context& get_io_context() const { return io_; }
   /**
    * @brief Adds a target client for RTP streaming.
    *
@@ -105,6 +120,7 @@ class Session : public std::enable_shared_from_this<Session> {
   boost::asio::io_context& io_;
   std::string id_;
   std::atomic<bool> is_running_{false};
+  std::atomic<bool> stop_requested_{false};  ///< Sticky: set once by stop()
   std::atomic<bool> is_paused_{false};
   bool is_webrtc_{false};
   std::string janus_ip_;
@@ -112,10 +128,16 @@ class Session : public std::enable_shared_from_this<Session> {
   std::unique_ptr<audio::Graph> graph_;
   std::unique_ptr<audio::AudioExecutor> audio_executor_;
   std::unique_ptr<net::rtp::RTPStreamer> streamer_;
-  signal_channel resume_channel_;
-  boost::asio::steady_timer timer_;
+  infra::FrameClock& clock_;
+  signal_channel done_channel_;
   std::unique_ptr<ISessionObserver> observer_;
 
+  std::array<uint8_t, config::MAX_FRAME_SIZE_BYTES> pcm_buffer_{};
+  uint32_t pending_ms_ = 0;  ///< Clock time not yet covered by sent frames
+  std::chrono::steady_clock::time_point last_stats_time_;
+  config::NodeError exit_reason_{config::NodeErrorCode::Success, "", ""};
+  bool subscribed_ = false;
+
   /**
    * @brief Scans the graph for 'ClientsNode' and registers them with the
    * RTPStreamer.
@@ -149,29 +171,23 @@ class Session : public std::enable_shared_from_this<Session> {
 
   /**
    * @brief The core audio loop (AUDIO_TICK_INTERVAL ticks).
+   * Subscribes to the FrameClock and suspends until the session finishes.
    */
   boost::asio::awaitable<std::expected<void, config::NodeError>>
   run_main_audio_loop();
 
   /**
-   * @brief Suspends the coroutine until the resume channel receives a signal.
+   * @brief Unsubscribes from the FrameClock and wakes run_main_audio_loop().
+   * Must be called on the session's io_context thread.
    */
-  boost::asio::awaitable<void> wait_for_resume(
-      std::chrono::steady_clock::time_point& next_tick,
-      std::chrono::steady_clock::time_point& last_stats_time);
-
-  /**
-   * @brief Waits for the next 20ms tick.
-   * @return false if the timer was aborted (session stopping), true otherwise.
-   */
-  boost::asio::awaitable<std::expected<void, config::NodeError>>
-  wait_for_next_tick(std::chrono::steady_clock::time_point& next_tick);
+  void finish(config::NodeError reason);
 
   /**
    * @brief Fetches a frame from the executor and dispatches it.
-   * @return false if the executor signaled the end of the stream.
+   * Allocation-free in steady state; underrun warnings are rate-limited.
+   * @return the final status if the executor signaled the end of the stream.
    */
-  std::expected<void, config::NodeError> process_and_stream_single_frame(
+  std::expected<void, config::FrameStatus> process_and_stream_single_frame(
       std::span<uint8_t> pcm_buffer,
       std::chrono::steady_clock::time_point& last_stats_time);
 };
@@ -1,42 +1,51 @@
 #include <Alaw.hpp>
 #include <array>
+#include <bit>
 #include <boost/core/span.hpp>
 #include <cstdint>
 #include <cstring>
 #include <limits>
 
-namespace hermes::audio {
-static constexpr int16_t MIN_16BIT_VALUE = std::numeric_limits<int16_t>::min();
-static constexpr int16_t MAX_16BIT_VALUE = std::numeric_limits<int16_t>::max();
-static constexpr uint32_t VALUE_COUNT_16BIT =
-    MAX_16BIT_VALUE - MIN_16BIT_VALUE + 1;
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HERMES_ALAW_X86 1
+#include <immintrin.h>
+#else
+#define HERMES_ALAW_X86 0
+#endif
 
+namespace hermes::audio {
 static constexpr uint8_t MIN_U8BIT_VALUE = std::numeric_limits<uint8_t>::min();
 static constexpr uint8_t MAX_U8BIT_VALUE = std::numeric_limits<uint8_t>::max();
 static constexpr uint16_t VALUE_COUNT_U8BIT =
     MAX_U8BIT_VALUE - MIN_U8BIT_VALUE + 1;
 
 static constexpr uint8_t BASE_ALAW_MASK = 0b0101'0101;
+static constexpr uint8_t SIGNED_ALAW_MASK = BASE_ALAW_MASK | 0b1000'0000;
 static constexpr uint8_t QUANT_MASK = 0b0000'1111;
 static constexpr uint8_t SIGN_BIT_MASK = 0b1000'0000;
+static constexpr uint8_t SEGMENT_MASK = 0b0111'0000;
 static constexpr uint8_t SEGMENT_SHIFT = 4;
+static constexpr uint8_t QUANT_SHIFT = 4;
 
-static uint16_t get_encode_table_idx(const int16_t pcm_sample) {
-  static constexpr uint16_t PCM_IDX_DIFF = -std::numeric_limits<int16_t>::min();
-  const uint16_t idx = pcm_sample + PCM_IDX_DIFF;
+static constexpr uint8_t SEGMENT_COUNT = 8;
+static constexpr std::array<int16_t, SEGMENT_COUNT> SEGMENT_EDGES = {
+    0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF, 0x1FFF, 0x3FFF, 0x7FFF};
 
-  return idx;
-}
+// Segment 0 and 1 share a step size; segment n > 0 drops 3 + n low bits.
+static constexpr uint8_t FIRST_SEGMENT_PCM_SHIFT = 4;
+static constexpr uint8_t BASE_PCM_SHIFT = 3;
+
+// Magnitudes up to 0x7FFF span 128 blocks of 256 (segment 0's width).
+static constexpr int SEGMENT_BLOCK_SHIFT = 8;
+static constexpr std::size_t SEGMENT_BLOCK_COUNT = 128;
 
 // The alaw algorithm requires signed bitwise operations.
 // NOLINTBEGIN(hicpp-signed-bitwise)
 
 /**
- * @brief Generates a lookup table for linear PCM (16-bit) to A-Law (8-bit) conversion.
+ * @brief Encodes one linear PCM (16-bit) sample to A-Law (8-bit).
  *
  * A-Law allocates more dynamic range to smaller signals using a logarithmic curve.
- * This function iterates through all possible 16-bit PCM values (-32768 to 32767),
- * calculates the corresponding A-Law byte, and stores it in a lookup table.
  *
  * The algorithm involves:
  * 1. Extracting the sign bit.
@@ -45,152 +54,454 @@ static uint16_t get_encode_table_idx(const int16_t pcm_sample) {
  * 4. Assembling the byte (Sign | Segment | Quantization).
  * 5. XORing with 0x55 (standard A-Law pattern) to toggle even bits.
  */
-static std::array<uint8_t, VALUE_COUNT_16BIT> make_encode_table() {
-  // We're initializing the array with garbage values and populating it later
-  // on. NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init,
-  // hicpp-member-init)
-  std::array<uint8_t, VALUE_COUNT_16BIT> encode_table;
-
-  // Using wide_pcm_sample because we need it to reach MAX_16BIT_VALUE + 1 for
-  // the loop's exit condition.
-  for (int32_t wide_pcm_sample = MIN_16BIT_VALUE;
-       wide_pcm_sample <= MAX_16BIT_VALUE; wide_pcm_sample++) {
-    const auto pcm_sample = static_cast<int16_t>(wide_pcm_sample);
-
-    uint8_t alaw_mask;
-    int16_t normalized_pcm_sample;
-    if (pcm_sample >= 0) {
-      static constexpr uint8_t SIGNED_ALAW_MASK =
-          BASE_ALAW_MASK | SIGN_BIT_MASK;
-      alaw_mask = SIGNED_ALAW_MASK;
-      normalized_pcm_sample = pcm_sample;
-    } else {
-      alaw_mask = BASE_ALAW_MASK;
-      normalized_pcm_sample = -pcm_sample - 8;
-    }
+uint8_t encode_alaw_reference(int16_t pcm_sample) {
+  uint8_t alaw_mask;
+  int16_t normalized_pcm_sample;
+  if (pcm_sample >= 0) {
+    alaw_mask = SIGNED_ALAW_MASK;
+    normalized_pcm_sample = pcm_sample;
+  } else {
+    alaw_mask = BASE_ALAW_MASK;
+    normalized_pcm_sample = static_cast<int16_t>(-pcm_sample - 8);
+  }
 
-    // Convert the scaled magnitude to segment number.
-    static constexpr uint8_t SEGMENT_COUNT = 8;
-    static const std::array<int16_t, SEGMENT_COUNT> SEGMENT_EDGES = {
-        0xFF, 0x1FF, 0x3FF, 0x7FF, 0xFFF, 0x1FFF, 0x3FFF, 0x7FFF};
-    uint8_t segment_idx;
-    for (segment_idx = 0; segment_idx < SEGMENT_COUNT; segment_idx++) {
-      if (normalized_pcm_sample <= SEGMENT_EDGES.at(segment_idx)) {
-        break;
-      }
+  // Convert the scaled magnitude to segment number.
+  uint8_t segment_idx;
+  for (segment_idx = 0; segment_idx < SEGMENT_COUNT; segment_idx++) {
+    if (normalized_pcm_sample <= SEGMENT_EDGES.at(segment_idx)) {
+      break;
     }
+  }
 
-    uint8_t unmasked_alaw_sample;
-    if (segment_idx == SEGMENT_COUNT) {
-      // Out of range, assign maximum value:
-      static constexpr uint8_t MAX_VALUE = 0b0111'1111;
-      unmasked_alaw_sample = MAX_VALUE;
+  uint8_t unmasked_alaw_sample;
+  if (segment_idx == SEGMENT_COUNT) {
+    // Out of range, assign maximum value:
+    static constexpr uint8_t MAX_VALUE = 0b0111'1111;
+    unmasked_alaw_sample = MAX_VALUE;
+  } else {
+    // Combine the sign, segment and quantization bits:
+    uint8_t pcm_shift;
+    if (segment_idx == 0) {
+      pcm_shift = FIRST_SEGMENT_PCM_SHIFT;
     } else {
-      // Combine the sign, segment and quantization bits:
-      uint8_t pcm_shift;
-      if (segment_idx == 0) {
-        static constexpr uint8_t FIRST_SEGMENT_PCM_SHIFT = 4;
-        pcm_shift = FIRST_SEGMENT_PCM_SHIFT;
-      } else {
-        static constexpr uint8_t BASE_PCM_SHIFT = 3;
-        pcm_shift = BASE_PCM_SHIFT + segment_idx;
-      }
-
-      const uint8_t shifted_pcm =
-          (normalized_pcm_sample >> pcm_shift) & QUANT_MASK;
-      const uint8_t shifted_segment = segment_idx << SEGMENT_SHIFT;
-
-      unmasked_alaw_sample = shifted_pcm | shifted_segment;
+      pcm_shift = BASE_PCM_SHIFT + segment_idx;
     }
 
-    const uint8_t alaw_sample = unmasked_alaw_sample ^ alaw_mask;
+    const uint8_t shifted_pcm =
+        (normalized_pcm_sample >> pcm_shift) & QUANT_MASK;
+    const uint8_t shifted_segment = segment_idx << SEGMENT_SHIFT;
 
-    const auto encode_table_idx = get_encode_table_idx(pcm_sample);
-    encode_table.at(encode_table_idx) = alaw_sample;
+    unmasked_alaw_sample = shifted_pcm | shifted_segment;
   }
 
-  return encode_table;
+  return unmasked_alaw_sample ^ alaw_mask;
 }
 
 /**
- * @brief Generates a lookup table for A-Law (8-bit) to linear PCM (16-bit) conversion.
+ * @brief Decodes one A-Law (8-bit) sample to linear PCM (16-bit).
  *
- * This computes the expanded 16-bit sample for every possible 8-bit A-Law value.
  * It essentially reverses the encoding process:
  * 1. XOR with 0x55 to retrieve the "unmasked" byte.
  * 2. Extract sign, segment, and quantization bits.
  * 3. Expand the quantized value back to the 16-bit range using the segment shift.
  */
-static std::array<uint16_t, VALUE_COUNT_U8BIT> make_decode_table() {
-  // We're initializing the array with garbage values and populating it later
-  // on.
-  // hicpp-member-init)
-  std::array<uint16_t, VALUE_COUNT_U8BIT> decode_table{};
+static constexpr int16_t decode_alaw_sample(uint8_t alaw_sample) {
+  const auto masked_alaw_sample = alaw_sample ^ BASE_ALAW_MASK;
 
-  // Using wide_alaw_sample because we need it to reach VALUE_COUNT_U8BIT + 1
-  // for the loop's exit condition.
-  for (uint16_t wide_alaw_sample = MIN_U8BIT_VALUE;
-       wide_alaw_sample <= MAX_U8BIT_VALUE; wide_alaw_sample++) {
-    const auto alaw_sample = static_cast<uint8_t>(wide_alaw_sample);
+  int16_t pcm_sample =
+      static_cast<int16_t>((masked_alaw_sample & QUANT_MASK) << QUANT_SHIFT);
 
-    const auto masked_alaw_sample = alaw_sample ^ BASE_ALAW_MASK;
+  const int16_t segment_idx =
+      static_cast<int16_t>((masked_alaw_sample & SEGMENT_MASK) >> SEGMENT_SHIFT);
 
-    static constexpr uint8_t QUANT_SHIFT = 4;
-    int16_t pcm_sample = (masked_alaw_sample & QUANT_MASK) << QUANT_SHIFT;
+  if (segment_idx == 0) {
+    pcm_sample += 0x008;
+  } else {
+    pcm_sample += 0x108;
+  }
 
-    static constexpr uint8_t SEGMENT_MASK = 0b0111'0000;
-    const int16_t segment_idx =
-        (masked_alaw_sample & SEGMENT_MASK) >> SEGMENT_SHIFT;
+  if (segment_idx > 1) {
+    pcm_sample = static_cast<int16_t>(pcm_sample << (segment_idx - 1));
+  }
 
-    if (segment_idx == 0) {
-      pcm_sample += 0x008;
-    } else {
-      pcm_sample += 0x108;
-    }
+  const bool alaw_sign_bit = (masked_alaw_sample & SIGN_BIT_MASK) != 0;
+  if (!alaw_sign_bit) {
+    pcm_sample = static_cast<int16_t>(-pcm_sample);
+  }
 
-    if (segment_idx > 1) {
-      pcm_sample <<= segment_idx - 1;
-    }
+  return pcm_sample;
+}
 
-    const bool alaw_sign_bit = masked_alaw_sample & SIGN_BIT_MASK;
-    if (!alaw_sign_bit) {
-      pcm_sample = -pcm_sample;
+int16_t decode_alaw_reference(uint8_t alaw_sample) {
+  return decode_alaw_sample(alaw_sample);
+}
+
+// ---------------------------------------------------------------------------
+// Compile-time tables (no function-local statics, no init guards)
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Segment number for every 256-wide block of the normalized magnitude.
+ * 128 bytes, i.e. two cache lines instead of the 64 KB full encode table.
+ */
+static constexpr std::array<uint8_t, SEGMENT_BLOCK_COUNT> make_segment_table() {
+  std::array<uint8_t, SEGMENT_BLOCK_COUNT> table{};
+  for (std::size_t block = 0; block < SEGMENT_BLOCK_COUNT; ++block) {
+    const auto magnitude = static_cast<int32_t>(block << SEGMENT_BLOCK_SHIFT);
+    uint8_t segment_idx = 0;
+    while (magnitude > SEGMENT_EDGES.at(segment_idx)) {
+      segment_idx++;
     }
+    table.at(block) = segment_idx;
+  }
+  return table;
+}
+
+static constexpr std::array<int16_t, VALUE_COUNT_U8BIT> make_decode_table() {
+  std::array<int16_t, VALUE_COUNT_U8BIT> table{};
+  for (std::size_t alaw_sample = 0; alaw_sample < VALUE_COUNT_U8BIT;
+       ++alaw_sample) {
+    table.at(alaw_sample) =
+        decode_alaw_sample(static_cast<uint8_t>(alaw_sample));
+  }
+  return table;
+}
+
+static constexpr auto SEGMENT_TABLE = make_segment_table();
+static constexpr auto DECODE_TABLE = make_decode_table();
+
+// ---------------------------------------------------------------------------
+// Scalar encoders
+// ---------------------------------------------------------------------------
+
+// Sign handling shared by the scalar encoders: the magnitude the segment is
+// taken from is `pcm` for positive samples and `-pcm - 8` for negative ones.
+// For -7..-1 that is negative and lands in segment 0 with quantization 0xF,
+// exactly as in the reference.
+static inline int32_t normalized_magnitude(int32_t pcm, int32_t sign) {
+  return (pcm ^ sign) - (sign & 7);
+}
+
+static inline uint8_t sign_mask(int32_t sign) {
+  return static_cast<uint8_t>(SIGNED_ALAW_MASK ^ (sign & SIGN_BIT_MASK));
+}
+
+static inline uint8_t assemble(int32_t magnitude, uint32_t segment_idx,
+                               uint8_t alaw_mask) {
+  // Segments 0 and 1 both shift by 4: shift = segment + 3 + (segment == 0).
+  const uint32_t pcm_shift =
+      segment_idx + BASE_PCM_SHIFT + static_cast<uint32_t>(segment_idx == 0);
+  const auto quant = static_cast<uint32_t>(magnitude >> pcm_shift) & QUANT_MASK;
+  return static_cast<uint8_t>(((segment_idx << SEGMENT_SHIFT) | quant) ^
+                              alaw_mask);
+}
+
+static inline uint8_t encode_sample_branchless(int16_t pcm_sample) {
+  const int32_t pcm = pcm_sample;
+  const int32_t sign = pcm >> 31;  // 0 or -1
+  const int32_t magnitude = normalized_magnitude(pcm, sign);
+  const auto clamped = static_cast<uint32_t>(magnitude & ~(magnitude >> 31));
+
+  // Segment = how many bits the magnitude has above segment 0's 8.
+  const auto segment_idx =
+      static_cast<uint32_t>(std::bit_width(clamped >> SEGMENT_BLOCK_SHIFT));
+  return assemble(magnitude, segment_idx, sign_mask(sign));
+}
+
+static inline uint8_t encode_sample_table(int16_t pcm_sample) {
+  const int32_t pcm = pcm_sample;
+  const int32_t sign = pcm >> 31;
+  const int32_t magnitude = normalized_magnitude(pcm, sign);
+  const auto clamped = static_cast<uint32_t>(magnitude & ~(magnitude >> 31));
+
+  const uint32_t segment_idx = SEGMENT_TABLE[clamped >> SEGMENT_BLOCK_SHIFT];
+  return assemble(magnitude, segment_idx, sign_mask(sign));
+}
+
+static void encode_branchless(const int16_t* pcm, uint8_t* out,
+                              std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = encode_sample_branchless(pcm[i]);
+  }
+}
+
+static void encode_table(const int16_t* pcm, uint8_t* out, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = encode_sample_table(pcm[i]);
+  }
+}
+
+static void decode_table(const uint8_t* alaw, int16_t* out, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = DECODE_TABLE[alaw[i]];
+  }
+}
+
+// ---------------------------------------------------------------------------
+// SSE4.1 / AVX2
+// ---------------------------------------------------------------------------
+
+#if HERMES_ALAW_X86
+
+// NOLINTBEGIN(readability-magic-numbers, cppcoreguidelines-pro-type-reinterpret-cast)
+
+/*
+ * Encoder, 16-bit lanes. SSE has no per-lane variable shift, so both the
+ * segment and the shift come from a compare ladder against the segment
+ * edges: segment = number of edges the magnitude exceeds, and the quantizer
+ * `magnitude >> shift` becomes mulhi(magnitude, 2^(16 - shift)), where the
+ * multiplier starts at 2^12 and halves for each edge past the first.
+ * For the -7..-1 magnitudes, unsigned mulhi by 2^12 yields 0xFFF, whose low
+ * nibble matches the reference's arithmetic shift.
+ */
+__attribute__((target("sse4.1"))) static __m128i encode_epi16_sse41(
+    __m128i pcm) {
+  const __m128i sign = _mm_srai_epi16(pcm, 15);
+  const __m128i magnitude = _mm_sub_epi16(
+      _mm_xor_si128(pcm, sign), _mm_and_si128(sign, _mm_set1_epi16(7)));
+  const __m128i alaw_mask =
+      _mm_xor_si128(_mm_set1_epi16(SIGNED_ALAW_MASK),
+                    _mm_and_si128(sign, _mm_set1_epi16(SIGN_BIT_MASK)));
+
+  __m128i over = _mm_cmpgt_epi16(magnitude, _mm_set1_epi16(SEGMENT_EDGES[0]));
+  __m128i segment = _mm_sub_epi16(_mm_setzero_si128(), over);
+  __m128i multiplier = _mm_set1_epi16(1 << 12);
+  for (std::size_t edge = 1; edge < SEGMENT_COUNT - 1; ++edge) {
+    over = _mm_cmpgt_epi16(magnitude, _mm_set1_epi16(SEGMENT_EDGES[edge]));
+    segment = _mm_sub_epi16(segment, over);
+    multiplier = _mm_sub_epi16(
+        multiplier, _mm_and_si128(_mm_srli_epi16(multiplier, 1), over));
+  }
+
+  const __m128i quant = _mm_and_si128(_mm_mulhi_epu16(magnitude, multiplier),
+                                      _mm_set1_epi16(QUANT_MASK));
+  return _mm_xor_si128(
+      _mm_or_si128(_mm_slli_epi16(segment, SEGMENT_SHIFT), quant), alaw_mask);
+}
+
+/*
+ * Decoder, 16-bit lanes: the segment's left shift (0..6) is a multiply by a
+ * power of two looked up with pshufb; the high byte of each index is 0x80 so
+ * pshufb writes a zero there.
+ */
+__attribute__((target("sse4.1"))) static __m128i decode_epi16_sse41(
+    __m128i alaw) {
+  const __m128i multipliers =
+      _mm_setr_epi8(1, 1, 2, 4, 8, 16, 32, 64, 0, 0, 0, 0, 0, 0, 0, 0);
+
+  const __m128i masked = _mm_xor_si128(alaw, _mm_set1_epi16(BASE_ALAW_MASK));
+  const __m128i quant = _mm_slli_epi16(
+      _mm_and_si128(masked, _mm_set1_epi16(QUANT_MASK)), QUANT_SHIFT);
+  const __m128i segment = _mm_and_si128(_mm_srli_epi16(masked, SEGMENT_SHIFT),
+                                        _mm_set1_epi16(0x7));
+
+  const __m128i has_segment = _mm_cmpgt_epi16(segment, _mm_setzero_si128());
+  const __m128i base = _mm_add_epi16(
+      _mm_add_epi16(quant, _mm_set1_epi16(0x008)),
+      _mm_and_si128(has_segment, _mm_set1_epi16(0x100)));
+
+  const __m128i multiplier = _mm_shuffle_epi8(
+      multipliers, _mm_or_si128(segment, _mm_set1_epi16(0x8000)));
+  const __m128i magnitude = _mm_mullo_epi16(base, multiplier);
+
+  // Sign bit clear -> negative: (x ^ -1) - (-1) = -x.
+  const __m128i negative = _mm_cmpeq_epi16(
+      _mm_and_si128(masked, _mm_set1_epi16(SIGN_BIT_MASK)),
+      _mm_setzero_si128());
+  return _mm_sub_epi16(_mm_xor_si128(magnitude, negative), negative);
+}
+
+__attribute__((target("sse4.1"))) static void encode_sse41(const int16_t* pcm,
+                                                           uint8_t* out,
+                                                           std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m128i lo = encode_epi16_sse41(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pcm + i)));
+    __m128i hi = encode_epi16_sse41(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pcm + i + 8)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm_packus_epi16(lo, hi));
+  }
+  encode_branchless(pcm + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1"))) static void decode_sse41(const uint8_t* alaw,
+                                                           int16_t* out,
+                                                           std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i bytes = _mm_cvtepu8_epi16(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(alaw + i)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     decode_epi16_sse41(bytes));
+  }
+  decode_table(alaw + i, out + i, count - i);
+}
+
+__attribute__((target("avx2"))) static __m256i encode_epi16_avx2(
+    __m256i pcm) {
+  const __m256i sign = _mm256_srai_epi16(pcm, 15);
+  const __m256i magnitude = _mm256_sub_epi16(
+      _mm256_xor_si256(pcm, sign), _mm256_and_si256(sign, _mm256_set1_epi16(7)));
+  const __m256i alaw_mask =
+      _mm256_xor_si256(_mm256_set1_epi16(SIGNED_ALAW_MASK),
+                       _mm256_and_si256(sign, _mm256_set1_epi16(SIGN_BIT_MASK)));
+
+  __m256i over =
+      _mm256_cmpgt_epi16(magnitude, _mm256_set1_epi16(SEGMENT_EDGES[0]));
+  __m256i segment = _mm256_sub_epi16(_mm256_setzero_si256(), over);
+  __m256i multiplier = _mm256_set1_epi16(1 << 12);
+  for (std::size_t edge = 1; edge < SEGMENT_COUNT - 1; ++edge) {
+    over = _mm256_cmpgt_epi16(magnitude, _mm256_set1_epi16(SEGMENT_EDGES[edge]));
+    segment = _mm256_sub_epi16(segment, over);
+    multiplier = _mm256_sub_epi16(
+        multiplier, _mm256_and_si256(_mm256_srli_epi16(multiplier, 1), over));
+  }
 
-    decode_table.at(alaw_sample) = pcm_sample;
+  const __m256i quant = _mm256_and_si256(
+      _mm256_mulhi_epu16(magnitude, multiplier), _mm256_set1_epi16(QUANT_MASK));
+  return _mm256_xor_si256(
+      _mm256_or_si256(_mm256_slli_epi16(segment, SEGMENT_SHIFT), quant),
+      alaw_mask);
+}
+
+__attribute__((target("avx2"))) static __m256i decode_epi16_avx2(
+    __m256i alaw) {
+  // pshufb looks up within each 128-bit lane: table replicated per lane.
+  const __m256i multipliers =
+      _mm256_setr_epi8(1, 1, 2, 4, 8, 16, 32, 64, 0, 0, 0, 0, 0, 0, 0, 0,  //
+                       1, 1, 2, 4, 8, 16, 32, 64, 0, 0, 0, 0, 0, 0, 0, 0);
+
+  const __m256i masked =
+      _mm256_xor_si256(alaw, _mm256_set1_epi16(BASE_ALAW_MASK));
+  const __m256i quant = _mm256_slli_epi16(
+      _mm256_and_si256(masked, _mm256_set1_epi16(QUANT_MASK)), QUANT_SHIFT);
+  const __m256i segment = _mm256_and_si256(
+      _mm256_srli_epi16(masked, SEGMENT_SHIFT), _mm256_set1_epi16(0x7));
+
+  const __m256i has_segment =
+      _mm256_cmpgt_epi16(segment, _mm256_setzero_si256());
+  const __m256i base = _mm256_add_epi16(
+      _mm256_add_epi16(quant, _mm256_set1_epi16(0x008)),
+      _mm256_and_si256(has_segment, _mm256_set1_epi16(0x100)));
+
+  const __m256i multiplier = _mm256_shuffle_epi8(
+      multipliers,
+      _mm256_or_si256(segment, _mm256_set1_epi16(static_cast<int16_t>(0x8000))));
+  const __m256i magnitude = _mm256_mullo_epi16(base, multiplier);
+
+  const __m256i negative = _mm256_cmpeq_epi16(
+      _mm256_and_si256(masked, _mm256_set1_epi16(SIGN_BIT_MASK)),
+      _mm256_setzero_si256());
+  return _mm256_sub_epi16(_mm256_xor_si256(magnitude, negative), negative);
+}
+
+__attribute__((target("avx2"))) static void encode_avx2(const int16_t* pcm,
+                                                        uint8_t* out,
+                                                        std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 32 <= count; i += 32) {
+    __m256i lo = encode_epi16_avx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pcm + i)));
+    __m256i hi = encode_epi16_avx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pcm + i + 16)));
+    // packus works per 128-bit lane: [lo0 hi0 lo1 hi1] -> [lo0 lo1 hi0 hi1].
+    __m256i packed =
+        _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), packed);
   }
+  encode_sse41(pcm + i, out + i, count - i);
+}
 
-  return decode_table;
+__attribute__((target("avx2"))) static void decode_avx2(const uint8_t* alaw,
+                                                        int16_t* out,
+                                                        std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256i bytes = _mm256_cvtepu8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(alaw + i)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        decode_epi16_avx2(bytes));
+  }
+  decode_sse41(alaw + i, out + i, count - i);
 }
 
+// NOLINTEND(readability-magic-numbers, cppcoreguidelines-pro-type-reinterpret-cast)
+
+#endif  // HERMES_ALAW_X86
+
 // NOLINTEND(hicpp-signed-bitwise)
 
-// Uses the pre-computed table for O(1) lookup per sample.
+namespace {
+
+using EncodeFn = void (*)(const int16_t*, uint8_t*, std::size_t);
+using DecodeFn = void (*)(const uint8_t*, int16_t*, std::size_t);
+
+struct Kernels {
+  EncodeFn encode;
+  DecodeFn decode;
+};
+
+Kernels select_kernels() {
+#if HERMES_ALAW_X86
+  // May run from a static initializer, before libgcc has probed the CPU.
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return {encode_avx2, decode_avx2};
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return {encode_sse41, decode_sse41};
+  }
+#endif
+  return {encode_branchless, decode_table};
+}
+
+// Resolved once at load time; hot calls are a single indirect jump.
+const Kernels kKernels = select_kernels();
+
+}  // namespace
+
 void encode_alaw(boost::span<const int16_t> pcm, boost::span<uint8_t> alawOut) {
+  encode_alaw(pcm, alawOut, ALawVariant::Simd);
+}
+
+void encode_alaw(boost::span<const int16_t> pcm, boost::span<uint8_t> alawOut,
+                 ALawVariant variant) {
   // Ensure output span is large enough
   if (pcm.size() > alawOut.size()) {
     return;  // Or throw an exception based on your error handling policy
   }
 
-  static const auto encode_table = make_encode_table();
-
-  for (std::size_t i = 0; i < pcm.size(); ++i) {
-    const auto encode_table_idx = get_encode_table_idx(pcm[i]);
-    alawOut[i] = encode_table.at(encode_table_idx);
+  switch (variant) {
+    case ALawVariant::Table:
+      encode_table(pcm.data(), alawOut.data(), pcm.size());
+      break;
+    case ALawVariant::Branchless:
+      encode_branchless(pcm.data(), alawOut.data(), pcm.size());
+      break;
+    case ALawVariant::Simd:
+    default:
+      kKernels.encode(pcm.data(), alawOut.data(), pcm.size());
+      break;
   }
 }
 
-// Uses the pre-computed table for O(1) lookup per sample.
 void decode_alaw(boost::span<const uint8_t> alaw, boost::span<int16_t> pcmOut) {
   // Ensure output span is large enough
   if (alaw.size() > pcmOut.size()) {
     return;  // Or throw an exception based on your error handling policy
   }
 
-  static const auto decode_table = make_decode_table();
+  kKernels.decode(alaw.data(), pcmOut.data(), alaw.size());
+}
 
-  for (std::size_t i = 0; i < alaw.size(); ++i) {
-    pcmOut[i] = decode_table.at(alaw[i]);
+void decode_alaw_table(boost::span<const uint8_t> alaw,
+                       boost::span<int16_t> pcmOut) {
+  if (alaw.size() > pcmOut.size()) {
+    return;
   }
+
+  decode_table(alaw.data(), pcmOut.data(), alaw.size());
 }
 }  // namespace hermes::audio
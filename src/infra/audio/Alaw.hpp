@@ -3,19 +3,49 @@
 #include <cstddef>
 #include <cstdint>
 namespace hermes::audio {
+
+/// A-law code for PCM 0 (even-bit inverted 0x80).
+inline constexpr uint8_t ALAW_SILENCE = 0xD5;
+
+/**
+ * @brief A-Law encoder implementations. All of them produce bit-identical
+ * output for every int16 input.
+ */
+enum class ALawVariant : uint8_t {
+  Simd,        ///< SSE4.1 / AVX2 when available, branchless scalar otherwise
+  Branchless,  ///< Segment from the bit width of the magnitude, no table
+  Table        ///< 128-byte constexpr segment table + shift
+};
+
 /**
- * @brief  G.711a A-Law encoder (LUT-based).
+ * @brief  G.711a A-Law encoder (best available implementation).
  * @param pcm Input buffer of 16-bit signed integers.
  * @param alawOut Output buffer. Must be at least `pcm.size()` bytes.
  */
 void encode_alaw(boost::span<const int16_t> pcm, boost::span<uint8_t> alawOut);
 
+/**
+ * @brief Same as encode_alaw(), with an explicit implementation.
+ */
+void encode_alaw(boost::span<const int16_t> pcm, boost::span<uint8_t> alawOut,
+                 ALawVariant variant);
+
 /* Fast in-place encoder.
  *buf      : pointer to a buffer that *presently* holds PCM-16 samples
  *   pcmBytes : how many PCM bytes are valid in the buffer (must be even)
  * Returns     number of encoded bytes now valid at buf[0..N-1].              */
 std::size_t encode_alaw_inplace(uint8_t* buf, std::size_t pcmBytes);
 
-/* (Optional) Decode A-law back to PCM-16 */
+/* Decode A-law back to PCM-16 (vectorized when the CPU allows it) */
 void decode_alaw(boost::span<const uint8_t> alaw, boost::span<int16_t> pcmOut);
+
+/* Decode through the 512-byte constexpr table */
+void decode_alaw_table(boost::span<const uint8_t> alaw,
+                       boost::span<int16_t> pcmOut);
+
+/**
+ * @brief Straightforward per-sample codec the fast paths are checked against.
+ */
+uint8_t encode_alaw_reference(int16_t pcm_sample);
+int16_t decode_alaw_reference(uint8_t alaw_sample);
 }  // namespace hermes::audio
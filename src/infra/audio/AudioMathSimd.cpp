@@ -0,0 +1,362 @@
+#include "AudioMathSimd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#include "PcmCast.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HERMES_MIX_X86 1
+#include <immintrin.h>
+#else
+#define HERMES_MIX_X86 0
+#endif
+
+namespace hermes::audio::simd {
+
+namespace {
+
+constexpr float MAX_INT16 = 32767.0f;
+constexpr int32_t CLIP_LIMIT = 30000;
+
+// tanh(|x|) = (1 - y) / (1 + y), y = e^(-2|x|) = 2^(-2|x| * log2(e)).
+// 2^t is split into 2^n * 2^f with n = round(t), f in [-0.5, 0.5]; 2^f is a
+// degree-6 Taylor polynomial (max rel. error ~2e-7 on that interval).
+constexpr float NEG_TWO_LOG2E = -2.8853900817779268f;
+// Below this y underflows float; tanh is 1.0f to the last bit anyway.
+constexpr float MIN_EXP2 = -126.0f;
+constexpr float C1 = 0.69314718056f;
+constexpr float C2 = 0.24022650695f;
+constexpr float C3 = 0.05550410866f;
+constexpr float C4 = 0.00961812911f;
+constexpr float C5 = 0.00133335581f;
+constexpr float C6 = 0.00015403530f;
+constexpr int32_t FLOAT_EXP_BIAS = 127;
+constexpr int FLOAT_MANTISSA_BITS = 23;
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+/// Scalar soft clip using the same curve and operation order as the vector
+/// kernels, so every ISA produces identical samples.
+int16_t soft_clip_fast(int32_t sample) {
+  if (sample > CLIP_LIMIT || sample < -CLIP_LIMIT) {
+    float compressed = fast_tanh(static_cast<float>(sample) / MAX_INT16);
+    return static_cast<int16_t>(compressed * MAX_INT16);
+  }
+  return static_cast<int16_t>(sample);
+}
+
+#if HERMES_MIX_X86
+
+// ---------------------------------------------------------------------------
+// SSE4.1
+// ---------------------------------------------------------------------------
+
+__attribute__((target("sse4.1"))) __m128 tanh_ps_sse41(__m128 x) {
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  __m128 sign = _mm_and_ps(x, sign_mask);
+  __m128 ax = _mm_andnot_ps(sign_mask, x);
+
+  __m128 t = _mm_mul_ps(ax, _mm_set1_ps(NEG_TWO_LOG2E));
+  t = _mm_max_ps(t, _mm_set1_ps(MIN_EXP2));
+  __m128 n = _mm_round_ps(t, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  __m128 f = _mm_sub_ps(t, n);
+
+  __m128 p = _mm_set1_ps(C6);
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(C5));
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(C4));
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(C3));
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(C2));
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(C1));
+  p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+
+  __m128i e = _mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(FLOAT_EXP_BIAS));
+  __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(e, FLOAT_MANTISSA_BITS));
+  __m128 y = _mm_mul_ps(p, scale);
+
+  const __m128 one = _mm_set1_ps(1.0f);
+  __m128 r = _mm_div_ps(_mm_sub_ps(one, y), _mm_add_ps(one, y));
+  return _mm_or_ps(r, sign);
+}
+
+/// Soft-clips 4 int32 lanes; returns them still as int32.
+__attribute__((target("sse4.1"))) __m128i soft_clip_epi32_sse41(__m128i v) {
+  __m128i over = _mm_cmpgt_epi32(_mm_abs_epi32(v), _mm_set1_epi32(CLIP_LIMIT));
+  if (_mm_testz_si128(over, over)) {
+    return v;
+  }
+
+  __m128 x = _mm_div_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(MAX_INT16));
+  __m128 clipped = _mm_mul_ps(tanh_ps_sse41(x), _mm_set1_ps(MAX_INT16));
+  return _mm_blendv_epi8(v, _mm_cvttps_epi32(clipped), over);
+}
+
+__attribute__((target("sse4.1"))) void sum_sse41(int32_t* acc,
+                                                 const int16_t* in,
+                                                 size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));  // NOLINT
+    __m128i lo = _mm_cvtepi16_epi32(s);
+    __m128i hi = _mm_cvtepi16_epi32(_mm_srli_si128(s, 8));
+
+    auto* a = reinterpret_cast<__m128i*>(acc + i);  // NOLINT
+    _mm_storeu_si128(a, _mm_add_epi32(_mm_loadu_si128(a), lo));
+    _mm_storeu_si128(a + 1, _mm_add_epi32(_mm_loadu_si128(a + 1), hi));
+  }
+  for (; i < count; ++i) {
+    acc[i] += in[i];
+  }
+}
+
+__attribute__((target("sse4.1"))) void compress_sse41(const int32_t* acc,
+                                                      uint8_t* out,
+                                                      size_t count) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const auto* a = reinterpret_cast<const __m128i*>(acc + i);  // NOLINT
+    __m128i lo = soft_clip_epi32_sse41(_mm_loadu_si128(a));
+    __m128i hi = soft_clip_epi32_sse41(_mm_loadu_si128(a + 1));
+    // Every lane is within int16 range now, so the saturating pack is exact.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * sizeof(int16_t)),  // NOLINT
+                     _mm_packs_epi32(lo, hi));
+  }
+  for (; i < count; ++i) {
+    pcm::write_sample(out, i, soft_clip_fast(acc[i]));
+  }
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 (deliberately no FMA so results match the SSE/scalar paths exactly)
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2"))) __m256 tanh_ps_avx2(__m256 x) {
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  __m256 sign = _mm256_and_ps(x, sign_mask);
+  __m256 ax = _mm256_andnot_ps(sign_mask, x);
+
+  __m256 t = _mm256_mul_ps(ax, _mm256_set1_ps(NEG_TWO_LOG2E));
+  t = _mm256_max_ps(t, _mm256_set1_ps(MIN_EXP2));
+  __m256 n =
+      _mm256_round_ps(t, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  __m256 f = _mm256_sub_ps(t, n);
+
+  __m256 p = _mm256_set1_ps(C6);
+  p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(C5));
+  p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(C4));
+  p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(C3));
+  p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(C2));
+  p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(C1));
+  p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(1.0f));
+
+  __m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n),
+                               _mm256_set1_epi32(FLOAT_EXP_BIAS));
+  __m256 scale = _mm256_castsi256_ps(_mm256_slli_epi32(e, FLOAT_MANTISSA_BITS));
+  __m256 y = _mm256_mul_ps(p, scale);
+
+  const __m256 one = _mm256_set1_ps(1.0f);
+  __m256 r = _mm256_div_ps(_mm256_sub_ps(one, y), _mm256_add_ps(one, y));
+  return _mm256_or_ps(r, sign);
+}
+
+__attribute__((target("avx2"))) __m256i soft_clip_epi32_avx2(__m256i v) {
+  __m256i over =
+      _mm256_cmpgt_epi32(_mm256_abs_epi32(v), _mm256_set1_epi32(CLIP_LIMIT));
+  if (_mm256_testz_si256(over, over)) {
+    return v;
+  }
+
+  __m256 x = _mm256_div_ps(_mm256_cvtepi32_ps(v), _mm256_set1_ps(MAX_INT16));
+  __m256 clipped = _mm256_mul_ps(tanh_ps_avx2(x), _mm256_set1_ps(MAX_INT16));
+  return _mm256_blendv_epi8(v, _mm256_cvttps_epi32(clipped), over);
+}
+
+__attribute__((target("avx2"))) void sum_avx2(int32_t* acc, const int16_t* in,
+                                              size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));  // NOLINT
+    __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(s));
+    __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(s, 1));
+
+    auto* a = reinterpret_cast<__m256i*>(acc + i);  // NOLINT
+    _mm256_storeu_si256(a, _mm256_add_epi32(_mm256_loadu_si256(a), lo));
+    _mm256_storeu_si256(a + 1, _mm256_add_epi32(_mm256_loadu_si256(a + 1), hi));
+  }
+  sum_sse41(acc + i, in + i, count - i);
+}
+
+__attribute__((target("avx2"))) void compress_avx2(const int32_t* acc,
+                                                   uint8_t* out, size_t count) {
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const auto* a = reinterpret_cast<const __m256i*>(acc + i);  // NOLINT
+    __m256i lo = soft_clip_epi32_avx2(_mm256_loadu_si256(a));
+    __m256i hi = soft_clip_epi32_avx2(_mm256_loadu_si256(a + 1));
+    // packs works per 128-bit lane: [lo0 hi0 lo1 hi1] -> [lo0 lo1 hi0 hi1].
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * sizeof(int16_t)),  // NOLINT
+                        packed);
+  }
+  compress_sse41(acc + i, out + i * sizeof(int16_t), count - i);
+}
+
+#endif  // HERMES_MIX_X86
+
+void sum_scalar(int32_t* acc, const int16_t* in, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    acc[i] += in[i];
+  }
+}
+
+void compress_scalar(const int32_t* acc, uint8_t* out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    pcm::write_sample(out, i, soft_clip_fast(acc[i]));
+  }
+}
+
+// NOLINTEND(readability-magic-numbers)
+
+using SumFn = void (*)(int32_t*, const int16_t*, size_t);
+using CompressFn = void (*)(const int32_t*, uint8_t*, size_t);
+
+struct Kernels {
+  MixIsa isa;
+  SumFn sum;
+  CompressFn compress;
+};
+
+Kernels select_kernels() {
+#if HERMES_MIX_X86
+  // May run from a static initializer, before libgcc has probed the CPU.
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return {MixIsa::Avx2, sum_avx2, compress_avx2};
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return {MixIsa::Sse41, sum_sse41, compress_sse41};
+  }
+#endif
+  return {MixIsa::Scalar, sum_scalar, compress_scalar};
+}
+
+// Resolved once at load time; hot calls are a single indirect jump.
+const Kernels kKernels = select_kernels();
+
+size_t sum_count(std::span<int32_t> accumulator,
+                 std::span<const int16_t> input) {
+  return std::min(accumulator.size(), input.size());
+}
+
+size_t export_count(std::span<const int32_t> accumulator,
+                    std::span<uint8_t> output_bytes) {
+  return std::min(accumulator.size(), output_bytes.size() / sizeof(int16_t));
+}
+
+}  // namespace
+
+MixIsa active_isa() { return kKernels.isa; }
+
+std::string_view to_string(MixIsa isa) {
+  switch (isa) {
+    case MixIsa::Avx2:
+      return "AVX2";
+    case MixIsa::Sse41:
+      return "SSE4.1";
+    case MixIsa::Scalar:
+    default:
+      return "Scalar";
+  }
+}
+
+float fast_tanh(float x) {
+  const float ax = std::fabs(x);
+
+  float t = std::max(ax * NEG_TWO_LOG2E, MIN_EXP2);
+  float n = std::nearbyint(t);
+  float f = t - n;
+
+  float p = C6;
+  p = p * f + C5;
+  p = p * f + C4;
+  p = p * f + C3;
+  p = p * f + C2;
+  p = p * f + C1;
+  p = p * f + 1.0f;
+
+  auto e = static_cast<uint32_t>(static_cast<int32_t>(n) + FLOAT_EXP_BIAS);
+  float y = p * std::bit_cast<float>(e << FLOAT_MANTISSA_BITS);
+
+  return std::copysign((1.0f - y) / (1.0f + y), x);
+}
+
+void sum_buffers(std::span<int32_t> accumulator,
+                 std::span<const int16_t> input) {
+  kKernels.sum(accumulator.data(), input.data(), sum_count(accumulator, input));
+}
+
+void compress_and_export(std::span<const int32_t> accumulator,
+                         std::span<uint8_t> output_bytes) {
+  kKernels.compress(accumulator.data(), output_bytes.data(),
+                    export_count(accumulator, output_bytes));
+}
+
+void sum_buffers_scalar(std::span<int32_t> accumulator,
+                        std::span<const int16_t> input) {
+  sum_scalar(accumulator.data(), input.data(), sum_count(accumulator, input));
+}
+
+void compress_and_export_scalar(std::span<const int32_t> accumulator,
+                                std::span<uint8_t> output_bytes) {
+  compress_scalar(accumulator.data(), output_bytes.data(),
+                  export_count(accumulator, output_bytes));
+}
+
+#if HERMES_MIX_X86
+void sum_buffers_sse41(std::span<int32_t> accumulator,
+                       std::span<const int16_t> input) {
+  sum_sse41(accumulator.data(), input.data(), sum_count(accumulator, input));
+}
+
+void sum_buffers_avx2(std::span<int32_t> accumulator,
+                      std::span<const int16_t> input) {
+  sum_avx2(accumulator.data(), input.data(), sum_count(accumulator, input));
+}
+
+void compress_and_export_sse41(std::span<const int32_t> accumulator,
+                               std::span<uint8_t> output_bytes) {
+  compress_sse41(accumulator.data(), output_bytes.data(),
+                 export_count(accumulator, output_bytes));
+}
+
+void compress_and_export_avx2(std::span<const int32_t> accumulator,
+                              std::span<uint8_t> output_bytes) {
+  compress_avx2(accumulator.data(), output_bytes.data(),
+                export_count(accumulator, output_bytes));
+}
+#else
+// Non-x86 builds: the explicit variants fall back to scalar.
+void sum_buffers_sse41(std::span<int32_t> accumulator,
+                       std::span<const int16_t> input) {
+  sum_buffers_scalar(accumulator, input);
+}
+
+void sum_buffers_avx2(std::span<int32_t> accumulator,
+                      std::span<const int16_t> input) {
+  sum_buffers_scalar(accumulator, input);
+}
+
+void compress_and_export_sse41(std::span<const int32_t> accumulator,
+                               std::span<uint8_t> output_bytes) {
+  compress_and_export_scalar(accumulator, output_bytes);
+}
+
+void compress_and_export_avx2(std::span<const int32_t> accumulator,
+                              std::span<uint8_t> output_bytes) {
+  compress_and_export_scalar(accumulator, output_bytes);
+}
+#endif
+
+}  // namespace hermes::audio::simd
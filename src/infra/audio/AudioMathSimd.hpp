@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/**
+ * @file AudioMathSimd.hpp
+ * @brief Vectorized mixing kernels (SSE4.1 / AVX2) selected at runtime.
+ *
+ * The ISA is probed once at start-up; every call then goes through a plain
+ * function pointer. All variants share the same soft-clip curve
+ * (fast_tanh), so their output is bit-identical to each other and within
+ * ±1 LSB of the reference std::tanh path in AudioMath::soft_clip for any
+ * accumulator value a 16-input mixer can produce.
+ */
+namespace hermes::audio::simd {
+
+enum class MixIsa : uint8_t { Scalar, Sse41, Avx2 };
+
+/**
+ * @brief The instruction set the dispatcher picked for this CPU.
+ */
+MixIsa active_isa();
+
+std::string_view to_string(MixIsa isa);
+
+/**
+ * @brief Exp-based tanh that vectorizes (no libm call, no branches).
+ * Accurate to ~1e-6 absolute, i.e. well below one int16 LSB after scaling.
+ */
+float fast_tanh(float x);
+
+/**
+ * @brief acc[i] += input[i] using the best available ISA.
+ */
+void sum_buffers(std::span<int32_t> accumulator,
+                 std::span<const int16_t> input);
+
+/**
+ * @brief Soft-clips the accumulator into native-endian int16 PCM bytes using
+ * the best available ISA.
+ */
+void compress_and_export(std::span<const int32_t> accumulator,
+                         std::span<uint8_t> output_bytes);
+
+// --- Explicit variants (benchmarks / equivalence checks) ---
+// Calling a variant the CPU does not support is undefined behavior.
+void sum_buffers_scalar(std::span<int32_t> accumulator,
+                        std::span<const int16_t> input);
+void sum_buffers_sse41(std::span<int32_t> accumulator,
+                       std::span<const int16_t> input);
+void sum_buffers_avx2(std::span<int32_t> accumulator,
+                      std::span<const int16_t> input);
+
+void compress_and_export_scalar(std::span<const int32_t> accumulator,
+                                std::span<uint8_t> output_bytes);
+void compress_and_export_sse41(std::span<const int32_t> accumulator,
+                               std::span<uint8_t> output_bytes);
+void compress_and_export_avx2(std::span<const int32_t> accumulator,
+                              std::span<uint8_t> output_bytes);
+
+}  // namespace hermes::audio::simd
@@ -0,0 +1,114 @@
+#include "BufferPool.hpp"
+
+#include "core/config/Config.hpp"
+
+namespace hermes::infra {
+
+void BufferPoolReturn::operator()(uint8_t* block) const noexcept {
+  if (pool != nullptr) {
+    pool->release(block);
+  } else {
+    delete[] block;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+}
+
+namespace {
+
+// Every shard ever created; only touched when a thread first acquires a
+// block and when /metrics sums them up.
+std::mutex& shards_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::vector<BufferPool*>& shards() {
+  static auto* list = new std::vector<BufferPool*>();  // NOLINT
+  return *list;
+}
+
+}  // namespace
+
+BufferPool& BufferPool::local() {
+  // Intentionally leaked: a block may outlive the thread that acquired it
+  // (or be freed during static destruction) and must still have a pool to
+  // return to.
+  thread_local BufferPool* shard = [] {
+    auto* pool = new BufferPool(  // NOLINT
+        config::BUFFER_SIZE, config::BUFFER_POOL_MAX_IDLE_BLOCKS);
+    std::lock_guard lock(shards_mutex());
+    shards().push_back(pool);
+    return pool;
+  }();
+  return *shard;
+}
+
+BufferPoolStats BufferPool::get_total_stats() {
+  BufferPoolStats total{.block_size = config::BUFFER_SIZE};
+  std::lock_guard lock(shards_mutex());
+  for (const auto* shard : shards()) {
+    auto stats = shard->get_stats();
+    total.idle += stats.idle;
+    total.in_use += stats.in_use;
+    total.allocations += stats.allocations;
+    total.reuses += stats.reuses;
+  }
+  return total;
+}
+
+BufferPool::BufferPool(std::size_t block_size, std::size_t max_idle)
+    : block_size_(block_size), max_idle_(max_idle) {
+  idle_.reserve(max_idle_);
+}
+
+BufferPool::~BufferPool() {
+  for (auto* block : idle_) {
+    delete[] block;  // NOLINT(cppcoreguidelines-owning-memory)
+  }
+}
+
+PooledBlock BufferPool::acquire() {
+  in_use_.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::lock_guard lock(mutex_);
+    if (!idle_.empty()) {
+      auto* block = idle_.back();
+      idle_.pop_back();
+      reuses_.fetch_add(1, std::memory_order_relaxed);
+      return PooledBlock(block, BufferPoolReturn{this});
+    }
+  }
+
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  // Default-initialized on purpose: callers fill the block before reading it.
+  return PooledBlock(new uint8_t[block_size_],  // NOLINT
+                     BufferPoolReturn{this});
+}
+
+void BufferPool::release(uint8_t* block) noexcept {
+  if (block == nullptr) {
+    return;
+  }
+  in_use_.fetch_sub(1, std::memory_order_relaxed);
+
+  {
+    std::lock_guard lock(mutex_);
+    if (idle_.size() < max_idle_) {
+      idle_.push_back(block);
+      return;
+    }
+  }
+  // Pool is full (after an unusually large burst): give memory back.
+  delete[] block;  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+BufferPoolStats BufferPool::get_stats() const {
+  std::lock_guard lock(mutex_);
+  return BufferPoolStats{.block_size = block_size_,
+                         .idle = idle_.size(),
+                         .in_use = in_use_.load(std::memory_order_relaxed),
+                         .allocations =
+                             allocations_.load(std::memory_order_relaxed),
+                         .reuses = reuses_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace hermes::infra
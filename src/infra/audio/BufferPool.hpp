@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hermes::infra {
+
+class BufferPool;
+
+/**
+ * @brief Returns a block to its pool instead of freeing it.
+ */
+struct BufferPoolReturn {
+  BufferPool* pool = nullptr;
+  void operator()(uint8_t* block) const noexcept;
+};
+
+/// A config::BUFFER_SIZE byte block owned by the caller until destroyed.
+using PooledBlock = std::unique_ptr<uint8_t[], BufferPoolReturn>;
+
+struct BufferPoolStats {
+  std::size_t block_size = 0;
+  std::size_t idle = 0;
+  uint64_t in_use = 0;
+  uint64_t allocations = 0;
+  uint64_t reuses = 0;
+};
+
+/**
+ * @brief Recycler for the fixed-size streaming blocks used by DoubleBuffer,
+ * sharded per thread.
+ *
+ * A session burst would otherwise allocate (and page-fault) 256 KB per
+ * streaming file node; with the pool, blocks released by finished sessions
+ * are handed straight to new ones. Blocks are NOT zeroed on reuse: every
+ * consumer writes a block before reading it.
+ *
+ * Blocks are acquired from the calling thread's shard, i.e. the session's
+ * io_context (each pins one thread), so concurrent session starts on
+ * different io_contexts never share a lock. A block always returns to the
+ * shard it came from, which may be released on any thread.
+ */
+class BufferPool {
+ public:
+  /** @brief The calling thread's shard (created on first use). */
+  static BufferPool& local();
+
+  /** @brief Stats summed over every shard (for /metrics). */
+  static BufferPoolStats get_total_stats();
+
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+
+  ~BufferPool();
+
+  PooledBlock acquire();
+
+  std::size_t block_size() const { return block_size_; }
+
+  BufferPoolStats get_stats() const;
+
+ private:
+  friend struct BufferPoolReturn;
+
+  BufferPool(std::size_t block_size, std::size_t max_idle);
+
+  void release(uint8_t* block) noexcept;
+
+  const std::size_t block_size_;
+  const std::size_t max_idle_;
+
+  mutable std::mutex mutex_;
+  std::vector<uint8_t*> idle_;
+
+  std::atomic<uint64_t> in_use_{0};
+  std::atomic<uint64_t> allocations_{0};
+  std::atomic<uint64_t> reuses_{0};
+};
+
+}  // namespace hermes::infra
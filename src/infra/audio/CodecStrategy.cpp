@@ -0,0 +1,157 @@
+#include "CodecStrategy.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cctype>
+
+#if HERMES_WITH_OPUS
+#include <opus.h>
+#endif
+
+namespace hermes::audio {
+
+std::optional<CodecKind> parse_codec_kind(std::string_view name) {
+  std::string lower(name);
+  std::ranges::transform(lower, lower.begin(), [](unsigned char c) {
+    return static_cast<char>(std::tolower(c));
+  });
+
+  if (lower == "pcma" || lower == "alaw") return CodecKind::Pcma;
+  if (lower == "pcmu" || lower == "ulaw") return CodecKind::Pcmu;
+  if (lower == "g722") return CodecKind::G722;
+  if (lower == "opus") return CodecKind::Opus;
+  return std::nullopt;
+}
+
+std::string_view to_string(CodecKind kind) {
+  switch (kind) {
+    case CodecKind::Pcma:
+      return "PCMA";
+    case CodecKind::Pcmu:
+      return "PCMU";
+    case CodecKind::G722:
+      return "G722";
+    case CodecKind::Opus:
+      return "opus";
+    default:
+      return "Unknown";
+  }
+}
+
+bool is_codec_available(CodecKind kind) {
+#if HERMES_WITH_OPUS
+  (void)kind;
+  return true;
+#else
+  return kind != CodecKind::Opus;
+#endif
+}
+
+// -----------------------------
+// G.722
+// -----------------------------
+
+size_t G722CodecStrategy::encode(std::span<const uint8_t> pcm,
+                                 std::span<uint8_t> out_buffer) {
+  auto wideband = adapter_.process(pcm::as_samples(pcm));
+
+  // One byte per pair of 16 kHz samples, like G.711 at 8 kHz
+  return encoder_.encode(wideband, out_buffer);
+}
+
+uint32_t G722CodecStrategy::get_timestamp_increment(
+    size_t pcm_byte_size) const {
+  return rtp_ticks(pcm_byte_size, adapter_.input_rate(), get_clock_rate());
+}
+
+// -----------------------------
+// Opus
+// -----------------------------
+
+#if HERMES_WITH_OPUS
+
+namespace {
+
+/**
+ * @brief Opus via libopus. The encoder runs at the session rate (8/16/48 kHz
+ * are all native Opus rates); the RTP clock is always 48 kHz (RFC 7587).
+ */
+class OpusCodecStrategy : public ICodecStrategy {
+ public:
+  static constexpr uint32_t RTP_CLOCK_RATE = 48000;
+  static constexpr uint8_t PAYLOAD_TYPE = 111;  // Dynamic; matches Janus
+
+  OpusCodecStrategy(OpusEncoder* encoder, uint32_t input_rate)
+      : encoder_(encoder), input_rate_(input_rate) {}
+
+  OpusCodecStrategy(const OpusCodecStrategy&) = delete;
+  OpusCodecStrategy& operator=(const OpusCodecStrategy&) = delete;
+
+  ~OpusCodecStrategy() override { opus_encoder_destroy(encoder_); }
+
+  size_t encode(std::span<const uint8_t> pcm,
+                std::span<uint8_t> out_buffer) override {
+    auto samples = pcm::as_samples(pcm);
+    opus_int32 bytes = opus_encode(
+        encoder_, samples.data(), static_cast<int>(samples.size()),
+        out_buffer.data(), static_cast<opus_int32>(out_buffer.size()));
+    return bytes > 0 ? static_cast<size_t>(bytes) : 0;
+  }
+
+  uint8_t get_payload_type() const override { return PAYLOAD_TYPE; }
+
+  uint32_t get_timestamp_increment(size_t pcm_byte_size) const override {
+    return rtp_ticks(pcm_byte_size, input_rate_, RTP_CLOCK_RATE);
+  }
+
+  uint32_t get_clock_rate() const override { return RTP_CLOCK_RATE; }
+
+  std::string_view get_name() const override { return "opus"; }
+
+ private:
+  OpusEncoder* encoder_;
+  uint32_t input_rate_;
+};
+
+std::expected<std::unique_ptr<ICodecStrategy>, std::string> create_opus(
+    uint32_t input_rate) {
+  int err = OPUS_OK;
+  OpusEncoder* encoder =
+      opus_encoder_create(static_cast<opus_int32>(input_rate),
+                          config::CHANNELS, OPUS_APPLICATION_VOIP, &err);
+  if (err != OPUS_OK || encoder == nullptr) {
+    return std::unexpected(std::string("opus_encoder_create failed: ") +
+                           opus_strerror(err));
+  }
+
+  opus_encoder_ctl(encoder, OPUS_SET_BITRATE(config::OPUS_BITRATE));
+  return std::make_unique<OpusCodecStrategy>(encoder, input_rate);
+}
+
+}  // namespace
+
+#endif  // HERMES_WITH_OPUS
+
+std::expected<std::unique_ptr<ICodecStrategy>, std::string>
+create_codec_strategy(CodecKind kind, uint32_t input_rate) {
+  switch (kind) {
+    case CodecKind::Pcma:
+      return std::make_unique<ALawCodecStrategy>(ALawVariant::Simd,
+                                                 input_rate);
+    case CodecKind::Pcmu:
+      return std::make_unique<ULawCodecStrategy>(input_rate);
+    case CodecKind::G722:
+      return std::make_unique<G722CodecStrategy>(input_rate);
+    case CodecKind::Opus:
+#if HERMES_WITH_OPUS
+      return create_opus(input_rate);
+#else
+      return std::unexpected(std::string("built without Opus support"));
+#endif
+    default:
+      return std::unexpected(std::string("unknown codec"));
+  }
+}
+
+}  // namespace hermes::audio
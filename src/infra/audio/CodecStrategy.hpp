@@ -1,11 +1,41 @@
 #pragma once
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
 #include <span>
+#include <string>
+#include <string_view>
 
 #include "Alaw.hpp"
+#include "Config.hpp"
+#include "G722Encoder.hpp"
+#include "Mulaw.hpp"
 #include "PcmCast.hpp"
+#include "RateAdapter.hpp"
 namespace hermes::audio {
+
+/**
+ * @brief Wire codecs a session can stream with (chosen in the clients node).
+ */
+enum class CodecKind : uint8_t { Pcma, Pcmu, G722, Opus };
+
+/**
+ * @brief Parses the clients node "codec" field ("pcma", "pcmu", "g722",
+ * "opus"; case-insensitive).
+ */
+std::optional<CodecKind> parse_codec_kind(std::string_view name);
+
+std::string_view to_string(CodecKind kind);
+
+/**
+ * @brief False for codecs this binary was built without (Opus is left out
+ * with -DHERMES_WITH_OPUS=OFF).
+ */
+bool is_codec_available(CodecKind kind);
+
 /**
  * @brief Interface for Audio Encoding Algorithms.
  */
@@ -34,20 +64,43 @@ struct ICodecStrategy {
    * @param pcm_byte_size Size of the raw PCM input in bytes.
    */
   virtual uint32_t get_timestamp_increment(size_t pcm_byte_size) const = 0;
+
+  /** @brief RTP clock rate advertised for the payload type (SDP a=rtpmap). */
+  virtual uint32_t get_clock_rate() const = 0;
+
+  virtual std::string_view get_name() const = 0;
 };
 
+/**
+ * @brief RTP timestamp ticks covered by `pcm_byte_size` bytes of PCM at
+ * `input_rate`, on a `clock_rate` RTP clock.
+ */
+constexpr uint32_t rtp_ticks(size_t pcm_byte_size, uint32_t input_rate,
+                             uint32_t clock_rate) {
+  const uint64_t samples = pcm_byte_size / sizeof(int16_t);
+  return static_cast<uint32_t>(samples * clock_rate / input_rate);
+}
+
+/**
+ * @brief G.711 A-Law (PCMA). Every ALawVariant is bit-exact; the default
+ * picks the vectorized encoder for this CPU. Wideband sessions are
+ * decimated to 8 kHz first.
+ */
 struct ALawCodecStrategy : ICodecStrategy {
+  explicit ALawCodecStrategy(ALawVariant variant = ALawVariant::Simd,
+                             uint32_t input_rate = config::SAMPLE_RATE)
+      : variant_(variant), adapter_(input_rate, config::SAMPLE_RATE) {}
+
   size_t encode(std::span<const uint8_t> pcm,
                 std::span<uint8_t> out_buffer) override {
-    const size_t sample_count = pcm.size() / sizeof(int16_t);
+    auto samples = adapter_.process(pcm::as_samples(pcm));
+    const size_t sample_count = samples.size();
 
     if (out_buffer.size() < sample_count) {
       return 0;
     }
 
-    auto samples = pcm::as_samples(pcm);
-
-    encode_alaw(samples, out_buffer);
+    encode_alaw(samples, out_buffer, variant_);
 
     return sample_count;  // A-Law is 1 byte per sample
   }
@@ -57,8 +110,108 @@ struct ALawCodecStrategy : ICodecStrategy {
   }
 
   uint32_t get_timestamp_increment(size_t pcm_byte_size) const override {
-    // For A-Law/PCM, 1 sample = 1 timestamp tick
-    return static_cast<uint32_t>(pcm_byte_size / sizeof(int16_t));
+    // For A-Law/PCM, 1 sample = 1 timestamp tick at 8 kHz
+    return rtp_ticks(pcm_byte_size, adapter_.input_rate(),
+                     config::SAMPLE_RATE);
   }
+
+  /**
+   * @brief Decodes PCMA back to PCM (vectorized).
+   * @return Number of samples written to pcm_out.
+   */
+  size_t decode(std::span<const uint8_t> alaw, std::span<int16_t> pcm_out) {
+    if (pcm_out.size() < alaw.size()) {
+      return 0;
+    }
+    decode_alaw(alaw, pcm_out);
+    return alaw.size();
+  }
+
+  uint32_t get_clock_rate() const override { return config::SAMPLE_RATE; }
+
+  std::string_view get_name() const override { return "PCMA"; }
+
+  ALawVariant variant() const { return variant_; }
+
+ private:
+  ALawVariant variant_;
+  RateAdapter adapter_;
 };
+
+/**
+ * @brief G.711 mu-Law (PCMU).
+ */
+struct ULawCodecStrategy : ICodecStrategy {
+  explicit ULawCodecStrategy(uint32_t input_rate = config::SAMPLE_RATE)
+      : adapter_(input_rate, config::SAMPLE_RATE) {}
+
+  size_t encode(std::span<const uint8_t> pcm,
+                std::span<uint8_t> out_buffer) override {
+    auto samples = adapter_.process(pcm::as_samples(pcm));
+    const size_t sample_count = samples.size();
+
+    if (out_buffer.size() < sample_count) {
+      return 0;
+    }
+
+    encode_ulaw(samples, out_buffer);
+    return sample_count;
+  }
+
+  uint8_t get_payload_type() const override {
+    return 0;  // PCMU
+  }
+
+  uint32_t get_timestamp_increment(size_t pcm_byte_size) const override {
+    return rtp_ticks(pcm_byte_size, adapter_.input_rate(),
+                     config::SAMPLE_RATE);
+  }
+
+  uint32_t get_clock_rate() const override { return config::SAMPLE_RATE; }
+
+  std::string_view get_name() const override { return "PCMU"; }
+
+ private:
+  RateAdapter adapter_;
+};
+
+/**
+ * @brief G.722 at 64 kbit/s.
+ *
+ * G.722 codes 16 kHz audio; sessions at another rate are converted first
+ * (2x interpolation from 8 kHz, 3x decimation from 48 kHz). Per RFC 3551 the
+ * RTP clock stays at 8 kHz, so the timestamp advances exactly as for G.711.
+ */
+struct G722CodecStrategy : ICodecStrategy {
+  explicit G722CodecStrategy(uint32_t input_rate = config::SAMPLE_RATE)
+      : adapter_(input_rate, G722Encoder::SAMPLE_RATE) {}
+
+  size_t encode(std::span<const uint8_t> pcm,
+                std::span<uint8_t> out_buffer) override;
+
+  uint8_t get_payload_type() const override {
+    return 9;  // G722
+  }
+
+  uint32_t get_timestamp_increment(size_t pcm_byte_size) const override;
+
+  uint32_t get_clock_rate() const override {
+    return 8000;  // RFC 3551 quirk
+  }
+
+  std::string_view get_name() const override { return "G722"; }
+
+ private:
+  G722Encoder encoder_;
+  RateAdapter adapter_;
+};
+
+/**
+ * @brief Creates the per-session encoder. All codec state is allocated here,
+ * once, so the per-frame path never allocates.
+ * @param input_rate Sample rate of the PCM frames the session produces.
+ */
+std::expected<std::unique_ptr<ICodecStrategy>, std::string>
+create_codec_strategy(CodecKind kind,
+                      uint32_t input_rate = config::SAMPLE_RATE);
 }  // namespace hermes::audio
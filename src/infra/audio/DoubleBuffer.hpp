@@ -6,6 +6,8 @@
 #include <span>
 #include <vector>
 
+#include "BufferPool.hpp"
+
 namespace hermes::infra {
 
 /**
@@ -47,7 +49,8 @@ struct DoubleBuffer {
   void reset();
 
  private:
-  std::array<std::vector<uint8_t>, 2> blocks_;
+  // Recycled through BufferPool rather than allocated per node.
+  std::array<PooledBlock, 2> blocks_;
 
   
   std::atomic<int> read_index_{0};
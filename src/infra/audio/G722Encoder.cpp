@@ -0,0 +1,202 @@
+#include "G722Encoder.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace hermes::audio {
+
+namespace {
+
+// NOLINTBEGIN(readability-magic-numbers, hicpp-signed-bitwise)
+
+constexpr std::array<int32_t, 32> Q6 = {
+    0,    35,   72,   110,  150,  190,  233,  276,  323,  370,  422,
+    473,  530,  587,  650,  714,  786,  858,  940,  1023, 1121, 1219,
+    1339, 1458, 1612, 1765, 1980, 2195, 2557, 2919, 0,    0};
+constexpr std::array<int32_t, 32> ILN = {
+    0,  63, 62, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19,
+    18, 17, 16, 15, 14, 13, 12, 11, 10, 9,  8,  7,  6,  5,  4,  0};
+constexpr std::array<int32_t, 32> ILP = {
+    0,  61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47,
+    46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 0};
+constexpr std::array<int32_t, 8> WL = {-60, -30, 58, 172, 334, 538, 1198, 3042};
+constexpr std::array<int32_t, 16> RL42 = {0, 7, 6, 5, 4, 3, 2, 1,
+                                          7, 6, 5, 4, 3, 2, 1, 0};
+constexpr std::array<int32_t, 32> ILB = {
+    2048, 2093, 2139, 2186, 2233, 2282, 2332, 2383, 2435, 2489, 2543,
+    2599, 2656, 2714, 2774, 2834, 2896, 2960, 3025, 3091, 3158, 3228,
+    3298, 3371, 3444, 3520, 3597, 3676, 3756, 3838, 3922, 4008};
+constexpr std::array<int32_t, 16> QM4 = {
+    0,     -20456, -12896, -8968, -6288, -4240, -2584, -1200,
+    20456, 12896,  8968,   6288,  4240,  2584,  1200,  0};
+constexpr std::array<int32_t, 4> QM2 = {-7408, -1616, 7408, 1616};
+constexpr std::array<int32_t, 12> QMF_COEFFS = {3,    -11, 12,   32,  -210, 951,
+                                                3876, -805, 362, -156, 53,  -11};
+constexpr std::array<int32_t, 3> IHN = {0, 1, 0};
+constexpr std::array<int32_t, 3> IHP = {0, 3, 2};
+constexpr std::array<int32_t, 3> WH = {0, -214, 798};
+constexpr std::array<int32_t, 4> RH2 = {2, 1, 2, 1};
+
+constexpr int32_t LOW_BAND_MAX_NB = 18432;
+constexpr int32_t HIGH_BAND_MAX_NB = 22528;
+constexpr int32_t LOW_BAND_INITIAL_DET = 32;
+constexpr int32_t HIGH_BAND_INITIAL_DET = 8;
+
+int32_t saturate(int32_t amp) {
+  return std::clamp<int32_t>(amp, std::numeric_limits<int16_t>::min(),
+                             std::numeric_limits<int16_t>::max());
+}
+
+/// SCALEL / SCALEH: log scale factor -> linear quantizer scale.
+int32_t scale(int32_t nb, int32_t shift_base) {
+  int32_t wd1 = (nb >> 6) & 31;
+  int32_t wd2 = shift_base - (nb >> 11);
+  int32_t wd3 = (wd2 < 0) ? (ILB[wd1] << -wd2) : (ILB[wd1] >> wd2);
+  return wd3 << 2;
+}
+
+}  // namespace
+
+void G722Encoder::reset() {
+  x_.fill(0);
+  band_ = {};
+  band_[0].det = LOW_BAND_INITIAL_DET;
+  band_[1].det = HIGH_BAND_INITIAL_DET;
+}
+
+/**
+ * @brief Block 4 of the standard: reconstructs the band signal and adapts the
+ * two-pole / six-zero predictor to the quantized difference `d`.
+ */
+void G722Encoder::adapt(Band& band, int32_t d) {
+  // RECONS / PARREC
+  band.d[0] = d;
+  band.r[0] = saturate(band.s + d);
+  band.p[0] = saturate(band.sz + d);
+
+  // UPPOL2
+  for (size_t i = 0; i < 3; ++i) {
+    band.sg[i] = band.p[i] >> 15;
+  }
+  int32_t wd1 = saturate(band.a[1] << 2);
+  int32_t wd2 = (band.sg[0] == band.sg[1]) ? -wd1 : wd1;
+  wd2 = std::min(wd2, 32767);
+  int32_t wd3 = (wd2 >> 7) + ((band.sg[0] == band.sg[2]) ? 128 : -128);
+  wd3 += (band.a[2] * 32512) >> 15;
+  band.ap[2] = std::clamp(wd3, -12288, 12288);
+
+  // UPPOL1
+  band.sg[0] = band.p[0] >> 15;
+  band.sg[1] = band.p[1] >> 15;
+  wd1 = (band.sg[0] == band.sg[1]) ? 192 : -192;
+  wd2 = (band.a[1] * 32640) >> 15;
+  band.ap[1] = saturate(wd1 + wd2);
+  wd3 = saturate(15360 - band.ap[2]);
+  band.ap[1] = std::clamp(band.ap[1], -wd3, wd3);
+
+  // UPZERO
+  wd1 = (d == 0) ? 0 : 128;
+  band.sg[0] = d >> 15;
+  for (size_t i = 1; i < 7; ++i) {
+    band.sg[i] = band.d[i] >> 15;
+    wd2 = (band.sg[i] == band.sg[0]) ? wd1 : -wd1;
+    wd3 = (band.b[i] * 32640) >> 15;
+    band.bp[i] = saturate(wd2 + wd3);
+  }
+
+  // DELAYA
+  for (size_t i = 6; i > 0; --i) {
+    band.d[i] = band.d[i - 1];
+    band.b[i] = band.bp[i];
+  }
+  for (size_t i = 2; i > 0; --i) {
+    band.r[i] = band.r[i - 1];
+    band.p[i] = band.p[i - 1];
+    band.a[i] = band.ap[i];
+  }
+
+  // FILTEP
+  wd1 = saturate(band.r[1] + band.r[1]);
+  wd1 = (band.a[1] * wd1) >> 15;
+  wd2 = saturate(band.r[2] + band.r[2]);
+  wd2 = (band.a[2] * wd2) >> 15;
+  band.sp = saturate(wd1 + wd2);
+
+  // FILTEZ
+  band.sz = 0;
+  for (size_t i = 6; i > 0; --i) {
+    wd1 = saturate(band.d[i] + band.d[i]);
+    band.sz += (band.b[i] * wd1) >> 15;
+  }
+  band.sz = saturate(band.sz);
+
+  // PREDIC
+  band.s = saturate(band.sp + band.sz);
+}
+
+size_t G722Encoder::encode(std::span<const int16_t> pcm,
+                           std::span<uint8_t> out) {
+  const size_t pairs = pcm.size() / 2;
+  if (out.size() < pairs) {
+    return 0;
+  }
+
+  auto& low = band_[0];
+  auto& high = band_[1];
+
+  for (size_t j = 0; j < pairs; ++j) {
+    // Transmit QMF: split the pair into one low-band and one high-band sample.
+    std::copy(x_.begin() + 2, x_.end(), x_.begin());
+    x_[QMF_TAPS - 2] = pcm[2 * j];
+    x_[QMF_TAPS - 1] = pcm[(2 * j) + 1];
+
+    int32_t sumeven = 0;
+    int32_t sumodd = 0;
+    for (size_t i = 0; i < QMF_COEFFS.size(); ++i) {
+      sumodd += x_[2 * i] * QMF_COEFFS[i];
+      sumeven += x_[(2 * i) + 1] * QMF_COEFFS[QMF_COEFFS.size() - 1 - i];
+    }
+    const int32_t xlow = (sumeven + sumodd) >> 14;
+    const int32_t xhigh = (sumeven - sumodd) >> 14;
+
+    // Low band: SUBTRA, QUANTL (6 bits)
+    int32_t el = saturate(xlow - low.s);
+    int32_t wd = (el >= 0) ? el : -(el + 1);
+    size_t i = 1;
+    for (; i < 30; ++i) {
+      if (wd < ((Q6[i] * low.det) >> 12)) {
+        break;
+      }
+    }
+    const int32_t ilow = (el < 0) ? ILN[i] : ILP[i];
+
+    // INVQAL, LOGSCL, SCALEL
+    const int32_t ril = ilow >> 2;
+    const int32_t dlow = (low.det * QM4[ril]) >> 15;
+    low.nb = std::clamp(((low.nb * 127) >> 7) + WL[RL42[ril]], 0,
+                        LOW_BAND_MAX_NB);
+    low.det = scale(low.nb, 8);
+    adapt(low, dlow);
+
+    // High band: SUBTRA, QUANTH (2 bits)
+    int32_t eh = saturate(xhigh - high.s);
+    wd = (eh >= 0) ? eh : -(eh + 1);
+    const size_t mih = (wd >= ((564 * high.det) >> 12)) ? 2 : 1;
+    const int32_t ihigh = (eh < 0) ? IHN[mih] : IHP[mih];
+
+    // INVQAH, LOGSCH, SCALEH
+    const int32_t dhigh = (high.det * QM2[ihigh]) >> 15;
+    high.nb = std::clamp(((high.nb * 127) >> 7) + WH[RH2[ihigh]], 0,
+                         HIGH_BAND_MAX_NB);
+    high.det = scale(high.nb, 10);
+    adapt(high, dhigh);
+
+    out[j] = static_cast<uint8_t>((ihigh << 6) | ilow);
+  }
+
+  return pairs;
+}
+
+// NOLINTEND(readability-magic-numbers, hicpp-signed-bitwise)
+
+}  // namespace hermes::audio
@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace hermes::audio {
+
+/**
+ * @brief ITU-T G.722 sub-band ADPCM encoder, 64 kbit/s mode.
+ *
+ * Takes 16 kHz 16-bit PCM and emits one byte per input sample pair (6 bits
+ * low band, 2 bits high band). All state lives inline in the object: create
+ * one per stream up front and encoding never allocates.
+ */
+class G722Encoder {
+ public:
+  static constexpr uint32_t SAMPLE_RATE = 16000;
+
+  G722Encoder() { reset(); }
+
+  void reset();
+
+  /**
+   * @brief Encodes `pcm` (an even number of 16 kHz samples).
+   * @return Bytes written: pcm.size() / 2, or 0 if `out` is too small.
+   */
+  size_t encode(std::span<const int16_t> pcm, std::span<uint8_t> out);
+
+ private:
+  /// ADPCM predictor/adaptation state of one sub-band.
+  struct Band {
+    int32_t s = 0;   ///< Signal estimate
+    int32_t sp = 0;  ///< Pole section output
+    int32_t sz = 0;  ///< Zero section output
+    std::array<int32_t, 3> r{};
+    std::array<int32_t, 3> a{};
+    std::array<int32_t, 3> ap{};
+    std::array<int32_t, 3> p{};
+    std::array<int32_t, 7> d{};
+    std::array<int32_t, 7> b{};
+    std::array<int32_t, 7> bp{};
+    std::array<int32_t, 7> sg{};
+    int32_t nb = 0;   ///< Log scale factor
+    int32_t det = 0;  ///< Quantizer scale factor
+  };
+
+  /// QMF history (24 taps).
+  static constexpr size_t QMF_TAPS = 24;
+
+  static void adapt(Band& band, int32_t d);
+
+  std::array<int32_t, QMF_TAPS> x_{};
+  std::array<Band, 2> band_{};
+};
+
+}  // namespace hermes::audio
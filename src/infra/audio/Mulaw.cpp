@@ -0,0 +1,74 @@
+#include <Mulaw.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace hermes::audio {
+
+// NOLINTBEGIN(hicpp-signed-bitwise)
+
+static constexpr int32_t ULAW_BIAS = 0x84;
+static constexpr int32_t ULAW_CLIP = 32635;
+static constexpr uint8_t SIGN_BIT_MASK = 0b1000'0000;
+static constexpr uint8_t QUANT_MASK = 0b0000'1111;
+static constexpr uint8_t SEGMENT_MASK = 0b0111'0000;
+static constexpr uint8_t SEGMENT_SHIFT = 4;
+// The biased magnitude always has bit 7 set; its position gives the segment.
+static constexpr int SEGMENT_BASE_BITS = 7;
+static constexpr int QUANT_SHIFT = 3;
+
+/**
+ * @brief Encodes one sample: bias the clipped magnitude, take the segment
+ * from its bit width, keep the 4 bits below the leading one, invert.
+ */
+static inline uint8_t encode_sample(int16_t pcm_sample) {
+  const int32_t pcm = pcm_sample;
+  const int32_t sign = pcm >> 31;  // 0 or -1
+  const auto sign_bit = static_cast<uint32_t>(sign & SIGN_BIT_MASK);
+
+  // |pcm| without overflowing on -32768, clipped, biased: 132..32767.
+  const int32_t magnitude = std::min((pcm ^ sign) - sign, ULAW_CLIP) + ULAW_BIAS;
+
+  const auto segment = static_cast<uint32_t>(
+      std::bit_width(static_cast<uint32_t>(magnitude) >> SEGMENT_BASE_BITS) -
+      1);
+  const auto quant = static_cast<uint32_t>(
+      (magnitude >> (segment + QUANT_SHIFT)) & QUANT_MASK);
+
+  return static_cast<uint8_t>(~(sign_bit | (segment << SEGMENT_SHIFT) | quant));
+}
+
+static inline int16_t decode_sample(uint8_t ulaw_sample) {
+  const uint8_t inverted = ~ulaw_sample;
+  const int32_t segment = (inverted & SEGMENT_MASK) >> SEGMENT_SHIFT;
+  const int32_t magnitude =
+      ((((inverted & QUANT_MASK) << QUANT_SHIFT) + ULAW_BIAS) << segment) -
+      ULAW_BIAS;
+  return static_cast<int16_t>((inverted & SIGN_BIT_MASK) != 0 ? -magnitude
+                                                              : magnitude);
+}
+
+// NOLINTEND(hicpp-signed-bitwise)
+
+void encode_ulaw(boost::span<const int16_t> pcm, boost::span<uint8_t> ulawOut) {
+  // Ensure output span is large enough
+  if (pcm.size() > ulawOut.size()) {
+    return;
+  }
+
+  for (std::size_t i = 0; i < pcm.size(); ++i) {
+    ulawOut[i] = encode_sample(pcm[i]);
+  }
+}
+
+void decode_ulaw(boost::span<const uint8_t> ulaw, boost::span<int16_t> pcmOut) {
+  // Ensure output span is large enough
+  if (ulaw.size() > pcmOut.size()) {
+    return;
+  }
+
+  for (std::size_t i = 0; i < ulaw.size(); ++i) {
+    pcmOut[i] = decode_sample(ulaw[i]);
+  }
+}
+}  // namespace hermes::audio
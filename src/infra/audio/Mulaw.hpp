@@ -0,0 +1,15 @@
+#pragma once
+#include <boost/core/span.hpp>
+#include <cstddef>
+#include <cstdint>
+namespace hermes::audio {
+/**
+ * @brief  G.711u (mu-law) encoder. Branchless, no lookup table.
+ * @param pcm Input buffer of 16-bit signed integers.
+ * @param ulawOut Output buffer. Must be at least `pcm.size()` bytes.
+ */
+void encode_ulaw(boost::span<const int16_t> pcm, boost::span<uint8_t> ulawOut);
+
+/* Decode mu-law back to PCM-16 */
+void decode_ulaw(boost::span<const uint8_t> ulaw, boost::span<int16_t> pcmOut);
+}  // namespace hermes::audio
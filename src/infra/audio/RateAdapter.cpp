@@ -0,0 +1,62 @@
+#include "RateAdapter.hpp"
+
+namespace hermes::audio {
+
+RateAdapter::RateAdapter(uint32_t input_rate, uint32_t output_rate)
+    : input_rate_(input_rate), output_rate_(output_rate) {
+  if (input_rate_ > output_rate_) {
+    decimator_.emplace(input_rate_, output_rate_, 1,
+                       config::MAX_SAMPLES_PER_FRAME,
+                       config::MAX_SAMPLES_PER_FRAME);
+  }
+}
+
+void RateAdapter::reset() {
+  last_sample_ = 0;
+  if (decimator_) {
+    decimator_->reset();
+  }
+}
+
+std::span<const int16_t> RateAdapter::process(std::span<const int16_t> in) {
+  if (input_rate_ == output_rate_) {
+    return in;
+  }
+
+  if (output_rate_ > input_rate_) {
+    const size_t ratio = output_rate_ / input_rate_;
+    const size_t count = in.size() * ratio;
+    if (count > out_.size()) {
+      return {};
+    }
+
+    // Walk from the previous frame's last sample to each new one.
+    size_t pos = 0;
+    for (int16_t sample : in) {
+      const int32_t from = last_sample_;
+      const int32_t step = sample - from;
+      for (size_t k = 1; k <= ratio; ++k) {
+        out_[pos++] = static_cast<int16_t>(
+            from + ((step * static_cast<int32_t>(k)) /
+                    static_cast<int32_t>(ratio)));
+      }
+      last_sample_ = sample;
+    }
+    return std::span(out_).first(count);
+  }
+
+  const size_t ratio = input_rate_ / output_rate_;
+  const size_t count = in.size() / ratio;
+  if (count > out_.size() || !decimator_->push(in) ||
+      !decimator_->can_produce(count)) {
+    return {};
+  }
+
+  // The filter's history starts primed with silence, so a whole frame in
+  // always yields a whole frame out (delayed by half the filter length).
+  auto out = std::span(out_).first(count);
+  decimator_->pull(out);
+  return out;
+}
+
+}  // namespace hermes::audio
@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include "Config.hpp"
+#include "Resampler.hpp"
+
+namespace hermes::audio {
+
+/**
+ * @brief Integer-ratio rate converter between the session rate and a codec's
+ * native rate (8 / 16 / 48 kHz, so the ratio is always a whole number).
+ *
+ * Upsampling interpolates linearly. Downsampling goes through the polyphase
+ * Resampler, whose low-pass keeps content above the new Nyquist from
+ * aliasing into the band (a 48 kHz session sent as G.711 loses everything
+ * above 4 kHz, rather than folding it back). Equal rates pass the input
+ * through untouched. The output lives in an inline buffer sized for the
+ * largest frame and the resampler allocates only here, so process() never
+ * allocates.
+ */
+class RateAdapter {
+ public:
+  RateAdapter(uint32_t input_rate, uint32_t output_rate);
+
+  [[nodiscard]] uint32_t input_rate() const { return input_rate_; }
+  [[nodiscard]] uint32_t output_rate() const { return output_rate_; }
+
+  /**
+   * @brief Converts one frame.
+   * @return `in` itself when the rates match, otherwise a view of the
+   * internal buffer valid until the next call. Empty if the frame is larger
+   * than one maximum-size frame at the output rate.
+   */
+  std::span<const int16_t> process(std::span<const int16_t> in);
+
+  void reset();
+
+ private:
+  uint32_t input_rate_;
+  uint32_t output_rate_;
+  int16_t last_sample_ = 0;  ///< Interpolation state across frames
+  std::optional<Resampler> decimator_;  ///< Set when downsampling
+  std::array<int16_t, config::MAX_SAMPLES_PER_FRAME> out_{};
+};
+
+}  // namespace hermes::audio
@@ -0,0 +1,234 @@
+#include "Resampler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HERMES_RESAMPLE_X86 1
+#include <immintrin.h>
+#else
+#define HERMES_RESAMPLE_X86 0
+#endif
+
+namespace hermes::audio {
+
+namespace {
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+/// Sinc zero crossings kept on each side of the centre tap, at the lower of
+/// the two rates. 8 gives > 60 dB stop-band with the Kaiser window below.
+constexpr double ZERO_CROSSINGS = 8.0;
+constexpr double KAISER_BETA = 7.0;
+/// Pass-band edge as a fraction of the lower Nyquist rate.
+constexpr double ROLLOFF = 0.92;
+constexpr size_t TAP_ALIGN = 8;  ///< One AVX2 register of floats
+
+double bessel_i0(double x) {
+  double sum = 1.0;
+  double term = 1.0;
+  const double half_sq = (x * x) / 4.0;
+  for (int k = 1; k < 32; ++k) {
+    term *= half_sq / static_cast<double>(k * k);
+    sum += term;
+  }
+  return sum;
+}
+
+double sinc(double x) {
+  if (std::abs(x) < 1e-12) {
+    return 1.0;
+  }
+  return std::sin(std::numbers::pi * x) / (std::numbers::pi * x);
+}
+
+float dot_scalar(const float* taps, const float* x, size_t count) {
+  float acc0 = 0.0F;
+  float acc1 = 0.0F;
+  size_t i = 0;
+  for (; i + 1 < count; i += 2) {
+    acc0 += taps[i] * x[i];
+    acc1 += taps[i + 1] * x[i + 1];
+  }
+  for (; i < count; ++i) {
+    acc0 += taps[i] * x[i];
+  }
+  return acc0 + acc1;
+}
+
+#if HERMES_RESAMPLE_X86
+
+__attribute__((target("avx2"))) float dot_avx2(const float* taps,
+                                               const float* x, size_t count) {
+  __m256 acc = _mm256_setzero_ps();
+  size_t i = 0;
+  for (; i + TAP_ALIGN <= count; i += TAP_ALIGN) {
+    acc = _mm256_add_ps(
+        acc, _mm256_mul_ps(_mm256_loadu_ps(taps + i), _mm256_loadu_ps(x + i)));
+  }
+  __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(acc),
+                           _mm256_extractf128_ps(acc, 1));
+  sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+  sum4 = _mm_add_ss(sum4, _mm_shuffle_ps(sum4, sum4, 1));
+  float result = _mm_cvtss_f32(sum4);
+  for (; i < count; ++i) {
+    result += taps[i] * x[i];
+  }
+  return result;
+}
+
+#endif
+
+// NOLINTEND(readability-magic-numbers)
+
+using DotFn = float (*)(const float*, const float*, size_t);
+
+struct DotKernel {
+  std::string_view isa;
+  DotFn dot;
+};
+
+DotKernel select_dot() {
+#if HERMES_RESAMPLE_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return {"AVX2", dot_avx2};
+  }
+#endif
+  return {"Scalar", dot_scalar};
+}
+
+const DotKernel kDot = select_dot();
+
+int16_t to_sample(float value) {
+  constexpr float MIN_INT16 = -32768.0F;
+  constexpr float MAX_INT16 = 32767.0F;
+  return static_cast<int16_t>(std::lrint(std::clamp(value, MIN_INT16, MAX_INT16)));
+}
+
+}  // namespace
+
+Resampler::Resampler(uint32_t input_rate, uint32_t output_rate,
+                     uint16_t channels, size_t max_output, size_t max_push)
+    : input_rate_(input_rate),
+      output_rate_(output_rate),
+      channels_(std::max<uint16_t>(channels, 1)) {
+  const uint32_t divisor = std::gcd(input_rate_, output_rate_);
+  up_ = output_rate_ / divisor;
+  down_ = input_rate_ / divisor;
+
+  if (up_ == 1 && down_ == 1) {
+    // Downmix only: a single unit tap.
+    taps_ = 1;
+    bank_.assign(1, 1.0F);
+  } else {
+    const double ratio =
+        std::max(1.0, static_cast<double>(down_) / static_cast<double>(up_));
+    const auto half = static_cast<size_t>(std::ceil(ZERO_CROSSINGS * ratio));
+    taps_ = ((2 * half) + TAP_ALIGN - 1) / TAP_ALIGN * TAP_ALIGN;
+
+    // Prototype low-pass at the upsampled rate (up_ * input_rate_), scaled by
+    // up_ to make up for the zero stuffing.
+    const size_t length = static_cast<size_t>(up_) * taps_;
+    const double centre = static_cast<double>(length - 1) / 2.0;
+    const double cutoff = ROLLOFF * 0.5 *
+                          std::min(1.0, static_cast<double>(up_) / down_) /
+                          static_cast<double>(up_);
+    const double window_norm = bessel_i0(KAISER_BETA);
+
+    bank_.resize(length);
+    for (size_t n = 0; n < length; ++n) {
+      const double offset = static_cast<double>(n) - centre;
+      const double rel = offset / (centre + 1.0);
+      const double window =
+          bessel_i0(KAISER_BETA * std::sqrt(std::max(0.0, 1.0 - (rel * rel)))) /
+          window_norm;
+      const double h = 2.0 * cutoff * sinc(2.0 * cutoff * offset) * window *
+                       static_cast<double>(up_);
+
+      // Tap k of phase p is h[k * up_ + p]; stored reversed per phase so
+      // the dot product walks the history forwards.
+      const size_t phase = n % up_;
+      const size_t k = n / up_;
+      bank_[(phase * taps_) + (taps_ - 1 - k)] = static_cast<float>(h);
+    }
+  }
+
+  const size_t max_input =
+      ((max_output * down_) + up_ - 1) / up_ + 2;  // Per pull(), rounded up
+  history_.resize(taps_ + max_input + max_push);
+  reset();
+}
+
+void Resampler::reset() {
+  // Start with taps_ - 1 samples of silence so the first output has a full
+  // window behind it.
+  std::fill(history_.begin(), history_.end(), 0.0F);
+  size_ = taps_ - 1;
+  position_ = static_cast<uint64_t>(taps_ - 1) * up_;
+}
+
+bool Resampler::can_produce(size_t count) const {
+  if (count == 0) {
+    return true;
+  }
+  const uint64_t last = position_ + (static_cast<uint64_t>(count - 1) * down_);
+  return last / up_ < size_;
+}
+
+bool Resampler::push(std::span<const int16_t> interleaved) {
+  const size_t frames = interleaved.size() / channels_;
+  if (size_ + frames > history_.size()) {
+    return false;
+  }
+
+  float* dest = history_.data() + size_;
+  if (channels_ == 1) {
+    for (size_t i = 0; i < frames; ++i) {
+      dest[i] = static_cast<float>(interleaved[i]);
+    }
+  } else {
+    const float scale = 1.0F / static_cast<float>(channels_);
+    for (size_t i = 0; i < frames; ++i) {
+      int32_t sum = 0;
+      for (size_t c = 0; c < channels_; ++c) {
+        sum += interleaved[(i * channels_) + c];
+      }
+      dest[i] = static_cast<float>(sum) * scale;
+    }
+  }
+  size_ += frames;
+  return true;
+}
+
+void Resampler::pull(std::span<int16_t> out) {
+  for (auto& sample : out) {
+    const uint64_t base = position_ / up_;
+    const auto phase = static_cast<size_t>(position_ % up_);
+    const float* window = history_.data() + (base + 1 - taps_);
+    sample = to_sample(kDot.dot(bank_.data() + (phase * taps_), window, taps_));
+    position_ += down_;
+  }
+
+  // Keep the taps_ - 1 samples the next output still looks back on.
+  const uint64_t next_base = position_ / up_;
+  const auto consumed = static_cast<size_t>(
+      std::min<uint64_t>(next_base + 1 - taps_, size_));
+  if (consumed > 0) {
+    std::copy(history_.begin() + static_cast<std::ptrdiff_t>(consumed),
+              history_.begin() + static_cast<std::ptrdiff_t>(size_),
+              history_.begin());
+    size_ -= consumed;
+    position_ -= static_cast<uint64_t>(consumed) * up_;
+  }
+}
+
+uint64_t Resampler::output_length(uint64_t input_frames) const {
+  return input_frames * up_ / down_;
+}
+
+std::string_view Resampler::active_isa() { return kDot.isa; }
+
+}  // namespace hermes::audio
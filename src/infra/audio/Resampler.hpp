@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace hermes::audio {
+
+/**
+ * @brief Streaming downmixer + polyphase resampler for source assets whose
+ * WAV format differs from the session geometry.
+ *
+ * Interleaved 16-bit input is averaged to mono on push(), then converted by
+ * a rational L/M polyphase FIR (Kaiser-windowed sinc, cut-off at the lower
+ * of the two Nyquist rates). Each phase's taps are stored contiguously and
+ * padded to a multiple of 8, so every output sample is one dense dot
+ * product; that product runs on AVX2 when the CPU has it.
+ *
+ * All memory (filter bank and input history) is allocated in the
+ * constructor; push()/pull() never allocate.
+ */
+class Resampler {
+ public:
+  /**
+   * @param input_rate Source sample rate (Hz).
+   * @param output_rate Session sample rate (Hz).
+   * @param channels Interleaved source channels (downmixed to mono).
+   * @param max_output Largest pull() request, in samples.
+   * @param max_push Largest push() request, in sample frames.
+   */
+  Resampler(uint32_t input_rate, uint32_t output_rate, uint16_t channels,
+            size_t max_output, size_t max_push);
+
+  [[nodiscard]] uint32_t input_rate() const { return input_rate_; }
+  [[nodiscard]] uint32_t output_rate() const { return output_rate_; }
+  [[nodiscard]] uint16_t channels() const { return channels_; }
+  [[nodiscard]] size_t taps_per_phase() const { return taps_; }
+
+  /**
+   * @brief Whether `count` output samples can be pulled without more input.
+   */
+  [[nodiscard]] bool can_produce(size_t count) const;
+
+  /**
+   * @brief Appends interleaved source samples (whole sample frames).
+   * @return false (nothing consumed) if it would overflow the history;
+   * pull() first.
+   */
+  bool push(std::span<const int16_t> interleaved);
+
+  /**
+   * @brief Writes out.size() samples. Call only once can_produce() is true.
+   */
+  void pull(std::span<int16_t> out);
+
+  /**
+   * @brief Drops all buffered input and filter history (rewind / loop).
+   */
+  void reset();
+
+  /**
+   * @brief Output samples produced from `input_frames` source sample frames.
+   */
+  [[nodiscard]] uint64_t output_length(uint64_t input_frames) const;
+
+  /**
+   * @brief ISA used for the filter dot product ("AVX2" or "Scalar").
+   */
+  static std::string_view active_isa();
+
+ private:
+  uint32_t input_rate_;
+  uint32_t output_rate_;
+  uint16_t channels_;
+  uint32_t up_;    ///< L: interpolation factor
+  uint32_t down_;  ///< M: decimation factor
+  size_t taps_;    ///< Taps per phase (multiple of 8)
+
+  std::vector<float> bank_;     ///< up_ phases x taps_, time-reversed
+  std::vector<float> history_;  ///< Mono input; [0, size_) is valid
+  size_t size_ = 0;
+  uint64_t position_ = 0;  ///< Next output, in upsampled input units
+};
+
+}  // namespace hermes::audio
@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <cstring>
+#include <optional>
 #include <span>
 
 #include "spdlog/spdlog.h"
@@ -44,4 +45,79 @@ inline size_t get_audio_data_offset(std::span<const uint8_t> buffer) {
 
     return DEFAULT_WAV_HEADER_SIZE;  // Fallback
 }
+
+/**
+ * @brief Sample format from a WAV "fmt " chunk.
+ */
+struct WavFormat {
+    static constexpr uint16_t FORMAT_PCM = 1;
+    static constexpr uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+    uint16_t audio_format = FORMAT_PCM;
+    uint16_t channels = 1;
+    uint32_t sample_rate = 0;
+    uint16_t block_align = 2;  ///< Bytes per sample frame (all channels)
+    uint16_t bits_per_sample = 16;
+
+    /// Highest rate we resample from; also bounds the polyphase filter bank.
+    static constexpr uint32_t MAX_SAMPLE_RATE = 384000;
+
+    /// Only 16-bit integer PCM at 1 Hz..MAX_SAMPLE_RATE is decoded; anything
+    /// else (including a zero rate, which the resampler would divide by) is
+    /// rejected.
+    [[nodiscard]] bool is_pcm16() const {
+        return (audio_format == FORMAT_PCM ||
+                audio_format == FORMAT_EXTENSIBLE) &&
+               bits_per_sample == 16 && channels > 0 &&
+               block_align == channels * sizeof(int16_t) &&
+               sample_rate > 0 && sample_rate <= MAX_SAMPLE_RATE;
+    }
+};
+
+// Reads the "fmt " chunk. std::nullopt if the buffer is not a RIFF/WAVE file
+// or the chunk is missing/truncated (headerless PCM is played as-is).
+inline std::optional<WavFormat> parse_format(std::span<const uint8_t> buffer) {
+    constexpr size_t WAV_CHUNK_OFFSET = 12;
+    constexpr size_t WAV_CHUNK_HEADER_SIZE = 8;
+    constexpr size_t FMT_MIN_SIZE = 16;
+
+    if (buffer.size() < WAV_CHUNK_OFFSET ||
+        std::memcmp(buffer.data(), "RIFF", 4) != 0 ||
+        std::memcmp(buffer.data() + 8, "WAVE", 4) != 0) {
+        return std::nullopt;
+    }
+
+    size_t pos = WAV_CHUNK_OFFSET;
+    while (pos + WAV_CHUNK_HEADER_SIZE <= buffer.size()) {
+        const uint8_t* chunk = buffer.data() + pos;
+
+        uint32_t chunk_size = 0;
+        std::memcpy(&chunk_size, chunk + 4, 4);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunk_size < FMT_MIN_SIZE ||
+                pos + WAV_CHUNK_HEADER_SIZE + FMT_MIN_SIZE > buffer.size()) {
+                return std::nullopt;
+            }
+            const uint8_t* body = chunk + WAV_CHUNK_HEADER_SIZE;
+            WavFormat format;
+            std::memcpy(&format.audio_format, body, 2);
+            std::memcpy(&format.channels, body + 2, 2);
+            std::memcpy(&format.sample_rate, body + 4, 4);
+            std::memcpy(&format.block_align, body + 12, 2);
+            std::memcpy(&format.bits_per_sample, body + 14, 2);
+            return format;
+        }
+
+        // Chunks are padded to an even size.
+        size_t next_pos =
+            pos + WAV_CHUNK_HEADER_SIZE + chunk_size + (chunk_size & 1U);
+        if (next_pos <= pos) {
+            return std::nullopt;
+        }
+        pos = next_pos;
+    }
+
+    return std::nullopt;
+}
 }
@@ -0,0 +1,157 @@
+#include "AesCtrBatch.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HERMES_AES_X86 1
+#include <immintrin.h>
+#else
+#define HERMES_AES_X86 0
+#endif
+
+namespace hermes::crypto {
+
+#if HERMES_AES_X86
+
+namespace {
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+constexpr std::size_t LANES = 8;  // Blocks in flight (covers aesenc latency)
+constexpr std::size_t BLOCK = 16;
+constexpr int ROUNDS = 10;
+
+/// One keystream block: which key, which counter, where it goes.
+struct Lane {
+  const uint8_t* round_keys;
+  __m128i counter;
+  uint8_t* data;
+  std::size_t size;  // 0 for padding lanes
+};
+
+template <int RCON>
+__attribute__((target("aes"))) __m128i expand_step(__m128i key) {
+  __m128i gen = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, RCON), 0xff);
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, gen);
+}
+
+uint64_t load_be64(const uint8_t* p) {
+  uint64_t v = 0;
+  std::memcpy(&v, p, sizeof(v));
+  return __builtin_bswap64(v);
+}
+
+__attribute__((target("aes"))) void encrypt_lanes(const Lane* lanes) {
+  __m128i b[LANES];
+  for (std::size_t i = 0; i < LANES; ++i) {
+    b[i] = _mm_xor_si128(
+        lanes[i].counter,
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes[i].round_keys)));
+  }
+  for (int r = 1; r < ROUNDS; ++r) {
+    for (std::size_t i = 0; i < LANES; ++i) {
+      b[i] = _mm_aesenc_si128(
+          b[i], _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                    lanes[i].round_keys + r * BLOCK)));
+    }
+  }
+  for (std::size_t i = 0; i < LANES; ++i) {
+    b[i] = _mm_aesenclast_si128(
+        b[i], _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                  lanes[i].round_keys + ROUNDS * BLOCK)));
+  }
+
+  for (std::size_t i = 0; i < LANES; ++i) {
+    const Lane& lane = lanes[i];
+    if (lane.size == BLOCK) {
+      auto* p = reinterpret_cast<__m128i*>(lane.data);
+      _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), b[i]));
+    } else if (lane.size != 0) {
+      // Trailing partial block: only the payload's own bytes are touched.
+      alignas(BLOCK) uint8_t keystream[BLOCK];
+      _mm_store_si128(reinterpret_cast<__m128i*>(keystream), b[i]);
+      for (std::size_t k = 0; k < lane.size; ++k) {
+        lane.data[k] ^= keystream[k];
+      }
+    }
+  }
+}
+
+// NOLINTEND(readability-magic-numbers)
+
+}  // namespace
+
+bool aes_ni_available() {
+  static const bool available = __builtin_cpu_supports("aes");
+  return available;
+}
+
+__attribute__((target("aes"))) void aes128_expand_key(
+    std::span<const uint8_t, AES128_KEY_SIZE> key,
+    Aes128RoundKeys& round_keys) {
+  auto* out = reinterpret_cast<__m128i*>(round_keys.data());
+  __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key.data()));
+  _mm_storeu_si128(out + 0, k);
+  k = expand_step<0x01>(k); _mm_storeu_si128(out + 1, k);
+  k = expand_step<0x02>(k); _mm_storeu_si128(out + 2, k);
+  k = expand_step<0x04>(k); _mm_storeu_si128(out + 3, k);
+  k = expand_step<0x08>(k); _mm_storeu_si128(out + 4, k);
+  k = expand_step<0x10>(k); _mm_storeu_si128(out + 5, k);
+  k = expand_step<0x20>(k); _mm_storeu_si128(out + 6, k);
+  k = expand_step<0x40>(k); _mm_storeu_si128(out + 7, k);
+  k = expand_step<0x80>(k); _mm_storeu_si128(out + 8, k);
+  k = expand_step<0x1b>(k); _mm_storeu_si128(out + 9, k);
+  k = expand_step<0x36>(k); _mm_storeu_si128(out + 10, k);
+}
+
+void aes128_ctr_batch(std::span<const AesCtrJob> jobs) {
+  Lane lanes[LANES];
+  std::size_t used = 0;
+
+  for (const auto& job : jobs) {
+    // Counter as two native halves; block i of the packet is counter + i.
+    uint64_t hi = load_be64(job.counter.data());
+    uint64_t lo = load_be64(job.counter.data() + 8);
+
+    for (std::size_t offset = 0; offset < job.size; offset += BLOCK) {
+      lanes[used++] = Lane{
+          job.round_keys->data(),
+          _mm_set_epi64x(static_cast<long long>(__builtin_bswap64(lo)),
+                         static_cast<long long>(__builtin_bswap64(hi))),
+          job.data + offset, std::min(BLOCK, job.size - offset)};
+      if (++lo == 0) {
+        ++hi;
+      }
+      if (used == LANES) {
+        encrypt_lanes(lanes);
+        used = 0;
+      }
+    }
+  }
+
+  if (used > 0) {
+    // Pad with copies of a real lane that write nothing.
+    for (std::size_t i = used; i < LANES; ++i) {
+      lanes[i] = lanes[0];
+      lanes[i].size = 0;
+    }
+    encrypt_lanes(lanes);
+  }
+}
+
+#else
+
+bool aes_ni_available() { return false; }
+
+void aes128_expand_key(std::span<const uint8_t, AES128_KEY_SIZE> /*key*/,
+                       Aes128RoundKeys& /*round_keys*/) {}
+
+void aes128_ctr_batch(std::span<const AesCtrJob> /*jobs*/) {}
+
+#endif  // HERMES_AES_X86
+
+}  // namespace hermes::crypto
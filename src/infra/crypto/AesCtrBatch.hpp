@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @file AesCtrBatch.hpp
+ * @brief AES-128-CTR kernel that encrypts many packets, each under its own
+ * key, in one pass (AES-NI, probed at runtime).
+ *
+ * A 160-byte payload is only ten AES blocks, so encrypting packets one by
+ * one leaves the AES unit mostly waiting on its own latency. The kernel
+ * flattens every packet of a batch into a single block stream and keeps
+ * eight independent blocks in flight, whichever session they belong to.
+ * The counter is the standard 128-bit big-endian CTR counter, so the output
+ * is identical to Crypto++'s CTR_Mode<AES>.
+ */
+namespace hermes::crypto {
+
+inline constexpr std::size_t AES128_KEY_SIZE = 16;
+inline constexpr std::size_t AES128_ROUND_KEYS_SIZE = 176;  // 11 round keys
+
+using Aes128RoundKeys = std::array<uint8_t, AES128_ROUND_KEYS_SIZE>;
+
+/** @brief One packet of a batch: encrypted in place. */
+struct AesCtrJob {
+  const Aes128RoundKeys* round_keys;
+  std::array<uint8_t, 16> counter;  ///< Initial counter block
+  uint8_t* data;
+  std::size_t size;
+};
+
+/**
+ * @brief True if this CPU has AES-NI; the other functions may only be
+ * called when it does.
+ */
+bool aes_ni_available();
+
+/** @brief Expands a 16-byte key into the AES-128 encryption schedule. */
+void aes128_expand_key(std::span<const uint8_t, AES128_KEY_SIZE> key,
+                       Aes128RoundKeys& round_keys);
+
+/** @brief XORs every job's data with its CTR keystream. */
+void aes128_ctr_batch(std::span<const AesCtrJob> jobs);
+
+}  // namespace hermes::crypto
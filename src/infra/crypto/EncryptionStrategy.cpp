@@ -2,10 +2,11 @@
 
 #include <cryptopp/aes.h>
 #include <cryptopp/modes.h>
-#include <spdlog/spdlog.h>
 
+#include <array>
 #include <cstring>
 #include <stdexcept>
+#include <vector>
 
 
 namespace hermes::crypto {
@@ -15,9 +16,23 @@ constexpr size_t AES_XOR_OFFSET = 8;
 
 class AESEncryptionStrategy : public IEncryptionStrategy {
  private:
-  CryptoPP::SecByteBlock key_;
-  CryptoPP::SecByteBlock base_iv_;
+  using Iv = std::array<uint8_t, AES_BLOCK_SIZE>;
+
+  Iv base_iv_;
   CryptoPP::CTR_Mode<CryptoPP::AES>::Encryption cipher_;
+  /// Schedule for the batch kernel; only expanded when AES-NI is present.
+  Aes128RoundKeys round_keys_{};
+  bool batchable_ = false;
+
+  /// base_iv with the packet index XORed into bytes 8..15 (little-endian).
+  Iv packet_iv(uint64_t packet_index) const {
+    Iv iv = base_iv_;
+    uint64_t tail = 0;
+    std::memcpy(&tail, iv.data() + AES_XOR_OFFSET, sizeof(uint64_t));
+    tail ^= packet_index;
+    std::memcpy(iv.data() + AES_XOR_OFFSET, &tail, sizeof(uint64_t));
+    return iv;
+  }
 
  public:
   AESEncryptionStrategy(std::span<const uint8_t> key,
@@ -26,13 +41,14 @@ class AESEncryptionStrategy : public IEncryptionStrategy {
       throw std::invalid_argument("AES-128 requires 16-byte key and IV");
     }
 
-
-
-    key_.Assign(key.data(), key.size());
-    base_iv_.Assign(base_iv.data(), base_iv.size());
-
+    std::memcpy(base_iv_.data(), base_iv.data(), base_iv_.size());
     cipher_.SetKeyWithIV(key.data(), key.size(), base_iv.data(),
                          base_iv.size());
+
+    if (aes_ni_available()) {
+      aes128_expand_key(key.first<AES128_KEY_SIZE>(), round_keys_);
+      batchable_ = true;
+    }
   }
 
   size_t encrypt(std::span<uint8_t> pcm, uint64_t packet_index) override {
@@ -40,30 +56,47 @@ class AESEncryptionStrategy : public IEncryptionStrategy {
       return 0;
     }
 
-    if (base_iv_.size() != AES_BLOCK_SIZE) {
-      spdlog::error("Encryption failed: base_iv_ is not 16 bytes!");
-      return 0;
-    }
+    // Built on the stack: no allocation per packet. Key and IV lengths were
+    // validated once at construction, so Crypto++ has nothing to throw here.
+    const Iv iv = packet_iv(packet_index);
+    cipher_.Resynchronize(iv.data(), static_cast<int>(iv.size()));
+    cipher_.ProcessData(pcm.data(), pcm.data(), pcm.size());
+
+    return pcm.size();
+  }
 
-    CryptoPP::SecByteBlock current_iv(base_iv_.data(), base_iv_.size());
+  bool prepare_ctr(std::span<uint8_t> pcm, uint64_t packet_index,
+                   AesCtrJob& job) const override {
+    if (!batchable_) {
+      return false;
+    }
+    job = AesCtrJob{&round_keys_, packet_iv(packet_index), pcm.data(),
+                    pcm.size()};
+    return true;
+  }
+};
 
-    // SAFE Little-Endian XOR using the full 48-bit SRTP index
-    uint64_t tail = 0;
-    std::memcpy(&tail, current_iv.data() + AES_XOR_OFFSET, sizeof(uint64_t));
-    tail ^= packet_index;
-    std::memcpy(current_iv.data() + AES_XOR_OFFSET, &tail, sizeof(uint64_t));
+void encrypt_batch(std::span<const EncryptionJob> jobs) {
+  // Reused across ticks: no allocation in steady state.
+  static thread_local std::vector<AesCtrJob> ctr_jobs;
+  ctr_jobs.clear();
 
-    try {
-      cipher_.Resynchronize(current_iv.data(), static_cast<int>(current_iv.size()));
-      cipher_.ProcessData(pcm.data(), pcm.data(), pcm.size());
-    } catch (const CryptoPP::Exception& e) {
-      spdlog::error("Crypto++ Exception during audio encryption: {}", e.what());
-      return 0;
+  for (const auto& job : jobs) {
+    if (job.payload.empty()) {
+      continue;
+    }
+    AesCtrJob ctr{};
+    if (job.strategy->prepare_ctr(job.payload, job.packet_index, ctr)) {
+      ctr_jobs.push_back(ctr);
+    } else {
+      job.strategy->encrypt(job.payload, job.packet_index);
     }
+  }
 
-    return pcm.size();
+  if (!ctr_jobs.empty()) {
+    aes128_ctr_batch(ctr_jobs);
   }
-};
+}
 
 // Implementation of the factory function declared in the header
 std::unique_ptr<IEncryptionStrategy> create_aes_encryption_strategy(
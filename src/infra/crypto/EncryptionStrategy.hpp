@@ -5,6 +5,8 @@
 #include <memory>
 #include <span>
 
+#include "AesCtrBatch.hpp"
+
 
 namespace hermes::crypto {
 
@@ -13,8 +15,32 @@ struct IEncryptionStrategy {
   virtual ~IEncryptionStrategy() = default;
  
   virtual size_t encrypt(std::span<uint8_t> pcm, uint64_t packet_index) = 0;
+
+  /**
+   * @brief Describes this packet's keystream so encrypt_batch() can run it
+   * through the shared AES-CTR kernel. Returns false if the strategy (or the
+   * CPU) cannot be batched; the packet then goes through encrypt().
+   */
+  virtual bool prepare_ctr(std::span<uint8_t> /*pcm*/,
+                           uint64_t /*packet_index*/,
+                           AesCtrJob& /*job*/) const {
+    return false;
+  }
 };
 
+/** @brief One payload of a cross-session encryption batch. */
+struct EncryptionJob {
+  IEncryptionStrategy* strategy;
+  std::span<uint8_t> payload;
+  uint64_t packet_index;
+};
+
+/**
+ * @brief Encrypts every job in place, in one pass. Produces exactly the same
+ * bytes as calling encrypt() on each job.
+ */
+void encrypt_batch(std::span<const EncryptionJob> jobs);
+
 
 std::unique_ptr<IEncryptionStrategy> create_aes_encryption_strategy(
     std::span<const uint8_t> key, std::span<const uint8_t> base_iv);
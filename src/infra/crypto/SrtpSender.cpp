@@ -0,0 +1,169 @@
+#include "SrtpSender.hpp"
+
+#include <cryptopp/aes.h>
+#include <cryptopp/hmac.h>
+#include <cryptopp/modes.h>
+#include <cryptopp/sha.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace hermes::crypto {
+
+namespace {
+
+constexpr std::size_t AUTH_KEY_SIZE = 20;  // n_a = 160 bits
+constexpr uint64_t INDEX_MASK = (uint64_t{1} << 48) - 1;
+
+// RFC 3711 §4.3.1 key derivation labels (SRTP)
+constexpr uint8_t LABEL_ENCRYPTION = 0x00;
+constexpr uint8_t LABEL_AUTH = 0x01;
+constexpr uint8_t LABEL_SALT = 0x02;
+constexpr std::size_t LABEL_OFFSET = 7;  // key_id is the salt's last 7 bytes
+
+/**
+ * @brief AES-CM PRF with key derivation rate 0: the keystream of
+ * AES(master_key) from IV = (master_salt ^ label << 48) << 16.
+ */
+void derive(std::span<const uint8_t> master_key,
+            std::span<const uint8_t> master_salt, uint8_t label,
+            std::span<uint8_t> out) {
+  std::array<uint8_t, 16> iv{};
+  std::copy(master_salt.begin(), master_salt.end(), iv.begin());
+  iv[LABEL_OFFSET] ^= label;
+
+  CryptoPP::CTR_Mode<CryptoPP::AES>::Encryption prf;
+  prf.SetKeyWithIV(master_key.data(), master_key.size(), iv.data(), iv.size());
+  std::fill(out.begin(), out.end(), 0);
+  prf.ProcessData(out.data(), out.data(), out.size());
+}
+
+}  // namespace
+
+struct SrtpSender::Impl {
+  CryptoPP::CTR_Mode<CryptoPP::AES>::Encryption cipher;
+  CryptoPP::HMAC<CryptoPP::SHA1> mac;
+};
+
+SrtpSender::SrtpSender(std::span<const uint8_t> master_key,
+                       std::span<const uint8_t> master_salt, uint32_t ssrc,
+                       uint64_t next_index, std::size_t max_payload)
+    : impl_(std::make_unique<Impl>()),
+      ssrc_(ssrc),
+      max_payload_(max_payload),
+      next_index_(next_index & INDEX_MASK),
+      keystream_(PREFETCH_DEPTH * max_payload) {
+  if (master_key.size() != SRTP_MASTER_KEY_SIZE ||
+      master_salt.size() != SRTP_MASTER_SALT_SIZE) {
+    throw std::invalid_argument(
+        "SRTP requires a 16-byte master key and a 14-byte master salt");
+  }
+
+  std::array<uint8_t, AES128_KEY_SIZE> session_key{};
+  std::array<uint8_t, AUTH_KEY_SIZE> auth_key{};
+  derive(master_key, master_salt, LABEL_ENCRYPTION, session_key);
+  derive(master_key, master_salt, LABEL_AUTH, auth_key);
+  derive(master_key, master_salt, LABEL_SALT, session_salt_);
+
+  // The IV is set per packet; SetKeyWithIV only needs a placeholder.
+  const Block zero_iv{};
+  impl_->cipher.SetKeyWithIV(session_key.data(), session_key.size(),
+                             zero_iv.data(), zero_iv.size());
+  impl_->mac.SetKey(auth_key.data(), auth_key.size());
+
+  if (aes_ni_available()) {
+    aes128_expand_key(session_key, round_keys_);
+    batchable_ = true;
+  }
+}
+
+SrtpSender::~SrtpSender() = default;
+
+SrtpSender::Block SrtpSender::packet_iv(uint64_t index) const {
+  // NOLINTBEGIN(readability-magic-numbers)
+  Block iv{};
+  std::copy(session_salt_.begin(), session_salt_.end(), iv.begin());
+  for (int i = 0; i < 4; ++i) {
+    iv[4 + i] ^= static_cast<uint8_t>(ssrc_ >> (24 - 8 * i));
+  }
+  for (int i = 0; i < 6; ++i) {
+    iv[8 + i] ^= static_cast<uint8_t>(index >> (40 - 8 * i));
+  }
+  // NOLINTEND(readability-magic-numbers)
+  return iv;
+}
+
+void SrtpSender::apply_keystream(uint64_t index, std::span<uint8_t> data) {
+  const Block iv = packet_iv(index);
+  if (batchable_) {
+    const AesCtrJob job{&round_keys_, iv, data.data(), data.size()};
+    aes128_ctr_batch(std::span(&job, 1));
+  } else {
+    impl_->cipher.Resynchronize(iv.data(), static_cast<int>(iv.size()));
+    impl_->cipher.ProcessData(data.data(), data.data(), data.size());
+  }
+}
+
+void SrtpSender::prefetch(std::vector<AesCtrJob>& jobs) {
+  const std::size_t size = last_payload_ != 0 ? last_payload_ : max_payload_;
+
+  for (std::size_t i = 0; i < PREFETCH_DEPTH; ++i) {
+    const uint64_t index = (next_index_ + i) & INDEX_MASK;
+    const std::size_t slot_idx = index % PREFETCH_DEPTH;
+    auto& slot = slots_[slot_idx];
+    if (slot.ready && slot.index == index && slot.size >= size) {
+      continue;
+    }
+
+    // XOR into zeros: what is left is the keystream itself.
+    slot = Slot{index, size, true};
+    auto out = slot_data(slot_idx).first(size);
+    std::fill(out.begin(), out.end(), 0);
+    if (batchable_) {
+      jobs.push_back(AesCtrJob{&round_keys_, packet_iv(index), out.data(),
+                               out.size()});
+    } else {
+      apply_keystream(index, out);
+    }
+  }
+}
+
+std::size_t SrtpSender::protect(std::span<uint8_t> packet,
+                                std::size_t header_size,
+                                std::size_t payload_size, uint64_t index) {
+  if (packet.size() < header_size + payload_size + SRTP_AUTH_TAG_SIZE ||
+      payload_size > max_payload_) {
+    return 0;
+  }
+  index &= INDEX_MASK;
+
+  auto payload = packet.subspan(header_size, payload_size);
+  const std::size_t slot_idx = index % PREFETCH_DEPTH;
+  auto& slot = slots_[slot_idx];
+  if (slot.ready && slot.index == index && slot.size >= payload_size) {
+    const uint8_t* keystream = slot_data(slot_idx).data();
+    for (std::size_t i = 0; i < payload_size; ++i) {
+      payload[i] ^= keystream[i];
+    }
+    slot.ready = false;
+  } else {
+    // Missed the prefetch: encrypt in place now.
+    apply_keystream(index, payload);
+  }
+
+  // Authenticated portion: header || encrypted payload || ROC.
+  const auto roc = static_cast<uint32_t>(index >> 16);  // NOLINT
+  const std::array<uint8_t, 4> roc_be{
+      static_cast<uint8_t>(roc >> 24), static_cast<uint8_t>(roc >> 16),  // NOLINT
+      static_cast<uint8_t>(roc >> 8), static_cast<uint8_t>(roc)};        // NOLINT
+  const std::size_t protected_size = header_size + payload_size;
+  impl_->mac.Update(packet.data(), protected_size);
+  impl_->mac.Update(roc_be.data(), roc_be.size());
+  impl_->mac.TruncatedFinal(packet.data() + protected_size, SRTP_AUTH_TAG_SIZE);
+
+  last_payload_ = payload_size;
+  next_index_ = (index + 1) & INDEX_MASK;
+  return protected_size + SRTP_AUTH_TAG_SIZE;
+}
+
+}  // namespace hermes::crypto
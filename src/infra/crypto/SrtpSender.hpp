@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "AesCtrBatch.hpp"
+
+namespace hermes::crypto {
+
+inline constexpr std::size_t SRTP_MASTER_KEY_SIZE = 16;
+inline constexpr std::size_t SRTP_MASTER_SALT_SIZE = 14;
+inline constexpr std::size_t SRTP_AUTH_TAG_SIZE = 10;  // HMAC-SHA1-80
+
+/**
+ * @brief Sender side of an RFC 3711 SRTP stream, profile
+ * AES_CM_128_HMAC_SHA1_80: what libsrtp (and Janus) expect when configured
+ * with the same master key and salt.
+ *
+ * Session keys are derived once with the AES-CM PRF (key derivation rate 0).
+ * The packet index is the sender's ROC << 16 | SEQ, as kept by
+ * RTPPacketizer; the ROC is also appended to the authenticated data.
+ *
+ * Between ticks, the egress asks every sender to prefetch() the keystream of
+ * its next packets and generates all of it in one AES-NI batch, so protect()
+ * at send time is only an XOR plus the HMAC. A packet whose keystream was not
+ * prefetched (first packet, payload grew, no AES-NI) is encrypted on demand.
+ *
+ * =========================================================================
+ * THREAD SAFETY CONTRACT
+ * =========================================================================
+ * - Not thread-safe: protect() and prefetch() run on the stream's io_context.
+ * =========================================================================
+ */
+class SrtpSender {
+ public:
+  /**
+   * @param next_index Index of the first packet that will be protected.
+   * @param max_payload Largest payload protect() will be given.
+   * @throws std::invalid_argument on a bad key or salt length.
+   */
+  SrtpSender(std::span<const uint8_t> master_key,
+             std::span<const uint8_t> master_salt, uint32_t ssrc,
+             uint64_t next_index, std::size_t max_payload);
+  ~SrtpSender();
+
+  SrtpSender(const SrtpSender&) = delete;
+  SrtpSender& operator=(const SrtpSender&) = delete;
+
+  /**
+   * @brief Encrypts the payload in place and appends the auth tag.
+   * @param packet The RTP packet, with SRTP_AUTH_TAG_SIZE spare bytes after
+   * the payload.
+   * @param header_size Bytes of RTP header (left in clear, authenticated).
+   * @param payload_size Bytes of payload right after the header.
+   * @param index The packet's SRTP index (ROC << 16 | SEQ).
+   * @return The protected packet size, or 0 if `packet` is too small.
+   */
+  std::size_t protect(std::span<uint8_t> packet, std::size_t header_size,
+                      std::size_t payload_size, uint64_t index);
+
+  /**
+   * @brief Appends a job for every upcoming packet whose keystream is not
+   * ready yet. The jobs write into this sender: run them with
+   * aes128_ctr_batch() before the next protect(). Without AES-NI the
+   * keystream is generated right away instead and no job is added.
+   */
+  void prefetch(std::vector<AesCtrJob>& jobs);
+
+ private:
+  using Block = std::array<uint8_t, 16>;
+
+  /// One upcoming packet's keystream.
+  struct Slot {
+    uint64_t index = 0;
+    std::size_t size = 0;
+    bool ready = false;
+  };
+
+  static constexpr std::size_t PREFETCH_DEPTH = 2;
+
+  /** @brief RFC 3711 §4.1.1: (salt ^ SSRC << 64 ^ index << 16). */
+  Block packet_iv(uint64_t index) const;
+
+  /** @brief XORs the keystream for `index` into `data`, right now. */
+  void apply_keystream(uint64_t index, std::span<uint8_t> data);
+
+  std::span<uint8_t> slot_data(std::size_t slot) {
+    return {keystream_.data() + slot * max_payload_, max_payload_};
+  }
+
+  struct Impl;  // Crypto++ cipher and MAC
+  std::unique_ptr<Impl> impl_;
+
+  Aes128RoundKeys round_keys_{};
+  bool batchable_ = false;
+  std::array<uint8_t, SRTP_MASTER_SALT_SIZE> session_salt_{};
+  uint32_t ssrc_;
+
+  std::size_t max_payload_;
+  std::size_t last_payload_ = 0;  // Prefetch length: payloads rarely change
+  uint64_t next_index_;
+  std::array<Slot, PREFETCH_DEPTH> slots_{};
+  std::vector<uint8_t> keystream_;  // PREFETCH_DEPTH * max_payload_
+};
+
+}  // namespace hermes::crypto
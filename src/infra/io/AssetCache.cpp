@@ -0,0 +1,105 @@
+#include "AssetCache.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace hermes::infra {
+
+void AssetCache::configure(std::size_t capacity_bytes,
+                           std::size_t max_asset_bytes) {
+  std::lock_guard lock(mutex_);
+  capacity_bytes_ = capacity_bytes;
+  max_asset_bytes_ = std::min(max_asset_bytes, capacity_bytes);
+  evict_locked();
+
+  spdlog::info("[AssetCache] Capacity {} bytes, max asset {} bytes.",
+               capacity_bytes_, max_asset_bytes_);
+}
+
+bool AssetCache::accepts(std::uintmax_t file_size) const {
+  std::lock_guard lock(mutex_);
+  return file_size > 0 && file_size <= max_asset_bytes_;
+}
+
+std::shared_ptr<const CachedAsset> AssetCache::lookup(
+    const std::string& path, std::filesystem::file_time_type mtime) {
+  std::lock_guard lock(mutex_);
+
+  auto it = entries_.find(path);
+  if (it == entries_.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  if (it->second.asset->mtime != mtime) {
+    // File was replaced on disk; sessions still holding the old copy keep it.
+    spdlog::debug("[AssetCache] Stale entry for {}, dropping.", path);
+    erase_locked(it);
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return it->second.asset;
+}
+
+std::shared_ptr<const CachedAsset> AssetCache::publish(
+    std::shared_ptr<const CachedAsset> asset) {
+  if (!asset) {
+    return asset;
+  }
+
+  std::lock_guard lock(mutex_);
+
+  auto it = entries_.find(asset->path);
+  if (it != entries_.end()) {
+    if (it->second.asset->mtime == asset->mtime) {
+      lru_.splice(lru_.begin(), lru_, it->second.lru_it);
+      return it->second.asset;
+    }
+    erase_locked(it);
+  }
+
+  if (asset->pcm.size() > max_asset_bytes_) {
+    // Still usable by the caller, just not retained.
+    return asset;
+  }
+
+  lru_.push_front(asset->path);
+  bytes_ += asset->pcm.size();
+  entries_.emplace(asset->path, Entry{asset, lru_.begin()});
+  evict_locked();
+
+  return asset;
+}
+
+void AssetCache::erase_locked(
+    std::unordered_map<std::string, Entry>::iterator it) {
+  bytes_ -= it->second.asset->pcm.size();
+  lru_.erase(it->second.lru_it);
+  entries_.erase(it);
+}
+
+void AssetCache::evict_locked() {
+  while (bytes_ > capacity_bytes_ && !lru_.empty()) {
+    auto it = entries_.find(lru_.back());
+    spdlog::debug("[AssetCache] Evicting {} ({} bytes).", it->first,
+                  it->second.asset->pcm.size());
+    erase_locked(it);
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+AssetCacheStats AssetCache::get_stats() const {
+  std::lock_guard lock(mutex_);
+  return AssetCacheStats{.hits = hits_.load(std::memory_order_relaxed),
+                         .misses = misses_.load(std::memory_order_relaxed),
+                         .evictions = evictions_.load(std::memory_order_relaxed),
+                         .entries = entries_.size(),
+                         .bytes = bytes_,
+                         .capacity_bytes = capacity_bytes_};
+}
+
+}  // namespace hermes::infra
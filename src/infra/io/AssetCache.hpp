@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <optional>
+#include <vector>
+
+#include "WavUtils.hpp"
+
+namespace hermes::infra {
+
+/**
+ * @brief Decoded PCM payload of one asset (WAV header stripped, truncated to
+ * whole sample frames). Immutable once published, so it is shared between
+ * sessions and threads without locking; each session converts and cuts it
+ * into frames of its own geometry.
+ */
+struct CachedAsset {
+  std::string path;
+  std::filesystem::file_time_type mtime;
+  std::vector<uint8_t> pcm;
+  std::optional<audio::wav::WavFormat> format;  ///< nullopt: headerless PCM
+};
+
+struct AssetCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  std::size_t entries = 0;
+  std::size_t bytes = 0;
+  std::size_t capacity_bytes = 0;
+};
+
+/**
+ * @brief Process-wide, size-bounded LRU cache of decoded assets.
+ *
+ * Keyed by file path; an entry is only served while the file's mtime still
+ * matches. Entries are handed out as shared_ptr, so eviction merely drops the
+ * cache's reference and sessions already playing the asset are unaffected.
+ *
+ * =========================================================================
+ * THREAD SAFETY CONTRACT
+ * =========================================================================
+ * - All methods may be called from any io_context thread.
+ * - The cache never does I/O itself; callers load the file and publish()
+ *   it, so the lock is only held for map/list updates.
+ * =========================================================================
+ */
+class AssetCache {
+ public:
+  static AssetCache& instance() {
+    static AssetCache instance;
+    return instance;
+  }
+
+  AssetCache(const AssetCache&) = delete;
+  AssetCache& operator=(const AssetCache&) = delete;
+
+  /**
+   * @param capacity_bytes Total PCM bytes kept resident (0 disables caching).
+   * @param max_asset_bytes Files larger than this are streamed, not cached.
+   */
+  void configure(std::size_t capacity_bytes, std::size_t max_asset_bytes);
+
+  /**
+   * @brief Whether a file of this size is eligible for caching.
+   */
+  bool accepts(std::uintmax_t file_size) const;
+
+  /**
+   * @brief Returns the cached asset if present and not stale, else nullptr.
+   */
+  std::shared_ptr<const CachedAsset> lookup(
+      const std::string& path, std::filesystem::file_time_type mtime);
+
+  /**
+   * @brief Publishes a freshly loaded asset.
+   * If another session published the same path/mtime first, that instance is
+   * returned instead so every session shares one copy.
+   */
+  std::shared_ptr<const CachedAsset> publish(
+      std::shared_ptr<const CachedAsset> asset);
+
+  AssetCacheStats get_stats() const;
+
+ private:
+  AssetCache() = default;
+
+  struct Entry {
+    std::shared_ptr<const CachedAsset> asset;
+    std::list<std::string>::iterator lru_it;
+  };
+
+  void erase_locked(std::unordered_map<std::string, Entry>::iterator it);
+  void evict_locked();
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::list<std::string> lru_;  // front = most recently used
+  std::size_t bytes_ = 0;
+  std::size_t capacity_bytes_ = 0;
+  std::size_t max_asset_bytes_ = 0;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> evictions_{0};
+};
+
+}  // namespace hermes::infra
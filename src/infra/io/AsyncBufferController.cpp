@@ -29,18 +29,20 @@ boost::asio::awaitable<void> AsyncBufferController::initialize_buffers() {
   state_ = BufferState::Ready;
 }
 
-std::expected<void, config::NodeError> AsyncBufferController::get_frame(
+config::NodeErrorCode AsyncBufferController::get_frame(
     std::span<uint8_t> output_buffer, size_t offset) {
 
+  // The caller's buffer is exactly one frame of the session geometry
+  const size_t frame_bytes = output_buffer.size();
   auto current_span = bf_.get_read_span();
-  size_t buffer_offset = (in_buffer_processed_frames_ * config::FRAME_SIZE_BYTES) + offset;
+  size_t buffer_offset = (in_buffer_processed_frames_ * frame_bytes) + offset;
 
   // Do we need to swap?
-  if (buffer_offset + config::FRAME_SIZE_BYTES > current_span.size()) {
+  if (buffer_offset + frame_bytes > current_span.size()) {
     if (!bf_.back_buffer_ready_) {
       state_ = BufferState::Underrun;
       std::fill(output_buffer.begin(), output_buffer.end(), 0);
-      return std::unexpected(config::NodeError{config::NodeErrorCode::Underrun, "Buffer underrun", ""});
+      return config::NodeErrorCode::Underrun;
     }
 
     swap_and_trigger_refill();
@@ -50,10 +52,10 @@ std::expected<void, config::NodeError> AsyncBufferController::get_frame(
 
   // Copy data to output
   auto src_it = current_span.begin() + buffer_offset;
-  std::copy(src_it, src_it + config::FRAME_SIZE_BYTES, output_buffer.begin());
+  std::copy(src_it, src_it + frame_bytes, output_buffer.begin());
 
   in_buffer_processed_frames_++;
-  return {};
+  return config::NodeErrorCode::Success;
 }
 
 void AsyncBufferController::reset() {
@@ -76,10 +78,10 @@ void AsyncBufferController::swap_and_trigger_refill() {
 
           if (bytes_read < write_span.size()) {
             std::fill(write_span.begin() + bytes_read, write_span.end(), 0);
-            if (bytes_read == 0) {
-              self->state_ = BufferState::EndOfStream;
-            }
           }
+          // A late refill (the source was waiting for data) ends an underrun.
+          self->state_ = bytes_read == 0 ? BufferState::EndOfStream
+                                         : BufferState::Ready;
           self->bf_.back_buffer_ready_ = true;
         } catch (const std::exception& e) {
           spdlog::error("Refill failed: {}", e.what());
@@ -16,7 +16,9 @@ enum class BufferState { Idle, Initializing, Ready, Underrun, Faulted, EndOfStre
 
 class AsyncBufferController : public std::enable_shared_from_this<AsyncBufferController> {
  public:
-  // Callback returns the number of bytes read
+  // Callback returns the number of bytes read; 0 means end of stream. It may
+  // suspend until data exists (a file still downloading): get_frame() then
+  // reports Underrun, never EndOfStream, until the refill lands.
   using FetchCallback = std::function<boost::asio::awaitable<size_t>(std::span<uint8_t>)>;
 
   AsyncBufferController(boost::asio::io_context& io, FetchCallback fetch_cb);
@@ -28,8 +30,10 @@ class AsyncBufferController : public std::enable_shared_from_this<AsyncBufferCon
 
   /**
    * @brief Pulls data from the double buffer, triggering a background swap if needed.
+   * @param output_buffer Exactly one frame; its size is the frame size.
+   * @return Success, or Underrun (silence written) if the refill is late.
    */
-  std::expected<void, config::NodeError> get_frame(std::span<uint8_t> output_buffer, size_t offset = 0);
+  config::NodeErrorCode get_frame(std::span<uint8_t> output_buffer, size_t offset = 0);
 
   /**
    * @brief Resets the internal buffer state and processed frames count.
@@ -0,0 +1,83 @@
+#include "DownloadProgress.hpp"
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <utility>
+
+namespace hermes::infra {
+
+void DownloadProgress::set_total(uint64_t bytes) {
+  total_.store(bytes, std::memory_order_release);
+}
+
+void DownloadProgress::advance(uint64_t bytes) {
+  std::lock_guard lock(mutex_);
+  if (bytes <= available_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  available_.store(bytes, std::memory_order_release);
+  wake_locked(bytes, false);
+}
+
+void DownloadProgress::finish(Result result) {
+  std::lock_guard lock(mutex_);
+  result_ = std::move(result);
+  done_.store(true, std::memory_order_release);
+  wake_locked(available_.load(std::memory_order_relaxed), true);
+}
+
+std::optional<uint64_t> DownloadProgress::total() const {
+  auto total = total_.load(std::memory_order_acquire);
+  if (total == UNKNOWN_TOTAL) {
+    return std::nullopt;
+  }
+  return total;
+}
+
+DownloadProgress::Result DownloadProgress::result() const {
+  std::lock_guard lock(mutex_);
+  return result_.value_or(Result{});
+}
+
+void DownloadProgress::wake_locked(uint64_t available, bool all) {
+  // Timers belong to the waiters' io_contexts: wake them from there. Moving
+  // the expiry (rather than cancel()) also releases a waiter that has not
+  // started waiting yet.
+  std::erase_if(waiters_, [&](const Waiter& waiter) {
+    if (!all && waiter.bytes > available) {
+      return false;
+    }
+    boost::asio::post(waiter.timer->get_executor(), [timer = waiter.timer] {
+      timer->expires_at(boost::asio::steady_timer::time_point::min());
+    });
+    return true;
+  });
+}
+
+boost::asio::awaitable<void> DownloadProgress::wait_for(uint64_t bytes) {
+  auto executor = co_await boost::asio::this_coro::executor;
+  for (;;) {
+    auto wake = std::make_shared<boost::asio::steady_timer>(
+        executor, boost::asio::steady_timer::time_point::max());
+    {
+      // Registered under the lock, so finish()/advance() cannot miss it.
+      std::lock_guard lock(mutex_);
+      if (done() || available() >= bytes) {
+        co_return;
+      }
+      waiters_.push_back({bytes, wake});
+    }
+    boost::system::error_code ec;  // operation_aborted when woken early
+    co_await wake->async_wait(
+        boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+  }
+}
+
+boost::asio::awaitable<DownloadProgress::Result> DownloadProgress::wait_done() {
+  co_await wait_for(UINT64_MAX);
+  co_return result();
+}
+
+}  // namespace hermes::infra
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "Types.hpp"
+
+namespace hermes::infra {
+
+/**
+ * @brief Shared state of one asset download: how many bytes from the start
+ * of the file are already on disk, the object size once known, and the
+ * final result.
+ *
+ * Readers of a file that is still downloading (progressive playback) must
+ * not read past available(); wait_for() suspends until they may.
+ *
+ * =========================================================================
+ * THREAD SAFETY CONTRACT
+ * =========================================================================
+ * - The downloader publishes from its own io_context; readers may await on
+ *   any io_context and are woken on their own executor.
+ * - available() / total() / done() are lock-free and safe per frame.
+ * =========================================================================
+ */
+class DownloadProgress {
+ public:
+  using Result = std::expected<void, config::ErrorInfo>;
+
+  /** @brief Object size, as soon as the first response reveals it. */
+  void set_total(uint64_t bytes);
+
+  /** @brief Bytes [0, bytes) are written; never moves backwards. */
+  void advance(uint64_t bytes);
+
+  /** @brief Publishes the final result and wakes every waiter. */
+  void finish(Result result);
+
+  uint64_t available() const {
+    return available_.load(std::memory_order_acquire);
+  }
+  std::optional<uint64_t> total() const;
+  bool done() const { return done_.load(std::memory_order_acquire); }
+
+  /** @brief The final result; only meaningful once done(). */
+  Result result() const;
+
+  /**
+   * @brief Suspends until `bytes` are available or the download ended.
+   */
+  boost::asio::awaitable<void> wait_for(uint64_t bytes);
+
+  /** @brief Suspends until the download ended and returns its result. */
+  boost::asio::awaitable<Result> wait_done();
+
+ private:
+  struct Waiter {
+    uint64_t bytes;
+    std::shared_ptr<boost::asio::steady_timer> timer;
+  };
+
+  static constexpr uint64_t UNKNOWN_TOTAL = UINT64_MAX;
+
+  /** @brief Wakes waiters satisfied by `available`; caller holds mutex_. */
+  void wake_locked(uint64_t available, bool all);
+
+  mutable std::mutex mutex_;
+  std::vector<Waiter> waiters_;
+  std::optional<Result> result_;
+
+  std::atomic<uint64_t> available_{0};
+  std::atomic<uint64_t> total_{UNKNOWN_TOTAL};
+  std::atomic<bool> done_{false};
+};
+
+}  // namespace hermes::infra
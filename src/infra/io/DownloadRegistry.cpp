@@ -0,0 +1,93 @@
+#include "DownloadRegistry.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <exception>
+
+namespace hermes::infra {
+
+std::shared_ptr<DownloadProgress> DownloadRegistry::start(
+    const boost::asio::any_io_executor& executor, const std::string& key,
+    const std::filesystem::path& destination, Downloader download) {
+  std::shared_ptr<DownloadProgress> progress;
+  {
+    std::lock_guard lock(mutex_);
+    if (auto it = flights_.find(key); it != flights_.end()) {
+      ++it->second.joined;
+      waits_.fetch_add(1, std::memory_order_relaxed);
+      spdlog::debug("[Download] {} already in flight, joining.", key);
+      return it->second.progress;
+    }
+    if (std::error_code ec; std::filesystem::exists(destination, ec)) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    progress = std::make_shared<DownloadProgress>();
+    flights_.emplace(key, Flight{progress});
+  }
+
+  started_.fetch_add(1, std::memory_order_relaxed);
+  boost::asio::co_spawn(
+      executor, run(key, destination, std::move(download), progress),
+      boost::asio::detached);
+  return progress;
+}
+
+boost::asio::awaitable<DownloadRegistry::Result> DownloadRegistry::ensure(
+    const std::string& key, const std::filesystem::path& destination,
+    Downloader download) {
+  auto executor = co_await boost::asio::this_coro::executor;
+  auto progress = start(executor, key, destination, std::move(download));
+  if (!progress) {
+    co_return Result{};
+  }
+  co_return co_await progress->wait_done();
+}
+
+boost::asio::awaitable<void> DownloadRegistry::run(
+    std::string key, std::filesystem::path destination, Downloader download,
+    std::shared_ptr<DownloadProgress> progress) {
+  Result result;
+  try {
+    result = co_await download(progress);
+  } catch (const std::exception& e) {
+    result = std::unexpected(
+        config::ErrorInfo::From(config::AppError::NetworkError, e.what()));
+  }
+
+  uint64_t joined = 0;
+  {
+    std::lock_guard lock(mutex_);
+    joined = flights_[key].joined;
+    flights_.erase(key);
+  }
+
+  if (!result) {
+    failed_.fetch_add(1, std::memory_order_relaxed);
+  } else if (joined > 0) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(destination, ec);
+    if (!ec) {
+      bytes_saved_.fetch_add(joined * size, std::memory_order_relaxed);
+    }
+  }
+
+  // After the flight is retired: a request woken by this may find the file
+  // on disk, but never a finished flight to join.
+  progress->finish(std::move(result));
+}
+
+DownloadStats DownloadRegistry::get_stats() const {
+  std::lock_guard lock(mutex_);
+  return {started_.load(std::memory_order_relaxed),
+          failed_.load(std::memory_order_relaxed),
+          hits_.load(std::memory_order_relaxed),
+          waits_.load(std::memory_order_relaxed),
+          bytes_saved_.load(std::memory_order_relaxed),
+          flights_.size()};
+}
+
+}  // namespace hermes::infra
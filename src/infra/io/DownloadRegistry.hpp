@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "DownloadProgress.hpp"
+#include "Types.hpp"
+
+namespace hermes::infra {
+
+struct DownloadStats {
+  uint64_t started = 0;    ///< Transfers actually issued
+  uint64_t failed = 0;
+  uint64_t hits = 0;       ///< File already on disk, nothing to fetch
+  uint64_t waits = 0;      ///< Requests that joined an in-flight transfer
+  uint64_t bytes_saved = 0;  ///< Bytes joined requests did not download
+  std::size_t in_flight = 0;
+};
+
+/**
+ * @brief Process-wide single-flight registry for asset downloads.
+ *
+ * The first session asking for a missing object starts the download; every
+ * concurrent request for the same object key joins that transfer instead of
+ * issuing its own GET and writing the same path. All of them share one
+ * DownloadProgress, so a session may start playing the file before it is
+ * complete (see start()). The downloader is expected to write to
+ * "<destination>.part" and rename it into place (see FileSink), so
+ * `destination` existing means the file is complete.
+ *
+ * =========================================================================
+ * THREAD SAFETY CONTRACT
+ * =========================================================================
+ * - start() / ensure() may be called from any io_context; the transfer runs
+ *   on the executor of the request that started it.
+ * - The lock is only held for map updates, never across a download.
+ * =========================================================================
+ */
+class DownloadRegistry {
+ public:
+  using Result = DownloadProgress::Result;
+  using Downloader = std::function<boost::asio::awaitable<Result>(
+      std::shared_ptr<DownloadProgress>)>;
+
+  static DownloadRegistry& instance() {
+    static DownloadRegistry instance;
+    return instance;
+  }
+
+  DownloadRegistry(const DownloadRegistry&) = delete;
+  DownloadRegistry& operator=(const DownloadRegistry&) = delete;
+
+  /**
+   * @brief Starts the transfer of `key`, or joins the one in flight, and
+   * returns without waiting for it.
+   * @param executor Runs the transfer if this call starts it.
+   * @param download Performs the transfer, publishing into the progress it
+   * is given; only called by the first requester.
+   * @return The transfer's progress, or nullptr if `destination` is already
+   * on disk.
+   */
+  std::shared_ptr<DownloadProgress> start(
+      const boost::asio::any_io_executor& executor, const std::string& key,
+      const std::filesystem::path& destination, Downloader download);
+
+  /**
+   * @brief Makes sure `destination` exists, running `download` at most once
+   * per `key` at a time.
+   */
+  boost::asio::awaitable<Result> ensure(const std::string& key,
+                                        const std::filesystem::path& destination,
+                                        Downloader download);
+
+  DownloadStats get_stats() const;
+
+ private:
+  DownloadRegistry() = default;
+
+  /// One transfer in progress and how many requests joined it.
+  struct Flight {
+    std::shared_ptr<DownloadProgress> progress;
+    uint64_t joined = 0;
+  };
+
+  /**
+   * @brief Runs the leader's transfer and retires its flight.
+   */
+  boost::asio::awaitable<void> run(std::string key,
+                                   std::filesystem::path destination,
+                                   Downloader download,
+                                   std::shared_ptr<DownloadProgress> progress);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Flight> flights_;
+
+  std::atomic<uint64_t> started_{0};
+  std::atomic<uint64_t> failed_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> waits_{0};
+  std::atomic<uint64_t> bytes_saved_{0};
+};
+
+}  // namespace hermes::infra
@@ -8,6 +8,11 @@
 
 namespace hermes::infra {
 
+/**
+ * @brief AsyncWriteStream onto a file that only appears once complete.
+ * Bytes go to "<path>.part"; Commit() renames it over `path`, and an
+ * uncommitted sink deletes its partial file.
+ */
 class FileSink {
  public:
   explicit FileSink(boost::asio::io_context& ioc) : file_(ioc) {}
@@ -31,8 +36,11 @@ class FileSink {
       if (ec) return std::unexpected("Dir error: " + ec.message());
     }
 
-    
-    file_.open(path.string(),
+    path_ = path;
+    part_path_ = path;
+    part_path_ += ".part";
+
+    file_.open(part_path_.string(),
                boost::asio::stream_file::write_only |
                    boost::asio::stream_file::create |
                    boost::asio::stream_file::truncate,
@@ -40,15 +48,27 @@ class FileSink {
 
     if (ec) return std::unexpected("File open error: " + ec.message());
 
-    guard_ = std::make_unique<PartialFileGuard>(path);
+    guard_ = std::make_unique<PartialFileGuard>(part_path_);
 
     return {};
   }
 
-  void Commit() {
+  /**
+   * @brief Closes the file and atomically publishes it under its final name.
+   */
+  std::expected<void, std::string> Commit() {
+    boost::system::error_code ec;
+    file_.close(ec);
+    if (ec) return std::unexpected("File close error: " + ec.message());
+
+    std::error_code rename_ec;
+    std::filesystem::rename(part_path_, path_, rename_ec);
+    if (rename_ec) return std::unexpected("Rename error: " + rename_ec.message());
+
     if (guard_) {
       guard_->disarm();
     }
+    return {};
   }
 
   using executor_type = boost::asio::stream_file::executor_type;
@@ -64,6 +84,8 @@ class FileSink {
 
  private:
   boost::asio::stream_file file_;
+  std::filesystem::path path_;
+  std::filesystem::path part_path_;
   std::unique_ptr<PartialFileGuard> guard_;
 };
 
@@ -0,0 +1,173 @@
+#include "FrameClock.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#include "Types.hpp"
+
+using namespace hermes::config;
+
+namespace hermes::infra {
+
+namespace {
+uint64_t to_us(std::chrono::steady_clock::duration d) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+}
+
+void store_max(std::atomic<uint64_t>& target, uint64_t value) {
+  uint64_t prev = target.load(std::memory_order_relaxed);
+  while (prev < value && !target.compare_exchange_weak(
+                             prev, value, std::memory_order_relaxed)) {
+  }
+}
+}  // namespace
+
+FrameClock::FrameClock(boost::asio::io_context& io, std::size_t index)
+    : io_(io), timer_(io), index_(index) {}
+
+void FrameClock::subscribe(std::shared_ptr<ITickSubscriber> subscriber) {
+  if (!subscriber) {
+    return;
+  }
+
+  subscribers_.push_back(std::move(subscriber));
+  subscriber_count_.fetch_add(1, std::memory_order_relaxed);
+
+  if (!running_) {
+    running_ = true;
+    next_tick_ = std::chrono::steady_clock::now();
+    schedule_next();
+    spdlog::debug("[FrameClock {}] Started.", index_);
+  }
+}
+
+void FrameClock::unsubscribe(const ITickSubscriber* subscriber) {
+  auto it = std::find_if(
+      subscribers_.begin(), subscribers_.end(),
+      [subscriber](const auto& sub) { return sub.get() == subscriber; });
+
+  if (it == subscribers_.end()) {
+    return;
+  }
+
+  subscriber_count_.fetch_sub(1, std::memory_order_relaxed);
+
+  if (dispatching_) {
+    // Iteration in progress; erase after the batch completes. The reference is
+    // parked so a subscriber unsubscribing itself is not destroyed mid-call.
+    retired_.push_back(std::move(*it));
+    needs_compaction_ = true;
+    return;
+  }
+
+  subscribers_.erase(it);
+}
+
+void FrameClock::schedule_next() {
+  next_tick_ += AUDIO_TICK_INTERVAL;
+
+  // If we fell far behind (debugger, suspended VM, overloaded core), do not
+  // burst dozens of frames to catch up; resync to now instead.
+  auto now = std::chrono::steady_clock::now();
+  if (now - next_tick_ > AUDIO_TICK_INTERVAL * FRAME_CLOCK_MAX_CATCHUP_TICKS) {
+    auto behind = (now - next_tick_) / AUDIO_TICK_INTERVAL;
+    skipped_ticks_.fetch_add(static_cast<uint64_t>(behind),
+                             std::memory_order_relaxed);
+    next_tick_ += AUDIO_TICK_INTERVAL * behind;
+  }
+
+  timer_.expires_at(next_tick_);
+  timer_.async_wait(
+      [this](const boost::system::error_code& ec) { on_timer(ec); });
+}
+
+void FrameClock::on_timer(const boost::system::error_code& ec) {
+  if (ec == boost::asio::error::operation_aborted) {
+    running_ = false;
+    return;
+  }
+
+  auto scheduled_tick = next_tick_;
+  record_lateness(std::chrono::steady_clock::now() - scheduled_tick);
+
+  dispatch_tick(scheduled_tick);
+
+  if (subscribers_.empty()) {
+    running_ = false;
+    spdlog::debug("[FrameClock {}] Idle, stopping.", index_);
+    return;
+  }
+
+  schedule_next();
+}
+
+void FrameClock::dispatch_tick(
+    std::chrono::steady_clock::time_point scheduled_tick) {
+  auto batch_start = std::chrono::steady_clock::now();
+
+  dispatching_ = true;
+  // Index-based: subscribers may unsubscribe (null their slot) mid-batch.
+  for (std::size_t i = 0; i < subscribers_.size(); ++i) {
+    if (auto& sub = subscribers_[i]) {
+      sub->on_tick(scheduled_tick);
+    }
+  }
+  dispatching_ = false;
+
+  // Before compaction: sessions retired this tick may still own queued data.
+  if (batch_complete_) {
+    batch_complete_();
+  }
+
+  if (needs_compaction_) {
+    compact_subscribers();
+  }
+
+  auto batch_us = to_us(std::chrono::steady_clock::now() - batch_start);
+  last_batch_us_.store(batch_us, std::memory_order_relaxed);
+  store_max(max_batch_us_, batch_us);
+  ticks_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameClock::record_lateness(std::chrono::steady_clock::duration lateness) {
+  if (lateness < std::chrono::steady_clock::duration::zero()) {
+    lateness = std::chrono::steady_clock::duration::zero();
+  }
+
+  auto lateness_us = to_us(lateness);
+  last_lateness_us_.store(lateness_us, std::memory_order_relaxed);
+  store_max(max_lateness_us_, lateness_us);
+
+  if (lateness > FRAME_CLOCK_LATE_THRESHOLD) {
+    auto late = late_ticks_.fetch_add(1, std::memory_order_relaxed);
+    // Rate-limited so an overloaded core does not also drown in logging.
+    if (late % FRAME_CLOCK_LATE_LOG_EVERY == 0) {
+      spdlog::warn(
+          "[FrameClock {}] Tick late by {} us ({} subscribers, {} late ticks)",
+          index_, lateness_us, subscribers_.size(), late + 1);
+    }
+  }
+}
+
+void FrameClock::compact_subscribers() {
+  std::erase(subscribers_, nullptr);
+  retired_.clear();
+  needs_compaction_ = false;
+}
+
+FrameClockStats FrameClock::get_stats() const {
+  return FrameClockStats{
+      .index = index_,
+      .subscribers = subscriber_count_.load(std::memory_order_relaxed),
+      .ticks = ticks_.load(std::memory_order_relaxed),
+      .late_ticks = late_ticks_.load(std::memory_order_relaxed),
+      .skipped_ticks = skipped_ticks_.load(std::memory_order_relaxed),
+      .last_lateness_us = last_lateness_us_.load(std::memory_order_relaxed),
+      .max_lateness_us = max_lateness_us_.load(std::memory_order_relaxed),
+      .last_batch_us = last_batch_us_.load(std::memory_order_relaxed),
+      .max_batch_us = max_batch_us_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace hermes::infra
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace hermes::infra {
+
+/**
+ * @brief Receives batched ticks from a FrameClock.
+ * Called on the clock's io_context thread (must be non-blocking).
+ */
+struct ITickSubscriber {
+  virtual ~ITickSubscriber() = default;
+
+  /**
+   * @param scheduled_tick The time point this tick was due at (not the time it
+   * actually fired).
+   */
+  virtual void on_tick(std::chrono::steady_clock::time_point scheduled_tick) = 0;
+};
+
+/**
+ * @brief Snapshot of a FrameClock's scheduling health.
+ * Lateness is the delay between the scheduled tick and the moment the timer
+ * handler actually ran; batch time is how long all subscribers took.
+ */
+struct FrameClockStats {
+  std::size_t index = 0;
+  std::size_t subscribers = 0;
+  uint64_t ticks = 0;
+  uint64_t late_ticks = 0;
+  uint64_t skipped_ticks = 0;
+  uint64_t last_lateness_us = 0;
+  uint64_t max_lateness_us = 0;
+  uint64_t last_batch_us = 0;
+  uint64_t max_batch_us = 0;
+};
+
+/**
+ * @brief Per-io_context "frame clock".
+ *
+ * Owns a single steady_timer that fires every config::AUDIO_TICK_INTERVAL and
+ * drives every subscriber pinned to the same io_context in one batch, instead
+ * of each Session waking up on its own timer.
+ *
+ * =========================================================================
+ * THREAD SAFETY CONTRACT
+ * =========================================================================
+ * - subscribe() / unsubscribe() MUST be called on the clock's io_context
+ *   thread (unsubscribe() may be called from inside on_tick()).
+ * - get_stats() may be called from any thread.
+ * =========================================================================
+ */
+class FrameClock {
+ public:
+  FrameClock(boost::asio::io_context& io, std::size_t index);
+
+  FrameClock(const FrameClock&) = delete;
+  FrameClock& operator=(const FrameClock&) = delete;
+
+  /**
+   * @brief Adds a subscriber. The clock keeps it alive until unsubscribed.
+   * Starts the timer if this is the first subscriber.
+   */
+  void subscribe(std::shared_ptr<ITickSubscriber> subscriber);
+
+  /**
+   * @brief Removes a subscriber. Safe to call from within on_tick().
+   * The timer stops on its own once no subscribers remain.
+   */
+  void unsubscribe(const ITickSubscriber* subscriber);
+
+  /**
+   * @brief Runs after every subscriber has handled a tick (e.g. to flush the
+   * io_context's batched UDP egress). Set once, before the first subscribe().
+   */
+  void set_batch_complete_handler(std::function<void()> handler) {
+    batch_complete_ = std::move(handler);
+  }
+
+  boost::asio::io_context& get_io_context() { return io_; }
+
+  FrameClockStats get_stats() const;
+
+ private:
+  void schedule_next();
+  void on_timer(const boost::system::error_code& ec);
+  void dispatch_tick(std::chrono::steady_clock::time_point scheduled_tick);
+  void record_lateness(std::chrono::steady_clock::duration lateness);
+  void compact_subscribers();
+
+  boost::asio::io_context& io_;
+  boost::asio::steady_timer timer_;
+  std::size_t index_;
+
+  std::vector<std::shared_ptr<ITickSubscriber>> subscribers_;
+  std::vector<std::shared_ptr<ITickSubscriber>> retired_;
+  std::function<void()> batch_complete_;
+  std::chrono::steady_clock::time_point next_tick_;
+  bool running_ = false;
+  bool dispatching_ = false;
+  bool needs_compaction_ = false;
+
+  std::atomic<std::size_t> subscriber_count_{0};
+  std::atomic<uint64_t> ticks_{0};
+  std::atomic<uint64_t> late_ticks_{0};
+  std::atomic<uint64_t> skipped_ticks_{0};
+  std::atomic<uint64_t> last_lateness_us_{0};
+  std::atomic<uint64_t> max_lateness_us_{0};
+  std::atomic<uint64_t> last_batch_us_{0};
+  std::atomic<uint64_t> max_batch_us_{0};
+};
+
+}  // namespace hermes::infra
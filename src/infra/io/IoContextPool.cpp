@@ -14,14 +14,14 @@
 using namespace hermes::config;
 namespace hermes::infra {
 std::expected<std::shared_ptr<IoContextPool>, ErrorInfo> IoContextPool::create(
-    std::size_t pool_size) {
+    std::size_t pool_size, const EgressConfig& egress_cfg) {
   if (pool_size == 0) {
     return std::unexpected(ErrorInfo::From(AppError::ConfigError,
                                            "IoContextPool size must be > 0"));
   }
 
   try {
-    return std::shared_ptr<IoContextPool>(new IoContextPool(pool_size));
+    return std::shared_ptr<IoContextPool>(new IoContextPool(pool_size, egress_cfg));
   } catch (const std::exception& e) {
     return std::unexpected(ErrorInfo::From(
         AppError::Critical,
@@ -29,10 +29,21 @@ std::expected<std::shared_ptr<IoContextPool>, ErrorInfo> IoContextPool::create(
   }
 }
 
-IoContextPool::IoContextPool(std::size_t pool_size) {
+IoContextPool::IoContextPool(std::size_t pool_size,
+                             const EgressConfig& egress_cfg) {
   for (std::size_t i = 0; i < pool_size; ++i) {
     auto ioc = std::make_shared<asio::io_context>();
     io_contexts_.push_back(ioc);
+
+    udp_egresses_.push_back(std::make_unique<UdpEgress>(*ioc, i, egress_cfg));
+    frame_clocks_.push_back(std::make_unique<FrameClock>(*ioc, i));
+    // One sendmmsg batch per tick, after every session produced its frame.
+    frame_clocks_.back()->set_batch_complete_handler(
+        [egress = udp_egresses_.back().get()] {
+          egress->flush();
+          egress->prefetch_keystreams();
+        });
+
     work_guards_.emplace_back(asio::make_work_guard(*ioc));
   }
 }
@@ -80,4 +91,41 @@ asio::io_context& IoContextPool::get_io_context() {
 
   return *ptr;
 }
+
+std::size_t IoContextPool::index_of(const asio::io_context& io) const {
+  for (std::size_t i = 0; i < io_contexts_.size(); ++i) {
+    if (io_contexts_[i].get() == &io) {
+      return i;
+    }
+  }
+
+  spdlog::critical("io_context does not belong to this pool");
+  throw std::runtime_error("foreign io_context passed to IoContextPool");
+}
+
+FrameClock& IoContextPool::get_frame_clock(const asio::io_context& io) {
+  return *frame_clocks_[index_of(io)];
+}
+
+UdpEgress& IoContextPool::get_udp_egress(const asio::io_context& io) {
+  return *udp_egresses_[index_of(io)];
+}
+
+std::vector<FrameClockStats> IoContextPool::get_frame_clock_stats() const {
+  std::vector<FrameClockStats> stats;
+  stats.reserve(frame_clocks_.size());
+  for (const auto& clock : frame_clocks_) {
+    stats.push_back(clock->get_stats());
+  }
+  return stats;
+}
+
+std::vector<UdpEgressStats> IoContextPool::get_udp_egress_stats() const {
+  std::vector<UdpEgressStats> stats;
+  stats.reserve(udp_egresses_.size());
+  for (const auto& egress : udp_egresses_) {
+    stats.push_back(egress->get_stats());
+  }
+  return stats;
+}
 }  // namespace hermes::infra
@@ -10,7 +10,10 @@
 #include <thread>
 #include <vector>
 
+#include "Config.hpp"
+#include "FrameClock.hpp"
 #include "Types.hpp"
+#include "UdpEgress.hpp"
 
 
 namespace hermes::infra {
@@ -22,7 +25,7 @@ namespace hermes::infra {
 class IoContextPool {
  public:
   static std::expected<std::shared_ptr<IoContextPool>, config::ErrorInfo> create(
-      std::size_t pool_size);
+      std::size_t pool_size, const config::EgressConfig& egress_cfg = {});
 
   // Destructor. Stops and joins all threads.
   ~IoContextPool();
@@ -39,9 +42,27 @@ class IoContextPool {
   //@brief Get an io_context from the pool in a round-robin fashion.
   boost::asio::io_context& get_io_context();
 
+  //@brief Get the FrameClock pinned to one of the pool's io_contexts.
+  FrameClock& get_frame_clock(const boost::asio::io_context& io);
+
+  //@brief Snapshot of every FrameClock's tick lateness (for /metrics).
+  std::vector<FrameClockStats> get_frame_clock_stats() const;
+
+  //@brief Get the UDP egress engine pinned to one of the pool's io_contexts.
+  UdpEgress& get_udp_egress(const boost::asio::io_context& io);
+
+  //@brief Snapshot of every UdpEgress's batching counters (for /metrics).
+  std::vector<UdpEgressStats> get_udp_egress_stats() const;
+
  private:
-  explicit IoContextPool(std::size_t pool_size);
+  IoContextPool(std::size_t pool_size, const config::EgressConfig& egress_cfg);
+  std::size_t index_of(const boost::asio::io_context& io) const;
+
   std::vector<std::shared_ptr<boost::asio::io_context>> io_contexts_;
+  // Declared after io_contexts_ so sockets/timers die first; the clocks flush
+  // the egress engines, so they go before them.
+  std::vector<std::unique_ptr<UdpEgress>> udp_egresses_;
+  std::vector<std::unique_ptr<FrameClock>> frame_clocks_;
 
   using work_guard_type =
       boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
@@ -0,0 +1,83 @@
+#include "MappedFile.hpp"
+
+#include <algorithm>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HERMES_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#else
+#define HERMES_HAS_MMAP 0
+#endif
+
+namespace hermes::infra {
+
+#if HERMES_HAS_MMAP
+
+std::expected<std::unique_ptr<MappedFile>, std::string> MappedFile::open(
+    const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT
+  if (fd < 0) {
+    return std::unexpected("open failed: " + std::string(std::strerror(errno)));
+  }
+
+  struct stat st{};
+  if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return std::unexpected(std::string("empty or unreadable file"));
+  }
+
+  auto size = static_cast<std::size_t>(st.st_size);
+  void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file.
+  ::close(fd);
+
+  if (addr == MAP_FAILED) {  // NOLINT(performance-no-int-to-ptr)
+    return std::unexpected("mmap failed: " + std::string(std::strerror(errno)));
+  }
+
+  // Playback is strictly front-to-back: aggressive read-ahead, early reclaim.
+  ::madvise(addr, size, MADV_SEQUENTIAL);
+
+  return std::unique_ptr<MappedFile>(
+      new MappedFile(static_cast<const uint8_t*>(addr), size));
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<uint8_t*>(data_), size_);  // NOLINT
+  }
+}
+
+void MappedFile::prefetch(std::size_t offset, std::size_t length) const {
+  if (offset >= size_) {
+    return;
+  }
+  // madvise needs a page-aligned start address.
+  static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+  std::size_t aligned = offset - (offset % page);
+  std::size_t end = std::min(size_, offset + length);
+
+  ::madvise(const_cast<uint8_t*>(data_) + aligned,  // NOLINT
+            end - aligned, MADV_WILLNEED);
+}
+
+#else
+
+std::expected<std::unique_ptr<MappedFile>, std::string> MappedFile::open(
+    const std::string&) {
+  return std::unexpected(std::string("mmap not supported on this platform"));
+}
+
+MappedFile::~MappedFile() = default;
+
+void MappedFile::prefetch(std::size_t, std::size_t) const {}
+
+#endif
+
+}  // namespace hermes::infra
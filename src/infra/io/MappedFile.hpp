@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace hermes::infra {
+
+/**
+ * @brief Read-only memory mapping of a whole file (POSIX mmap).
+ *
+ * Pages are faulted in by the kernel from the shared page cache, so N sessions
+ * playing the same large file share one copy and no user-space buffers.
+ * The file must not be truncated while mapped (SIGBUS); assets in downloads/
+ * are only ever written once, before first playback.
+ *
+ * On platforms without mmap, open() always fails and callers fall back to
+ * streaming.
+ */
+class MappedFile {
+ public:
+  static std::expected<std::unique_ptr<MappedFile>, std::string> open(
+      const std::string& path);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  std::span<const uint8_t> bytes() const { return {data_, size_}; }
+
+  /**
+   * @brief Hints the kernel to start reading [offset, offset + length) now
+   * (MADV_WILLNEED). Cheap to call; out-of-range parts are clipped.
+   */
+  void prefetch(std::size_t offset, std::size_t length) const;
+
+ private:
+  MappedFile(const uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+
+  const uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace hermes::infra
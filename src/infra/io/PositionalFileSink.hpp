@@ -0,0 +1,179 @@
+#pragma once
+#include <algorithm>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/random_access_file.hpp>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "PartialFileGuard.hpp"
+
+namespace hermes::infra {
+
+/**
+ * @brief A file written in independent ranges (parallel ranged downloads).
+ * Like FileSink, bytes go to "<path>.part" and Commit() renames it into
+ * place; an uncommitted sink deletes its partial file.
+ *
+ * The sink tracks which extents are written and reports every growth of
+ * the contiguous prefix [0, n) to an optional listener, so the file can be
+ * read while it is still being filled.
+ */
+class PositionalFileSink {
+ public:
+  /**
+   * @brief AsyncWriteStream that writes at an offset and advances it, so a
+   * whole HTTP body can be streamed into one range of the file.
+   */
+  class Cursor {
+   public:
+    Cursor(PositionalFileSink& sink, uint64_t offset)
+        : sink_(&sink), start_(offset), offset_(offset) {}
+
+    /** @brief Bytes written through this cursor. */
+    uint64_t written() const { return offset_ - start_; }
+
+    using executor_type = boost::asio::random_access_file::executor_type;
+    executor_type get_executor() noexcept {
+      return sink_->file_.get_executor();
+    }
+
+    template <typename ConstBufferSequence, typename CompletionToken>
+    auto async_write_some(const ConstBufferSequence& buffers,
+                          CompletionToken&& token) {
+      return boost::asio::async_initiate<CompletionToken,
+                                         void(boost::system::error_code,
+                                              std::size_t)>(
+          [this](auto handler, const ConstBufferSequence& buffers) {
+            auto executor = boost::asio::get_associated_executor(
+                handler, sink_->file_.get_executor());
+            sink_->file_.async_write_some_at(
+                offset_, buffers,
+                boost::asio::bind_executor(
+                    executor,
+                    [this, handler = std::move(handler)](
+                        boost::system::error_code ec, std::size_t n) mutable {
+                      sink_->mark_written(offset_, n);
+                      offset_ += n;
+                      std::move(handler)(ec, n);
+                    }));
+          },
+          token, buffers);
+    }
+
+   private:
+    PositionalFileSink* sink_;
+    uint64_t start_;
+    uint64_t offset_;
+  };
+
+  explicit PositionalFileSink(boost::asio::io_context& ioc) : file_(ioc) {}
+
+  ~PositionalFileSink() {
+    boost::system::error_code ec;
+    file_.close(ec);
+  }
+
+  PositionalFileSink(const PositionalFileSink&) = delete;
+  PositionalFileSink& operator=(const PositionalFileSink&) = delete;
+
+  std::expected<void, std::string> Prepare(const std::filesystem::path& path) {
+    if (auto parent = path.parent_path(); !parent.empty()) {
+      std::error_code dir_ec;
+      std::filesystem::create_directories(parent, dir_ec);
+      if (dir_ec) return std::unexpected("Dir error: " + dir_ec.message());
+    }
+
+    path_ = path;
+    part_path_ = path;
+    part_path_ += ".part";
+
+    boost::system::error_code ec;
+    file_.open(part_path_.string(),
+               boost::asio::random_access_file::write_only |
+                   boost::asio::random_access_file::create |
+                   boost::asio::random_access_file::truncate,
+               ec);
+    if (ec) return std::unexpected("File open error: " + ec.message());
+
+    guard_ = std::make_unique<PartialFileGuard>(part_path_);
+    return {};
+  }
+
+  /** @brief Writer for the range starting at `offset`. */
+  Cursor at(uint64_t offset) { return Cursor(*this, offset); }
+
+  /** @brief Called with the new length whenever the written prefix grows. */
+  void on_prefix(std::function<void(uint64_t)> listener) {
+    on_prefix_ = std::move(listener);
+  }
+
+  /** @brief Current size of the partial file. */
+  std::expected<uint64_t, std::string> Size() {
+    boost::system::error_code ec;
+    auto size = file_.size(ec);
+    if (ec) return std::unexpected("File size error: " + ec.message());
+    return size;
+  }
+
+  /**
+   * @brief Closes the file and atomically publishes it under its final name.
+   */
+  std::expected<void, std::string> Commit() {
+    boost::system::error_code ec;
+    file_.close(ec);
+    if (ec) return std::unexpected("File close error: " + ec.message());
+
+    std::error_code rename_ec;
+    std::filesystem::rename(part_path_, path_, rename_ec);
+    if (rename_ec) return std::unexpected("Rename error: " + rename_ec.message());
+
+    if (guard_) {
+      guard_->disarm();
+    }
+    return {};
+  }
+
+ private:
+  boost::asio::random_access_file file_;
+  std::filesystem::path path_;
+  std::filesystem::path part_path_;
+  std::unique_ptr<PartialFileGuard> guard_;
+
+  /// Written extents, begin -> end, merged when they touch.
+  std::map<uint64_t, uint64_t> extents_;
+  std::function<void(uint64_t)> on_prefix_;
+
+  void mark_written(uint64_t offset, uint64_t n) {
+    if (n == 0) {
+      return;
+    }
+    uint64_t begin = offset;
+    uint64_t end = offset + n;
+    auto it = extents_.upper_bound(begin);
+    if (it != extents_.begin() && std::prev(it)->second >= begin) {
+      --it;
+      begin = it->first;
+      end = std::max(end, it->second);
+      it = extents_.erase(it);
+    }
+    while (it != extents_.end() && it->first <= end) {
+      end = std::max(end, it->second);
+      it = extents_.erase(it);
+    }
+    extents_.emplace(begin, end);
+
+    if (begin == 0 && on_prefix_) {
+      on_prefix_(end);
+    }
+  }
+};
+
+}  // namespace hermes::infra
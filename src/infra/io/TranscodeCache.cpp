@@ -0,0 +1,261 @@
+#include "TranscodeCache.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <boost/asio/post.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#include "Alaw.hpp"
+#include "Resampler.hpp"
+#include "WavUtils.hpp"
+
+namespace hermes::infra {
+
+namespace {
+
+/// Enough to hold the RIFF header and fmt chunk of any sane WAV file.
+constexpr std::size_t HEADER_PROBE_BYTES = 4096;
+/// Output samples converted per Resampler::pull().
+constexpr std::size_t CONVERT_BLOCK = 256;
+
+bool is_fresh(const std::string& derived, const std::string& source) {
+  std::error_code ec;
+  auto derived_time = std::filesystem::last_write_time(derived, ec);
+  if (ec) {
+    return false;
+  }
+  auto source_time = std::filesystem::last_write_time(source, ec);
+  return !ec && derived_time >= source_time;
+}
+
+std::expected<std::vector<uint8_t>, std::string> read_file(
+    const std::string& path, std::size_t limit = SIZE_MAX) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    return std::unexpected("cannot open " + path);
+  }
+  auto size = static_cast<std::size_t>(in.tellg());
+  std::vector<uint8_t> bytes(std::min(size, limit));
+  in.seekg(0);
+  in.read(reinterpret_cast<char*>(bytes.data()),  // NOLINT
+          static_cast<std::streamsize>(bytes.size()));
+  if (!in) {
+    return std::unexpected("short read on " + path);
+  }
+  return bytes;
+}
+
+/// Writes to "<path>.part" and renames over `path`.
+std::expected<void, std::string> write_atomically(const std::string& path,
+                                                  const void* data,
+                                                  std::size_t size) {
+  const std::string part = path + ".part";
+  {
+    std::ofstream out(part, std::ios::binary | std::ios::trunc);
+    out.write(static_cast<const char*>(data),
+              static_cast<std::streamsize>(size));
+    if (!out) {
+      std::error_code ignored;
+      std::filesystem::remove(part, ignored);
+      return std::unexpected("write failed: " + part);
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(part, path, ec);
+  if (ec) {
+    std::filesystem::remove(part, ec);
+    return std::unexpected("rename failed: " + path);
+  }
+  return {};
+}
+
+/// Downmixes / resamples the whole payload to mono PCM at `rate`.
+std::vector<int16_t> convert(std::span<const int16_t> source,
+                             const audio::wav::WavFormat& format,
+                             uint32_t rate) {
+  const std::size_t channels = format.channels;
+  if (format.sample_rate == rate && channels == config::CHANNELS) {
+    return {source.begin(), source.end()};
+  }
+
+  audio::Resampler resampler(format.sample_rate, rate, format.channels,
+                             CONVERT_BLOCK, config::RESAMPLER_CHUNK_FRAMES);
+  const std::size_t frames = source.size() / channels;
+  const auto total = static_cast<std::size_t>(resampler.output_length(frames));
+  const std::vector<int16_t> silence(config::RESAMPLER_CHUNK_FRAMES * channels);
+
+  std::vector<int16_t> out;
+  out.reserve(total);
+  std::array<int16_t, CONVERT_BLOCK> block{};
+  std::size_t pos = 0;
+
+  while (out.size() < total) {
+    const std::size_t want = std::min(CONVERT_BLOCK, total - out.size());
+    while (!resampler.can_produce(want)) {
+      if (pos < frames) {
+        const std::size_t n =
+            std::min(config::RESAMPLER_CHUNK_FRAMES, frames - pos);
+        resampler.push(source.subspan(pos * channels, n * channels));
+        pos += n;
+      } else {
+        resampler.push(silence);  // Flush the filter tail
+      }
+    }
+    auto chunk = std::span(block).first(want);
+    resampler.pull(chunk);
+    out.insert(out.end(), chunk.begin(), chunk.end());
+  }
+  return out;
+}
+
+}  // namespace
+
+TranscodeCache::~TranscodeCache() {
+  if (pool_) {
+    pool_->stop();
+    pool_->join();
+  }
+}
+
+void TranscodeCache::configure(const config::TranscodeConfig& cfg) {
+  std::lock_guard lock(mutex_);
+  enabled_ = cfg.enabled && cfg.threads > 0;
+  write_alaw_ = cfg.alaw;
+  if (enabled_ && !pool_) {
+    pool_ = std::make_unique<boost::asio::thread_pool>(cfg.threads);
+  }
+
+  spdlog::info("[Transcode] {} ({} threads, A-law {}).",
+               enabled_ ? "Enabled" : "Disabled", cfg.threads,
+               write_alaw_ ? "on" : "off");
+}
+
+std::string TranscodeCache::pcm_path(const std::string& source,
+                                     uint32_t rate) {
+  return std::format("{}.{}hz.v{}.pcm", source, rate, FORMAT_VERSION);
+}
+
+std::string TranscodeCache::alaw_path(const std::string& source) {
+  return std::format("{}.{}hz.v{}.alaw", source, config::SAMPLE_RATE,
+                     FORMAT_VERSION);
+}
+
+std::optional<std::string> TranscodeCache::lookup_pcm(
+    const std::string& source, uint32_t rate) const {
+  auto path = pcm_path(source, rate);
+  if (!is_fresh(path, source)) {
+    return std::nullopt;
+  }
+  return path;
+}
+
+std::optional<std::string> TranscodeCache::lookup_alaw(
+    const std::string& source) const {
+  auto path = alaw_path(source);
+  if (!is_fresh(path, source)) {
+    return std::nullopt;
+  }
+  return path;
+}
+
+void TranscodeCache::schedule(const std::string& source, uint32_t rate) {
+  std::lock_guard lock(mutex_);
+  if (!enabled_ || !pool_) {
+    return;
+  }
+
+  auto key = pcm_path(source, rate);
+  if (in_flight_.contains(key) || is_fresh(key, source)) {
+    return;
+  }
+  in_flight_.insert(key);
+
+  boost::asio::post(*pool_, [this, source, rate, with_alaw = write_alaw_,
+                             key = std::move(key)] {
+    auto result = transcode(source, rate, with_alaw);
+    if (!result) {
+      failed_.fetch_add(1, std::memory_order_relaxed);
+      spdlog::warn("[Transcode] {} failed: {}", source, result.error());
+    } else if (*result) {
+      completed_.fetch_add(1, std::memory_order_relaxed);
+      spdlog::info("[Transcode] {} -> {}", source, key);
+    } else {
+      skipped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::lock_guard done_lock(mutex_);
+    in_flight_.erase(key);
+  });
+}
+
+std::expected<bool, std::string> TranscodeCache::transcode(
+    const std::string& source, uint32_t rate, bool with_alaw) {
+  // Headerless PCM is already in canonical form; don't read it all.
+  auto header = read_file(source, HEADER_PROBE_BYTES);
+  if (!header) {
+    return std::unexpected(header.error());
+  }
+  auto format = audio::wav::parse_format(*header);
+  if (!format) {
+    return false;
+  }
+  // Also bounds the sample rate: convert() builds a Resampler from it, and
+  // a zero rate would divide by zero on this pool thread.
+  if (!format->is_pcm16()) {
+    return std::unexpected(
+        std::format("unsupported encoding (format {}, {} bits, {} Hz)",
+                    format->audio_format, format->bits_per_sample,
+                    format->sample_rate));
+  }
+
+  auto bytes = read_file(source);
+  if (!bytes) {
+    return std::unexpected(bytes.error());
+  }
+
+  const std::size_t offset =
+      std::min(audio::wav::get_audio_data_offset(*bytes), bytes->size());
+  const std::size_t payload =
+      ((bytes->size() - offset) / format->block_align) * format->block_align;
+  std::vector<int16_t> samples(payload / sizeof(int16_t));
+  std::memcpy(samples.data(), bytes->data() + offset, payload);
+  bytes->clear();
+  bytes->shrink_to_fit();
+
+  auto pcm = convert(samples, *format, rate);
+
+  // A-law first: whoever finds a fresh .pcm also finds its .alaw.
+  if (with_alaw && rate == static_cast<uint32_t>(config::SAMPLE_RATE)) {
+    std::vector<uint8_t> alaw(pcm.size());
+    audio::encode_alaw(boost::span<const int16_t>(pcm.data(), pcm.size()),
+                       boost::span<uint8_t>(alaw.data(), alaw.size()));
+    if (auto res = write_atomically(alaw_path(source), alaw.data(),
+                                    alaw.size());
+        !res) {
+      return std::unexpected(res.error());
+    }
+  }
+
+  if (auto res = write_atomically(pcm_path(source, rate), pcm.data(),
+                                  pcm.size() * sizeof(int16_t));
+      !res) {
+    return std::unexpected(res.error());
+  }
+  return true;
+}
+
+TranscodeStats TranscodeCache::get_stats() const {
+  std::lock_guard lock(mutex_);
+  return {completed_.load(std::memory_order_relaxed),
+          skipped_.load(std::memory_order_relaxed),
+          failed_.load(std::memory_order_relaxed), in_flight_.size()};
+}
+
+}  // namespace hermes::infra
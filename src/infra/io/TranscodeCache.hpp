@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+#include <boost/asio/thread_pool.hpp>
+
+#include "Config.hpp"
+
+namespace hermes::infra {
+
+struct TranscodeStats {
+  uint64_t completed = 0;
+  uint64_t skipped = 0;  ///< Already canonical, or headerless PCM
+  uint64_t failed = 0;
+  std::size_t pending = 0;
+};
+
+/**
+ * @brief Converts downloaded assets, once, into the canonical on-disk form
+ * sessions can stream without per-frame DSP.
+ *
+ * For a source `downloads/x.wav` and session rate R the canonical file is
+ * `downloads/x.wav.<R>hz.v<N>.pcm`: headerless native-endian mono 16-bit PCM
+ * at R, starting at offset 0 (page aligned for mmap), truncated to whole
+ * samples. At 8 kHz a matching `.alaw` (G.711 A-law, one byte per sample) is
+ * written alongside. N is bumped whenever the output format changes, so old
+ * files are simply ignored.
+ *
+ * Jobs run on a small private thread pool, never on an io_context thread.
+ * Results are written to a ".part" file and renamed into place, so a reader
+ * never sees a partial file. A canonical file older than its source is
+ * stale and is not served.
+ *
+ * =========================================================================
+ * THREAD SAFETY CONTRACT
+ * =========================================================================
+ * - All methods may be called from any thread.
+ * - configure() must be called before the first schedule().
+ * =========================================================================
+ */
+class TranscodeCache {
+ public:
+  static constexpr uint32_t FORMAT_VERSION = 1;
+
+  static TranscodeCache& instance() {
+    static TranscodeCache instance;
+    return instance;
+  }
+
+  TranscodeCache(const TranscodeCache&) = delete;
+  TranscodeCache& operator=(const TranscodeCache&) = delete;
+
+  ~TranscodeCache();
+
+  void configure(const config::TranscodeConfig& cfg);
+
+  static std::string pcm_path(const std::string& source, uint32_t rate);
+  static std::string alaw_path(const std::string& source);
+
+  /**
+   * @brief Canonical PCM for `source` at `rate` if it exists and is fresh.
+   */
+  std::optional<std::string> lookup_pcm(const std::string& source,
+                                        uint32_t rate) const;
+
+  /**
+   * @brief Precomputed 8 kHz A-law for `source` if it exists and is fresh.
+   */
+  std::optional<std::string> lookup_alaw(const std::string& source) const;
+
+  /**
+   * @brief Queues a background conversion of `source` to `rate`. No-op if
+   * disabled, already queued, or the canonical file is fresh.
+   */
+  void schedule(const std::string& source, uint32_t rate);
+
+  TranscodeStats get_stats() const;
+
+ private:
+  TranscodeCache() = default;
+
+  /**
+   * @brief Runs on the pool. Reads, converts and publishes one asset.
+   * @return false if the source needs no canonical copy (skipped).
+   */
+  static std::expected<bool, std::string> transcode(const std::string& source,
+                                                    uint32_t rate,
+                                                    bool with_alaw);
+
+  mutable std::mutex mutex_;
+  std::unique_ptr<boost::asio::thread_pool> pool_;
+  std::unordered_set<std::string> in_flight_;
+  bool enabled_ = false;
+  bool write_alaw_ = true;
+
+  std::atomic<uint64_t> completed_{0};
+  std::atomic<uint64_t> skipped_{0};
+  std::atomic<uint64_t> failed_{0};
+};
+
+}  // namespace hermes::infra
@@ -0,0 +1,416 @@
+#include "UdpEgress.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <boost/asio/socket_base.hpp>
+#include <chrono>
+
+#if defined(__linux__)
+#define HERMES_HAS_SENDMMSG 1
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cerrno>
+#include <cstring>
+#else
+#define HERMES_HAS_SENDMMSG 0
+#endif
+
+using namespace hermes::config;
+
+namespace hermes::infra {
+
+#if defined(SO_REUSEPORT)
+using reuse_port_option =
+    boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
+UdpEgress::UdpEgress(boost::asio::io_context& io, std::size_t index,
+                     const EgressConfig& cfg)
+    : io_(io),
+      index_(index),
+      shared_lanes_(std::max<std::size_t>(cfg.sockets_per_thread, 1)) {
+  const std::size_t count = shared_lanes_;
+  sockets_.reserve(count);
+
+  for (std::size_t i = 0; i < count; ++i) {
+    udp::socket socket(io_);
+    socket.open(udp::v4());
+    if (cfg.reuse_port) {
+#if defined(SO_REUSEPORT)
+      // Lets every thread's engine bind the same source port.
+      socket.set_option(reuse_port_option(true));
+#else
+      spdlog::warn("[UdpEgress {}] SO_REUSEPORT not supported, ignoring.",
+                   index_);
+#endif
+    }
+    socket.bind(udp::endpoint(udp::v4(), cfg.source_port));
+    add_lane(std::move(socket));
+  }
+
+  queue_.reserve(EGRESS_MAX_BATCH);
+  spdlog::debug("[UdpEgress {}] Ready with {} socket(s).", index_, count);
+}
+
+UdpEgress::DatagramHandler& UdpEgress::datagram_handler() {
+  static DatagramHandler handler;
+  return handler;
+}
+
+void UdpEgress::set_datagram_handler(DatagramHandler handler) {
+  datagram_handler() = std::move(handler);
+}
+
+std::size_t UdpEgress::add_lane(udp::socket socket) {
+  socket.non_blocking(true);
+
+  std::size_t lane = sockets_.size();
+  if (!free_lanes_.empty()) {
+    lane = free_lanes_.back();
+    free_lanes_.pop_back();
+    sockets_[lane] = std::move(socket);
+  } else {
+    sockets_.push_back(std::move(socket));
+  }
+
+  if (datagram_handler()) {
+    if (receivers_.size() <= lane) {
+      receivers_.resize(lane + 1);
+    }
+    if (!receivers_[lane]) {
+      receivers_[lane] = std::make_unique<Receiver>();
+    }
+    start_receive(lane);
+  }
+  return lane;
+}
+
+std::expected<std::size_t, boost::system::error_code>
+UdpEgress::open_multicast_lane(const MulticastConfig& cfg) {
+  namespace multicast = boost::asio::ip::multicast;
+
+  boost::system::error_code ec;
+  udp::socket socket(io_);
+  socket.open(udp::v4(), ec);
+  if (!ec) {
+    socket.set_option(multicast::hops(cfg.ttl), ec);
+  }
+  if (!ec) {
+    socket.set_option(multicast::enable_loopback(cfg.loopback), ec);
+  }
+  if (!ec && !cfg.interface_address.empty()) {
+    auto address = boost::asio::ip::make_address_v4(cfg.interface_address, ec);
+    if (!ec) {
+      socket.set_option(multicast::outbound_interface(address), ec);
+    }
+  }
+  if (!ec) {
+    socket.bind(udp::endpoint(udp::v4(), 0), ec);
+  }
+  if (ec) {
+    return std::unexpected(ec);
+  }
+
+  multicast_lanes_.fetch_add(1, std::memory_order_relaxed);
+  return add_lane(std::move(socket));
+}
+
+void UdpEgress::release_lane(std::size_t lane) {
+  if (lane < shared_lanes_ || lane >= sockets_.size() ||
+      !sockets_[lane].is_open()) {
+    return;
+  }
+
+  boost::system::error_code ec;
+  sockets_[lane].close(ec);  // Cancels the pending receive
+  if (lane < receivers_.size() && receivers_[lane]) {
+    ++receivers_[lane]->generation;
+  }
+  free_lanes_.push_back(lane);
+  multicast_lanes_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void UdpEgress::start_receive(std::size_t lane) {
+  auto& receiver = *receivers_[lane];
+  sockets_[lane].async_receive_from(
+      boost::asio::buffer(receiver.buffer), receiver.from,
+      [this, lane, generation = receiver.generation](
+          const boost::system::error_code& ec, std::size_t bytes) {
+        auto& receiver = *receivers_[lane];
+        if (ec == boost::asio::error::operation_aborted ||
+            receiver.generation != generation) {
+          // Socket closed; the lane may already carry a new socket with its
+          // own receive pending on the same buffer.
+          return;
+        }
+        if (!ec) {
+          datagrams_received_.fetch_add(1, std::memory_order_relaxed);
+          datagram_handler()(std::span(receiver.buffer).first(bytes),
+                             receiver.from);
+        } else {
+          // E.g. ECONNREFUSED from an earlier send: keep listening.
+          spdlog::trace("[UdpEgress {}] Receive failed: {}", index_,
+                        ec.message());
+        }
+        start_receive(lane);
+      });
+}
+
+std::size_t UdpEgress::assign_lane() {
+  std::size_t lane = next_lane_;
+  next_lane_ = (next_lane_ + 1) % shared_lanes_;
+  return lane;
+}
+
+std::span<uint8_t> UdpEgress::reserve(std::size_t max_size) {
+  if (slab_used_ + max_size > slab_.size()) {
+    // Grows during warm-up only; steady state reuses the same slab.
+    slab_.resize(std::max(slab_.size() * 2, slab_used_ + max_size));
+  }
+  return {slab_.data() + slab_used_, max_size};
+}
+
+void UdpEgress::commit(std::size_t size, std::span<const EgressTarget> targets,
+                       const std::shared_ptr<EgressCounters>& counters,
+                       const PendingEncryption* encryption) {
+  if (size == 0 || targets.empty()) {
+    return;
+  }
+
+  auto offset = static_cast<uint32_t>(slab_used_);
+  slab_used_ += size;
+
+  if (encryption != nullptr && encryption->payload_offset < size) {
+    // Offsets, not spans: reserve() may still move the slab this tick.
+    encryptions_.push_back(Encryption{
+        offset + static_cast<uint32_t>(encryption->payload_offset),
+        static_cast<uint32_t>(size - encryption->payload_offset),
+        encryption->packet_index, encryption->strategy});
+  }
+
+  auto counters_idx = static_cast<uint32_t>(counters_.size());
+  counters_.push_back(counters);
+
+  for (const auto& target : targets) {
+    queue_.push_back(Datagram{offset, static_cast<uint32_t>(size),
+                              static_cast<uint32_t>(target.lane), counters_idx,
+                              *target.endpoint});
+  }
+
+  if (queue_.size() >= EGRESS_MAX_BATCH) {
+    flush();
+  }
+}
+
+void UdpEgress::flush() {
+  if (queue_.empty()) {
+    return;
+  }
+
+  last_batch_size_.store(queue_.size(), std::memory_order_relaxed);
+  datagrams_.fetch_add(queue_.size(), std::memory_order_relaxed);
+  flushes_.fetch_add(1, std::memory_order_relaxed);
+
+  encrypt_pending();
+
+  // One sendmmsg() run per lane: group the batch by lane (usually a no-op,
+  // most of it goes out on the shared lanes) instead of rescanning it for
+  // every multicast lane.
+  std::ranges::stable_sort(queue_, {}, &Datagram::lane);
+  for (auto begin = queue_.begin(); begin != queue_.end();) {
+    auto end = std::find_if(begin, queue_.end(), [lane = begin->lane](
+                                                     const Datagram& d) {
+      return d.lane != lane;
+    });
+    flush_lane(std::span(begin, end));
+    begin = end;
+  }
+
+  queue_.clear();
+  counters_.clear();
+  slab_used_ = 0;
+}
+
+void UdpEgress::encrypt_pending() {
+  if (encryptions_.empty()) {
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  jobs_.clear();
+  for (const auto& pending : encryptions_) {
+    jobs_.push_back(crypto::EncryptionJob{
+        pending.strategy.get(), {slab_.data() + pending.offset, pending.size},
+        pending.packet_index});
+  }
+  crypto::encrypt_batch(jobs_);
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  encrypt_ns_.fetch_add(static_cast<uint64_t>(elapsed.count()),
+                        std::memory_order_relaxed);
+  encrypted_packets_.fetch_add(encryptions_.size(), std::memory_order_relaxed);
+  encryptions_.clear();
+}
+
+void UdpEgress::add_srtp_sender(std::weak_ptr<crypto::SrtpSender> sender) {
+  srtp_senders_.push_back(std::move(sender));
+}
+
+void UdpEgress::prefetch_keystreams() {
+  if (srtp_senders_.empty()) {
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  // Senders are owned on this thread too: none can go away before the batch
+  // below has written into it.
+  prefetch_jobs_.clear();
+  std::erase_if(srtp_senders_, [this](const auto& weak) {
+    auto sender = weak.lock();
+    if (!sender) {
+      return true;
+    }
+    sender->prefetch(prefetch_jobs_);
+    return false;
+  });
+  if (prefetch_jobs_.empty()) {
+    return;
+  }
+  crypto::aes128_ctr_batch(prefetch_jobs_);
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
+  prefetch_ns_.fetch_add(static_cast<uint64_t>(elapsed.count()),
+                         std::memory_order_relaxed);
+  keystream_prefetches_.fetch_add(prefetch_jobs_.size(),
+                                  std::memory_order_relaxed);
+}
+
+void UdpEgress::flush_lane(std::span<const Datagram> order) {
+  const std::size_t lane = order.front().lane;
+#if HERMES_HAS_SENDMMSG
+  // Scratch reused across ticks: no allocation in steady state.
+  static thread_local std::vector<mmsghdr> msgs;
+  static thread_local std::vector<iovec> iovs;
+
+  msgs.resize(order.size());
+  iovs.resize(order.size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    const auto* d = &order[i];
+    iovs[i] = iovec{slab_.data() + d->offset, d->size};
+    msgs[i] = mmsghdr{};
+    msgs[i].msg_hdr.msg_name = const_cast<void*>(  // NOLINT
+        static_cast<const void*>(d->destination.data()));
+    msgs[i].msg_hdr.msg_namelen =
+        static_cast<socklen_t>(d->destination.size());
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  const int fd = sockets_[lane].native_handle();
+  std::size_t sent = 0;
+  while (sent < order.size()) {
+    int n = ::sendmmsg(fd, msgs.data() + sent,
+                       static_cast<unsigned int>(order.size() - sent),
+                       MSG_DONTWAIT);
+    syscalls_.fetch_add(1, std::memory_order_relaxed);
+
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;  // Socket buffer full: hand the rest to Asio.
+      }
+      // The failure belongs to the first unsent destination; skip it.
+      spdlog::debug("UDP send failed: {}", std::strerror(errno));
+      send_errors_.fetch_add(1, std::memory_order_relaxed);
+      ++sent;
+      continue;
+    }
+
+    for (int k = 0; k < n; ++k) {
+      const auto* d = &order[sent + static_cast<std::size_t>(k)];
+      auto& counters = *counters_[d->counters];
+      counters.bytes_sent.fetch_add(msgs[sent + static_cast<std::size_t>(k)].msg_len,
+                                    std::memory_order_relaxed);
+      counters.packets_sent.fetch_add(1, std::memory_order_relaxed);
+    }
+    sent += static_cast<std::size_t>(n);
+  }
+
+  for (; sent < order.size(); ++sent) {
+    send_fallback(order[sent]);
+  }
+#else
+  for (const auto& datagram : order) {
+    boost::system::error_code ec;
+    auto bytes = sockets_[lane].send_to(
+        boost::asio::buffer(slab_.data() + datagram.offset, datagram.size),
+        datagram.destination, 0, ec);
+    syscalls_.fetch_add(1, std::memory_order_relaxed);
+
+    if (ec == boost::asio::error::would_block) {
+      send_fallback(datagram);
+    } else if (ec) {
+      spdlog::debug("UDP send failed: {}", ec.message());
+      send_errors_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      auto& counters = *counters_[datagram.counters];
+      counters.bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+      counters.packets_sent.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+#endif
+}
+
+void UdpEgress::send_fallback(const Datagram& datagram) {
+  // Rare path (socket buffer full): the slab is recycled right after the
+  // flush, so the packet gets its own copy.
+  auto packet = std::make_shared<std::vector<uint8_t>>(
+      slab_.begin() + datagram.offset,
+      slab_.begin() + datagram.offset + datagram.size);
+  auto counters = counters_[datagram.counters];
+  fallback_sends_.fetch_add(1, std::memory_order_relaxed);
+
+  sockets_[datagram.lane].async_send_to(
+      boost::asio::buffer(*packet), datagram.destination,
+      [this, packet, counters](const boost::system::error_code& ec,
+                               std::size_t bytes_transferred) {
+        if (!ec) {
+          counters->bytes_sent.fetch_add(bytes_transferred,
+                                         std::memory_order_relaxed);
+          counters->packets_sent.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          spdlog::debug("UDP send failed: {}", ec.message());
+          send_errors_.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+}
+
+UdpEgressStats UdpEgress::get_stats() const {
+  return UdpEgressStats{
+      .index = index_,
+      .sockets = shared_lanes_,
+      .flushes = flushes_.load(std::memory_order_relaxed),
+      .datagrams = datagrams_.load(std::memory_order_relaxed),
+      .syscalls = syscalls_.load(std::memory_order_relaxed),
+      .fallback_sends = fallback_sends_.load(std::memory_order_relaxed),
+      .send_errors = send_errors_.load(std::memory_order_relaxed),
+      .last_batch_size = last_batch_size_.load(std::memory_order_relaxed),
+      .encrypted_packets = encrypted_packets_.load(std::memory_order_relaxed),
+      .encrypt_ns = encrypt_ns_.load(std::memory_order_relaxed),
+      .keystream_prefetches =
+          keystream_prefetches_.load(std::memory_order_relaxed),
+      .prefetch_ns = prefetch_ns_.load(std::memory_order_relaxed),
+      .datagrams_received =
+          datagrams_received_.load(std::memory_order_relaxed),
+      .multicast_lanes = multicast_lanes_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace hermes::infra
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Config.hpp"
+#include "EncryptionStrategy.hpp"
+#include "SrtpSender.hpp"
+
+namespace hermes::infra {
+
+/**
+ * @brief Per-stream delivery counters, owned jointly by the stream (which
+ * reports them) and any in-flight fallback sends (which update them).
+ */
+struct EgressCounters {
+  std::atomic<uint64_t> bytes_sent{0};
+  std::atomic<uint64_t> packets_sent{0};
+};
+
+struct UdpEgressStats {
+  std::size_t index = 0;
+  std::size_t sockets = 0;
+  uint64_t flushes = 0;
+  uint64_t datagrams = 0;
+  uint64_t syscalls = 0;
+  uint64_t fallback_sends = 0;
+  uint64_t send_errors = 0;
+  uint64_t last_batch_size = 0;
+  uint64_t encrypted_packets = 0;
+  uint64_t encrypt_ns = 0;  ///< Time spent in the encryption pass
+  uint64_t keystream_prefetches = 0;  ///< SRTP packet keystreams prefetched
+  uint64_t prefetch_ns = 0;
+  uint64_t datagrams_received = 0;  ///< Handed to the datagram handler
+  std::size_t multicast_lanes = 0;  ///< Open multicast sockets
+};
+
+/**
+ * @brief One destination of a committed packet, and the lane (socket) it is
+ * sent from.
+ */
+struct EgressTarget {
+  const boost::asio::ip::udp::endpoint* endpoint;
+  std::size_t lane;
+};
+
+/**
+ * @brief A committed packet whose payload is still plaintext. The engine
+ * encrypts every pending payload of the batch in one pass just before
+ * sending it, across all streams.
+ */
+struct PendingEncryption {
+  std::shared_ptr<crypto::IEncryptionStrategy> strategy;
+  std::size_t payload_offset;  ///< From the start of the packet
+  uint64_t packet_index;
+};
+
+/**
+ * @brief Per-io_context UDP egress engine.
+ *
+ * Owns a small set of UDP sockets shared by every stream pinned to the same
+ * io_context. Streams write packets straight into the engine's batch slab
+ * (reserve() + commit()); the FrameClock flushes the whole batch with
+ * sendmmsg() once per tick, after all sessions have produced their frame.
+ * Encrypted streams hand their payloads over in plaintext; flush() encrypts
+ * the whole batch first (see crypto::encrypt_batch()).
+ * Clients reply (RTCP) to the sockets streams send from: when a datagram
+ * handler is installed, every socket also keeps a receive pending.
+ *
+ * Multicast targets get a socket (lane) of their own, because TTL, outgoing
+ * interface and loopback are socket options: see open_multicast_lane().
+ * A packet for a group is still one datagram, whatever the listener count.
+ *
+ * =========================================================================
+ * THREAD SAFETY CONTRACT
+ * =========================================================================
+ * - Every method except get_stats() MUST be called on the engine's
+ *   io_context thread. Producers and the flusher are the same thread, so the
+ *   submission queue needs no locks or atomics at all.
+ * - get_stats() may be called from any thread.
+ * =========================================================================
+ */
+class UdpEgress {
+ public:
+  using udp = boost::asio::ip::udp;
+  using DatagramHandler =
+      std::function<void(std::span<const uint8_t>, const udp::endpoint&)>;
+
+  /**
+   * @brief Installs the handler for datagrams arriving on egress sockets, for
+   * every engine created afterwards. Call once at startup, before the
+   * IoContextPool exists; the handler runs on the receiving socket's thread.
+   */
+  static void set_datagram_handler(DatagramHandler handler);
+
+  UdpEgress(boost::asio::io_context& io, std::size_t index,
+            const config::EgressConfig& cfg);
+
+  UdpEgress(const UdpEgress&) = delete;
+  UdpEgress& operator=(const UdpEgress&) = delete;
+
+  /**
+   * @brief Picks the shared socket a new stream sends unicast from
+   * (round-robin). A stream keeps its lane, and therefore its source port,
+   * for its whole lifetime.
+   */
+  std::size_t assign_lane();
+
+  /**
+   * @brief Opens a socket with the given multicast options (ephemeral source
+   * port) for one target of one stream.
+   * @return Its lane, or why a socket option was rejected.
+   */
+  std::expected<std::size_t, boost::system::error_code> open_multicast_lane(
+      const config::MulticastConfig& cfg);
+
+  /**
+   * @brief Closes a lane from open_multicast_lane(). Nothing may be queued on
+   * it anymore (streams release lanes when they are destroyed, between
+   * ticks).
+   */
+  void release_lane(std::size_t lane);
+
+  /**
+   * @brief Returns writable space for one packet in the current batch.
+   * The span is only valid until the next reserve()/flush().
+   */
+  std::span<uint8_t> reserve(std::size_t max_size);
+
+  /**
+   * @brief Queues the packet just written into reserve() for every target.
+   * The packet bytes are stored once regardless of fan-out.
+   * @param encryption Set if the payload still has to be encrypted.
+   */
+  void commit(std::size_t size, std::span<const EgressTarget> targets,
+              const std::shared_ptr<EgressCounters>& counters,
+              const PendingEncryption* encryption = nullptr);
+
+  /**
+   * @brief Sends everything queued so far. Called by the FrameClock at the end
+   * of each tick batch; also called early if the batch grows too large.
+   */
+  void flush();
+
+  /**
+   * @brief Registers an SRTP stream for keystream prefetching. The engine
+   * only holds a weak reference and forgets the stream once it is gone.
+   */
+  void add_srtp_sender(std::weak_ptr<crypto::SrtpSender> sender);
+
+  /**
+   * @brief Generates the keystream of every SRTP stream's next packets in one
+   * AES batch. Called by the FrameClock right after flush(), while sessions
+   * wait for the next tick.
+   */
+  void prefetch_keystreams();
+
+  boost::asio::io_context& get_io_context() { return io_; }
+
+  UdpEgressStats get_stats() const;
+
+ private:
+  struct Datagram {
+    uint32_t offset;
+    uint32_t size;
+    uint32_t lane;
+    uint32_t counters;  // Index into counters_
+    udp::endpoint destination;
+  };
+
+  struct Encryption {
+    uint32_t offset;  // Payload offset in slab_
+    uint32_t size;
+    uint64_t packet_index;
+    std::shared_ptr<crypto::IEncryptionStrategy> strategy;
+  };
+
+  struct Receiver {
+    std::array<uint8_t, 1500> buffer;  // NOLINT: one MTU
+    udp::endpoint from;
+    // Bumped when the lane is released: a completion of the closed socket's
+    // receive may still be queued when the lane is reused, and must not read
+    // the buffer or re-arm the receive.
+    uint64_t generation = 0;
+  };
+
+  static DatagramHandler& datagram_handler();
+
+  /** @brief Adds a bound, non-blocking socket; reuses a released lane. */
+  std::size_t add_lane(udp::socket socket);
+
+  void start_receive(std::size_t lane);
+
+  /** @brief Encrypts every pending payload of the batch in one pass. */
+  void encrypt_pending();
+  /** @brief Sends a run of datagrams that share one lane. */
+  void flush_lane(std::span<const Datagram> order);
+  void send_fallback(const Datagram& datagram);
+
+  boost::asio::io_context& io_;
+  std::size_t index_;
+  std::vector<udp::socket> sockets_;
+  std::size_t shared_lanes_;  // sockets_[0, shared_lanes_) are round-robin
+  std::size_t next_lane_ = 0;
+  std::vector<std::size_t> free_lanes_;  // Released multicast lanes
+
+  std::vector<uint8_t> slab_;
+  std::size_t slab_used_ = 0;
+  std::vector<Datagram> queue_;
+  std::vector<std::shared_ptr<EgressCounters>> counters_;
+  std::vector<Encryption> encryptions_;
+  std::vector<crypto::EncryptionJob> jobs_;
+  std::vector<std::weak_ptr<crypto::SrtpSender>> srtp_senders_;
+  std::vector<crypto::AesCtrJob> prefetch_jobs_;
+  // One per socket if a handler is set; stable while receives are pending.
+  std::vector<std::unique_ptr<Receiver>> receivers_;
+
+  std::atomic<uint64_t> flushes_{0};
+  std::atomic<uint64_t> datagrams_{0};
+  std::atomic<uint64_t> syscalls_{0};
+  std::atomic<uint64_t> fallback_sends_{0};
+  std::atomic<uint64_t> send_errors_{0};
+  std::atomic<uint64_t> last_batch_size_{0};
+  std::atomic<uint64_t> encrypted_packets_{0};
+  std::atomic<uint64_t> encrypt_ns_{0};
+  std::atomic<uint64_t> keystream_prefetches_{0};
+  std::atomic<uint64_t> prefetch_ns_{0};
+  std::atomic<uint64_t> datagrams_received_{0};
+  std::atomic<std::size_t> multicast_lanes_{0};
+};
+
+}  // namespace hermes::infra
@@ -58,6 +58,50 @@ std::expected<void, config::ErrorInfo> parse_nodes(boost::asio::io_context& io,
   return {};
 }
 
+/**
+ * @brief Reads the optional flow-level "audio" object
+ * ({"sampleRate": 8000|16000|48000, "frameMs": 10|20|40}); anything missing
+ * keeps the 8 kHz / 20 ms default.
+ */
+std::expected<void, config::ErrorInfo> parse_geometry(
+    const json::object& flow_obj, audio::Graph& graph) {
+  if (!flow_obj.contains("audio")) {
+    return {};
+  }
+
+  auto audio_res = require_json<json::object>(flow_obj, "audio");
+  if (!audio_res) {
+    return std::unexpected(audio_res.error());
+  }
+  const json::object& audio = *audio_res;
+
+  FrameGeometry geometry{};
+  if (audio.contains("sampleRate")) {
+    auto rate = require_json<uint32_t>(audio, "sampleRate");
+    if (!rate) return std::unexpected(rate.error());
+    geometry.sample_rate = *rate;
+  }
+  if (audio.contains("frameMs")) {
+    auto frame_ms = require_json<uint32_t>(audio, "frameMs");
+    if (!frame_ms) return std::unexpected(frame_ms.error());
+    geometry.frame_ms = *frame_ms;
+  }
+
+  if (!geometry.is_supported()) {
+    return std::unexpected(ErrorInfo::From(
+        AppError::ParseError,
+        "Unsupported audio geometry {} Hz / {} ms (expected 8000/16000/48000 "
+        "Hz and 10/20/40 ms)",
+        geometry.sample_rate, geometry.frame_ms));
+  }
+
+  graph.geometry = geometry;
+  spdlog::debug("Graph audio geometry: {} Hz, {} ms ({} samples/frame)",
+                geometry.sample_rate, geometry.frame_ms,
+                geometry.samples_per_frame());
+  return {};
+}
+
 std::expected<void, config::ErrorInfo> set_start_node(
     const json::object& flow_obj, audio::Graph& graph) {
   auto start_obj_res = require_json<json::object>(flow_obj, "start_node");
@@ -130,6 +174,10 @@ std::expected<audio::Graph, config::ErrorInfo> parse_graph(
 
   const json::object& flow = *flow_res;
 
+  if (auto err = parse_geometry(flow, graph); !err) {
+    return std::unexpected(err.error());
+  }
+
   auto nodes_res = require_json<json::array>(flow, "nodes");
   if (!nodes_res) return std::unexpected(nodes_res.error());
 
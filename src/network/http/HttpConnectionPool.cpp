@@ -0,0 +1,345 @@
+#include "HttpConnectionPool.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+namespace hermes::net::http {
+
+namespace {
+
+constexpr auto CONNECT_TIMEOUT = std::chrono::seconds(30);
+
+config::HttpPoolConfig& settings() {
+  static config::HttpPoolConfig cfg;
+  return cfg;
+}
+
+struct PoolCounters {
+  std::atomic<uint64_t> connects{0};
+  std::atomic<uint64_t> reuses{0};
+  std::atomic<uint64_t> pipelined{0};
+  std::atomic<uint64_t> waits{0};
+  std::atomic<uint64_t> evictions{0};
+  std::atomic<uint64_t> retries{0};
+  std::atomic<int64_t> open{0};
+};
+
+PoolCounters& counters() {
+  static PoolCounters instance;
+  return instance;
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// PooledConnection
+// ---------------------------------------------------------------------------
+
+PooledConnection::PooledConnection(boost::asio::io_context& ioc,
+                                   std::string host_key)
+    : stream_(ioc), host_key_(std::move(host_key)) {}
+
+boost::asio::awaitable<bool> PooledConnection::wait_write_turn(
+    uint64_t ticket) {
+  while (written_ != ticket && !broken_) {
+    co_await wait_change();
+  }
+  co_return !broken_;
+}
+
+boost::asio::awaitable<bool> PooledConnection::wait_read_turn(uint64_t ticket) {
+  while (served_ != ticket && !broken_) {
+    co_await wait_change();
+  }
+  co_return !broken_;
+}
+
+void PooledConnection::finish_write() {
+  ++written_;
+  notify();
+}
+
+void PooledConnection::finish_read() {
+  ++served_;
+  notify();
+}
+
+void PooledConnection::mark_broken() {
+  broken_ = true;
+  notify();
+}
+
+boost::asio::awaitable<void> PooledConnection::wait_change() {
+  auto timer = std::make_shared<boost::asio::steady_timer>(
+      stream_.get_executor(), boost::asio::steady_timer::time_point::max());
+  waiters_.push_back(timer);
+  boost::system::error_code ec;  // operation_aborted when notified
+  co_await timer->async_wait(
+      boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+}
+
+void PooledConnection::notify() {
+  auto waiters = std::move(waiters_);
+  waiters_.clear();
+  for (auto& timer : waiters) {
+    timer->cancel();
+  }
+}
+
+// ---------------------------------------------------------------------------
+// HttpConnectionPool
+// ---------------------------------------------------------------------------
+
+HttpConnectionPool::HttpConnectionPool(boost::asio::io_context& ioc)
+    : boost::asio::execution_context::service(ioc),
+      ioc_(ioc),
+      sweep_timer_(ioc) {}
+
+void HttpConnectionPool::configure(const config::HttpPoolConfig& cfg) {
+  auto& current = settings();
+  current = cfg;
+  current.max_per_host = std::max<std::size_t>(current.max_per_host, 1);
+  current.pipeline_depth = std::max<std::size_t>(current.pipeline_depth, 1);
+
+  spdlog::info(
+      "[HttpPool] {} connections per host, idle timeout {} s, pipeline "
+      "depth {}.",
+      current.max_per_host, current.idle_timeout_s, current.pipeline_depth);
+}
+
+boost::asio::awaitable<std::expected<ConnectionLease, config::ErrorInfo>>
+HttpConnectionPool::acquire(const std::string& host, const std::string& port,
+                            bool fresh) {
+  const auto& cfg = settings();
+  const std::string key = host + ":" + port;
+  auto& pool = hosts_[key];  // Node-based map: stays valid across awaits
+  bool waited = false;
+
+  for (;;) {
+    evict_idle(pool, std::chrono::steady_clock::now());
+
+    while (!fresh && !pool.idle.empty()) {
+      auto conn = std::move(pool.idle.back());
+      pool.idle.pop_back();
+      if (!is_healthy(*conn)) {
+        close(*conn);
+        counters().evictions.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      pool.busy.push_back(conn);
+      ++conn->leases_;
+      counters().reuses.fetch_add(1, std::memory_order_relaxed);
+      co_return ConnectionLease{conn, conn->next_ticket_++, true};
+    }
+
+    if (pool.open() < cfg.max_per_host) {
+      ++pool.connecting;
+      auto conn = std::make_shared<PooledConnection>(ioc_, key);
+      auto connected = co_await connect(*conn, host, port);
+      --pool.connecting;
+      if (!connected) {
+        wake_one(pool);
+        co_return std::unexpected(connected.error());
+      }
+
+      counters().connects.fetch_add(1, std::memory_order_relaxed);
+      counters().open.fetch_add(1, std::memory_order_relaxed);
+      pool.busy.push_back(conn);
+      ++conn->leases_;
+      // Requests that queued while we connected can pipeline behind us.
+      for (std::size_t i = 1; i < cfg.pipeline_depth; ++i) {
+        wake_one(pool);
+      }
+      co_return ConnectionLease{conn, conn->next_ticket_++, false};
+    }
+
+    if (!fresh && cfg.pipeline_depth > 1) {
+      std::shared_ptr<PooledConnection> best;
+      for (const auto& conn : pool.busy) {
+        if (!conn->broken_ && conn->outstanding() < cfg.pipeline_depth &&
+            (!best || conn->outstanding() < best->outstanding())) {
+          best = conn;
+        }
+      }
+      if (best) {
+        ++best->leases_;
+        counters().pipelined.fetch_add(1, std::memory_order_relaxed);
+        co_return ConnectionLease{best, best->next_ticket_++, true};
+      }
+    }
+
+    if (!waited) {
+      waited = true;
+      counters().waits.fetch_add(1, std::memory_order_relaxed);
+    }
+    co_await wait_for_slot(pool);
+  }
+}
+
+void HttpConnectionPool::release(const ConnectionLease& lease) {
+  auto& conn = *lease.conn;
+  auto& pool = hosts_[conn.host_key_];
+
+  // A request that failed before its response was read leaves the pipeline
+  // out of step; the connection cannot be used again.
+  if (conn.served_ <= lease.ticket) {
+    conn.mark_broken();
+  }
+
+  if (--conn.leases_ == 0) {
+    std::erase(pool.busy, lease.conn);
+    if (conn.broken_) {
+      close(conn);
+    } else {
+      conn.idle_since_ = std::chrono::steady_clock::now();
+      pool.idle.push_back(lease.conn);
+      schedule_sweep();
+    }
+  }
+
+  wake_one(pool);
+}
+
+boost::asio::awaitable<std::expected<void, config::ErrorInfo>>
+HttpConnectionPool::connect(PooledConnection& conn, const std::string& host,
+                            const std::string& port) {
+  boost::system::error_code ec;
+  boost::asio::ip::tcp::resolver resolver(ioc_);
+  auto results = co_await resolver.async_resolve(
+      host, port, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+  if (ec) {
+    co_return std::unexpected(config::ErrorInfo::From(
+        config::AppError::NetworkError, "Resolve failed: " + ec.message()));
+  }
+
+  conn.stream().expires_after(CONNECT_TIMEOUT);
+  co_await conn.stream().async_connect(
+      results, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+  if (ec) {
+    co_return std::unexpected(config::ErrorInfo::From(
+        config::AppError::NetworkError, "Connect failed: " + ec.message()));
+  }
+
+  boost::system::error_code ignored;
+  conn.stream().socket().set_option(boost::asio::ip::tcp::no_delay(true),
+                                    ignored);
+  co_return std::expected<void, config::ErrorInfo>();
+}
+
+bool HttpConnectionPool::is_healthy(PooledConnection& conn) {
+  // An idle connection has nothing to read. Data means a protocol error,
+  // EOF means the server closed it; only "would block" is healthy.
+  if (conn.buffer().size() > 0 || !conn.stream().socket().is_open()) {
+    return false;
+  }
+
+  auto& socket = conn.stream().socket();
+  boost::system::error_code ec;
+  socket.non_blocking(true, ec);
+  if (ec) {
+    return false;
+  }
+  std::array<char, 1> probe{};
+  socket.read_some(boost::asio::buffer(probe), ec);
+  const bool healthy = ec == boost::asio::error::would_block;
+  socket.non_blocking(false, ec);
+  return healthy && !ec;
+}
+
+void HttpConnectionPool::close(PooledConnection& conn) {
+  boost::system::error_code ec;
+  auto& socket = conn.stream().socket();
+  if (socket.is_open()) {
+    socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+    socket.close(ec);
+    counters().open.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void HttpConnectionPool::evict_idle(
+    HostPool& pool, std::chrono::steady_clock::time_point now) {
+  const auto timeout = std::chrono::seconds(settings().idle_timeout_s);
+  while (!pool.idle.empty() && now - pool.idle.front()->idle_since_ >= timeout) {
+    close(*pool.idle.front());
+    pool.idle.pop_front();
+    counters().evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void HttpConnectionPool::schedule_sweep() {
+  if (sweep_pending_) {
+    return;
+  }
+  sweep_pending_ = true;
+  sweep_timer_.expires_after(std::chrono::seconds(settings().idle_timeout_s));
+  sweep_timer_.async_wait([this](boost::system::error_code ec) {
+    sweep_pending_ = false;
+    if (ec) {
+      return;
+    }
+    bool any_idle = false;
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& [key, pool] : hosts_) {
+      evict_idle(pool, now);
+      any_idle = any_idle || !pool.idle.empty();
+    }
+    if (any_idle) {
+      schedule_sweep();
+    }
+  });
+}
+
+boost::asio::awaitable<void> HttpConnectionPool::wait_for_slot(
+    HostPool& pool) {
+  auto timer = std::make_shared<boost::asio::steady_timer>(
+      ioc_, boost::asio::steady_timer::time_point::max());
+  pool.slot_waiters.push_back(timer);
+  boost::system::error_code ec;  // operation_aborted when woken
+  co_await timer->async_wait(
+      boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+}
+
+void HttpConnectionPool::wake_one(HostPool& pool) {
+  if (!pool.slot_waiters.empty()) {
+    pool.slot_waiters.front()->cancel();
+    pool.slot_waiters.pop_front();
+  }
+}
+
+void HttpConnectionPool::shutdown() {
+  sweep_timer_.cancel();
+  for (auto& [key, pool] : hosts_) {
+    for (auto& conn : pool.idle) {
+      close(*conn);
+    }
+    for (auto& conn : pool.busy) {
+      close(*conn);
+    }
+    pool.idle.clear();
+    pool.busy.clear();
+    pool.slot_waiters.clear();
+  }
+}
+
+void HttpConnectionPool::count_retry() {
+  counters().retries.fetch_add(1, std::memory_order_relaxed);
+}
+
+HttpPoolStats HttpConnectionPool::get_stats() {
+  auto& c = counters();
+  return {c.connects.load(std::memory_order_relaxed),
+          c.reuses.load(std::memory_order_relaxed),
+          c.pipelined.load(std::memory_order_relaxed),
+          c.waits.load(std::memory_order_relaxed),
+          c.evictions.load(std::memory_order_relaxed),
+          c.retries.load(std::memory_order_relaxed),
+          c.open.load(std::memory_order_relaxed)};
+}
+
+}  // namespace hermes::net::http
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Config.hpp"
+#include "Types.hpp"
+
+namespace hermes::net::http {
+
+struct HttpPoolStats {
+  uint64_t connects = 0;   ///< New TCP connections opened
+  uint64_t reuses = 0;     ///< Requests sent on an idle keep-alive connection
+  uint64_t pipelined = 0;  ///< Requests queued behind another on a connection
+  uint64_t waits = 0;      ///< Requests that waited for a free connection
+  uint64_t evictions = 0;  ///< Idle connections closed (timeout / health)
+  uint64_t retries = 0;    ///< Requests re-sent after a stale connection
+  int64_t open = 0;        ///< Connections currently open
+};
+
+/**
+ * @brief One keep-alive connection of an HttpConnectionPool.
+ *
+ * Every request given this connection gets a ticket. Requests are written
+ * and their responses read strictly in ticket order, which is what HTTP/1.1
+ * pipelining requires; wait_write_turn() / wait_read_turn() suspend until
+ * it is the ticket's turn.
+ */
+class PooledConnection {
+ public:
+  PooledConnection(boost::asio::io_context& ioc, std::string host_key);
+
+  boost::beast::tcp_stream& stream() { return stream_; }
+
+  /** @brief Read buffer; may hold the start of the next pipelined response. */
+  boost::beast::flat_buffer& buffer() { return buffer_; }
+
+  /**
+   * @return false if the connection broke before the turn came.
+   */
+  boost::asio::awaitable<bool> wait_write_turn(uint64_t ticket);
+  boost::asio::awaitable<bool> wait_read_turn(uint64_t ticket);
+
+  void finish_write();
+  void finish_read();
+
+  /** @brief Whether `ticket` is the response being read now. */
+  bool is_reading(uint64_t ticket) const { return ticket == served_; }
+
+  /**
+   * @brief Takes the connection out of service (error, or the server will
+   * close it). Requests still queued on it are released and fail.
+   */
+  void mark_broken();
+  bool is_broken() const { return broken_; }
+
+ private:
+  friend class HttpConnectionPool;
+
+  boost::asio::awaitable<void> wait_change();
+  void notify();
+
+  /** @brief Requests assigned but not yet fully read. */
+  std::size_t outstanding() const { return next_ticket_ - served_; }
+
+  boost::beast::tcp_stream stream_;
+  boost::beast::flat_buffer buffer_;
+  std::string host_key_;
+  std::chrono::steady_clock::time_point idle_since_;
+
+  uint64_t next_ticket_ = 0;  ///< Ticket of the next request assigned
+  uint64_t written_ = 0;      ///< Requests fully written
+  uint64_t served_ = 0;       ///< Responses fully read
+  std::size_t leases_ = 0;    ///< acquire()s not yet released
+  bool broken_ = false;
+  std::vector<std::shared_ptr<boost::asio::steady_timer>> waiters_;
+};
+
+/**
+ * @brief A request's claim on a pooled connection.
+ */
+struct ConnectionLease {
+  std::shared_ptr<PooledConnection> conn;
+  uint64_t ticket = 0;
+  /// Shares the connection with earlier requests: a failure before any
+  /// response byte may just mean the connection went stale.
+  bool reused = false;
+};
+
+/**
+ * @brief Per-io_context pool of keep-alive HTTP connections (an asio
+ * service, so each io_context has exactly one and it dies with it).
+ *
+ * acquire() prefers, in order:
+ * 1. an idle connection to the host that passes a health check,
+ * 2. a new connection while fewer than `max_per_host` are open,
+ * 3. a place in the pipeline of the least busy open connection, up to
+ *    `pipeline_depth` requests deep,
+ * and otherwise waits for a connection to be released. Idle connections are
+ * closed after `idle_timeout_s`.
+ *
+ * =========================================================================
+ * THREAD SAFETY CONTRACT
+ * =========================================================================
+ * - Everything runs on the owning io_context's thread; no locking.
+ * - configure() is process-wide and must run before the io threads start.
+ * =========================================================================
+ */
+class HttpConnectionPool : public boost::asio::execution_context::service {
+ public:
+  static inline boost::asio::execution_context::id id;
+
+  explicit HttpConnectionPool(boost::asio::io_context& ioc);
+
+  static HttpConnectionPool& of(boost::asio::io_context& ioc) {
+    return boost::asio::use_service<HttpConnectionPool>(ioc);
+  }
+
+  static void configure(const config::HttpPoolConfig& cfg);
+
+  /**
+   * @param fresh Skip idle and pipelined connections (retry after a stale
+   * one).
+   */
+  boost::asio::awaitable<std::expected<ConnectionLease, config::ErrorInfo>>
+  acquire(const std::string& host, const std::string& port, bool fresh = false);
+
+  /**
+   * @brief Ends a lease; call exactly once per successful acquire(), after
+   * its response was read or the request failed.
+   */
+  void release(const ConnectionLease& lease);
+
+  static void count_retry();
+  static HttpPoolStats get_stats();
+
+ private:
+  struct HostPool {
+    std::deque<std::shared_ptr<PooledConnection>> idle;  ///< Back = newest
+    std::vector<std::shared_ptr<PooledConnection>> busy;
+    std::size_t connecting = 0;
+    std::deque<std::shared_ptr<boost::asio::steady_timer>> slot_waiters;
+
+    std::size_t open() const { return idle.size() + busy.size() + connecting; }
+  };
+
+  void shutdown() override;
+
+  boost::asio::awaitable<std::expected<void, config::ErrorInfo>> connect(
+      PooledConnection& conn, const std::string& host, const std::string& port);
+
+  static bool is_healthy(PooledConnection& conn);
+  void close(PooledConnection& conn);
+  void evict_idle(HostPool& pool, std::chrono::steady_clock::time_point now);
+  void schedule_sweep();
+  boost::asio::awaitable<void> wait_for_slot(HostPool& pool);
+  static void wake_one(HostPool& pool);
+
+  boost::asio::io_context& ioc_;
+  std::unordered_map<std::string, HostPool> hosts_;
+  boost::asio::steady_timer sweep_timer_;
+  bool sweep_pending_ = false;
+};
+
+}  // namespace hermes::net::http
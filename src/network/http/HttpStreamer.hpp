@@ -8,17 +8,33 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
+#include <cstdint>
 #include <exception>
 #include <expected>
+#include <functional>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "Concepts.hpp"
+#include "HttpConnectionPool.hpp"
 #include "Types.hpp"
 
 namespace hermes::net::http {
 
+/**
+ * @brief What a successful response said about its body.
+ */
+struct ResponseInfo {
+  /// 200, 206 for a Range request, or 412 when the request's If-Match no
+  /// longer holds (nothing is written to the sink then).
+  unsigned status = 0;
+  std::optional<uint64_t> content_length; ///< Bytes written to the sink
+  std::optional<uint64_t> complete_length; ///< Full object size (Content-Range)
+  std::string etag;                       ///< ETag header, verbatim ("" if none)
+};
+
 /**
  * @class HttpStreamer
  * @brief Generic asynchronous HTTP client for streaming responses to sinks.
@@ -27,6 +43,10 @@ namespace hermes::net::http {
  * error handling. It allows any HTTP request to be executed, with the
  * response body being directly piped to any valid Boost Asio AsyncWriteStream
  * (e.g., FileSink, TCP sockets). Designed as a header-only template class.
+ *
+ * Connections come from the io_context's HttpConnectionPool: they are kept
+ * alive between requests and may carry several pipelined requests, so body
+ * reads are bounded by Content-Length and never consume the next response.
  */
 class HttpStreamer {
  public:
@@ -43,11 +63,14 @@ class HttpStreamer {
    * @param ioc The ASIO IO Context to run network operations on.
    */
   explicit HttpStreamer(boost::asio::io_context& ioc)
-      : ioc_(ioc), resolver_(ioc), stream_(ioc) {}
+      : pool_(HttpConnectionPool::of(ioc)) {}
 
   /**
    * @brief Executes a generic HTTP request and streams the response to a sink.
    *
+   * A request that fails on a reused keep-alive connection before any body
+   * byte reached the sink is retried once on a new connection.
+   *
    * @tparam Body The Boost.Beast body type (e.g. empty_body, string_body).
    * @tparam Fields The container type for HTTP headers.
    * @tparam Sink A destination satisfying the AsyncWriteStream concept.
@@ -63,69 +86,160 @@ class HttpStreamer {
   boost::asio::awaitable<std::expected<void, config::ErrorInfo>> execute(
       const std::string& host, const std::string& port,
       boost::beast::http::request<Body, Fields> req, Sink& destination) {
-    stream_.expires_after(NETWORK_TIMEOUT);
-    auto connect_res = co_await connect(host, port);
-    if (!connect_res) co_return std::unexpected(connect_res.error());
+    auto result = co_await fetch(host, port, std::move(req), destination);
+    if (!result) co_return std::unexpected(result.error());
+    co_return std::expected<void, config::ErrorInfo>();
+  }
+
+  /**
+   * @brief Like execute(), but also accepts 206 Partial Content and reports
+   * the response's lengths, for Range requests.
+   * @param on_headers Optional; called with the lengths once the headers of
+   * a successful response are in, before its body is streamed.
+   */
+  template <typename Body, typename Fields, config::AsyncWriteStream Sink>
+  boost::asio::awaitable<std::expected<ResponseInfo, config::ErrorInfo>> fetch(
+      const std::string& host, const std::string& port,
+      boost::beast::http::request<Body, Fields> req, Sink& destination,
+      std::function<void(const ResponseInfo&)> on_headers = {}) {
+    req.keep_alive(true);
+
+    for (int attempt = 0;; ++attempt) {
+      auto lease = co_await pool_.acquire(host, port, attempt > 0);
+      if (!lease) co_return std::unexpected(lease.error());
+
+      bool body_started = false;
+      auto result = co_await exchange(*lease, req, destination, body_started,
+                                      on_headers);
+      pool_.release(*lease);
+
+      if (!result && lease->reused && !body_started && attempt == 0) {
+        spdlog::debug("[HttpStreamer] Stale connection ({}), retrying.",
+                      result.error().message);
+        HttpConnectionPool::count_retry();
+        continue;
+      }
+      co_return result;
+    }
+  }
 
-    stream_.expires_after(NETWORK_TIMEOUT);
+ private:
+  HttpConnectionPool& pool_;
+
+  static std::unexpected<config::ErrorInfo> network_error(std::string message) {
+    return std::unexpected(config::ErrorInfo::From(
+        config::AppError::NetworkError, std::move(message)));
+  }
+
+  /**
+   * @brief One request/response on a leased connection, in pipeline order.
+   * @param body_started Set once the sink may have received bytes (no
+   * retry past that point).
+   */
+  template <typename Body, typename Fields, config::AsyncWriteStream Sink>
+  boost::asio::awaitable<std::expected<ResponseInfo, config::ErrorInfo>> exchange(
+      const ConnectionLease& lease,
+      boost::beast::http::request<Body, Fields>& req, Sink& destination,
+      bool& body_started,
+      const std::function<void(const ResponseInfo&)>& on_headers) {
+    auto& conn = *lease.conn;
+
+    if (!co_await conn.wait_write_turn(lease.ticket))
+      co_return network_error("Connection closed before request was sent");
+
+    // Only the request at the head of the pipeline owns the stream timeout;
+    // later writes would otherwise cut short a body being streamed.
+    if (conn.is_reading(lease.ticket)) {
+      conn.stream().expires_after(NETWORK_TIMEOUT);
+    }
 
     boost::system::error_code ec;
     co_await boost::beast::http::async_write(
-        stream_, req,
+        conn.stream(), req,
         boost::asio::redirect_error(boost::asio::use_awaitable, ec));
-    if (ec)
-      co_return std::unexpected(
-          config::ErrorInfo::From(config::AppError::NetworkError,
-                                  "Write request failed: " + ec.message()));
+    conn.finish_write();
+    if (ec) {
+      conn.mark_broken();
+      co_return network_error("Write request failed: " + ec.message());
+    }
 
-    boost::beast::flat_buffer buffer;
+    if (!co_await conn.wait_read_turn(lease.ticket))
+      co_return network_error("Connection closed before response");
+
+    conn.stream().expires_after(NETWORK_TIMEOUT);
     boost::beast::http::response_parser<boost::beast::http::empty_body> parser;
     parser.body_limit(MAX_HTTP_BODY_SIZE);
 
     co_await boost::beast::http::async_read_header(
-        stream_, buffer, parser,
+        conn.stream(), conn.buffer(), parser,
         boost::asio::redirect_error(boost::asio::use_awaitable, ec));
-    if (ec)
-      co_return std::unexpected(
-          config::ErrorInfo::From(config::AppError::NetworkError,
-                                  "Read header failed: " + ec.message()));
+    if (ec) {
+      conn.mark_broken();
+      co_return network_error("Read header failed: " + ec.message());
+    }
 
-    if (parser.get().result() != boost::beast::http::status::ok) {
-      co_return co_await handle_error_response(std::move(parser), buffer);
+    const auto status = parser.get().result();
+    if (status == boost::beast::http::status::precondition_failed) {
+      // The caller's precondition did its job: an answer, not a failure.
+      co_await read_error_body(conn, std::move(parser));
+      ResponseInfo info;
+      info.status = static_cast<unsigned>(status);
+      co_return info;
+    }
+    if (status != boost::beast::http::status::ok &&
+        status != boost::beast::http::status::partial_content) {
+      co_return co_await handle_error_response(conn, std::move(parser));
     }
 
-    auto expected_size = get_content_length(parser.get());
+    ResponseInfo info;
+    info.status = parser.get().result_int();
+    info.etag = std::string(parser.get()[boost::beast::http::field::etag]);
+    if (status == boost::beast::http::status::partial_content) {
+      info.complete_length = parse_complete_length(
+          parser.get()[boost::beast::http::field::content_range]);
+    }
 
-    stream_.expires_never();
-    co_return co_await stream_to_sink(destination, buffer, expected_size);
-  }
+    // Without a length the body runs to EOF and the connection ends with it.
+    std::optional<size_t> expected_size;
+    if (auto length = parser.content_length()) {
+      expected_size = static_cast<size_t>(*length);
+      info.content_length = *length;
+    }
+    const bool keep_alive =
+        parser.get().keep_alive() && expected_size.has_value();
 
- private:
-  boost::asio::io_context& ioc_;
-  boost::asio::ip::tcp::resolver resolver_;
-  boost::beast::tcp_stream stream_;
+    if (on_headers) {
+      on_headers(info);
+    }
+
+    body_started = true;
+    conn.stream().expires_never();
+    auto result = co_await stream_to_sink(conn, destination, expected_size);
+    if (!result || !keep_alive) {
+      conn.mark_broken();
+    }
+    conn.finish_read();
+    if (!result) co_return std::unexpected(result.error());
+    co_return info;
+  }
 
   /**
-   * @brief Resolves the hostname and establishes a TCP connection.
+   * @brief Object size from a "bytes first-last/complete" Content-Range;
+   * nullopt when the server sends "*" or something malformed.
    */
-  boost::asio::awaitable<std::expected<void, config::ErrorInfo>> connect(
-      const std::string& host, const std::string& port) {
-    boost::system::error_code ec;
-    auto results = co_await resolver_.async_resolve(
-        host, port,
-        boost::asio::redirect_error(boost::asio::use_awaitable, ec));
-    if (ec) {
-      co_return std::unexpected(config::ErrorInfo::From(
-          config::AppError::NetworkError, "Resolve failed: " + ec.message()));
+  static std::optional<uint64_t> parse_complete_length(
+      boost::beast::string_view content_range) {
+    const auto slash = content_range.rfind('/');
+    if (slash == boost::beast::string_view::npos ||
+        slash + 1 == content_range.size()) {
+      return std::nullopt;
     }
-
-    co_await stream_.async_connect(
-        results, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
-    if (ec) {
-      co_return std::unexpected(config::ErrorInfo::From(
-          config::AppError::NetworkError, "Connect failed: " + ec.message()));
+    uint64_t value = 0;
+    for (char c : content_range.substr(slash + 1)) {
+      if (c < '0' || c > '9') return std::nullopt;
+      value = value * 10 + static_cast<uint64_t>(c - '0');
     }
-    co_return std::expected<void, config::ErrorInfo>();
+    return value;
   }
 
   /**
@@ -134,13 +248,30 @@ class HttpStreamer {
    */
   template <typename Parser>
   boost::asio::awaitable<std::unexpected<config::ErrorInfo>>
-  handle_error_response(Parser&& parser, boost::beast::flat_buffer& buffer) {
+  handle_error_response(PooledConnection& conn, Parser&& parser) {
+    const int status = parser.get().result_int();
+    std::string error_body =
+        co_await read_error_body(conn, std::forward<Parser>(parser));
+
+    spdlog::error("HTTP Request Failed [{}]: {}", status, error_body);
+    co_return std::unexpected(config::ErrorInfo::From(
+        config::AppError::NetworkError,
+        "HTTP Error " + std::to_string(status) + ": " + error_body));
+  }
+
+  /**
+   * @brief Reads a non-2xx response body off the connection (keeping a
+   * pipelined connection in step) and returns it as text.
+   */
+  template <typename Parser>
+  boost::asio::awaitable<std::string> read_error_body(PooledConnection& conn,
+                                                      Parser&& parser) {
     boost::beast::http::response_parser<boost::beast::http::string_body>
         error_parser(std::move(parser));
 
     boost::system::error_code ec;
     co_await boost::beast::http::async_read(
-        stream_, buffer, error_parser,
+        conn.stream(), conn.buffer(), error_parser,
         boost::asio::redirect_error(boost::asio::use_awaitable, ec));
 
     std::string error_body = "No Body";
@@ -151,52 +282,47 @@ class HttpStreamer {
       error_body = "Failed to parse error body: " + ec.message();
     }
 
-    int status = error_parser.get().result_int();
-
-    spdlog::error("HTTP Request Failed [{}]: {}", status, error_body);
-    co_return std::unexpected(config::ErrorInfo::From(
-        config::AppError::NetworkError,
-        "HTTP Error " + std::to_string(status) + ": " + error_body));
-  }
-
-  size_t get_content_length(
-      const boost::beast::http::response_header<>& header) {
-    if (auto it = header.find(boost::beast::http::field::content_length);
-        it != header.end()) {
-      return std::stoull(std::string(it->value()));
+    // The error body was read in full, so the connection is still in step.
+    if (ec || !error_parser.get().keep_alive()) {
+      conn.mark_broken();
     }
-    return 0;
+    conn.finish_read();
+    co_return error_body;
   }
 
   /**
    * @brief Flushes any body data caught in the Beast flat_buffer during header
-   * parsing.
+   * parsing. Stops at `limit`: anything after it belongs to the next
+   * pipelined response.
    */
   template <config::AsyncWriteStream Sink>
   boost::asio::awaitable<std::expected<size_t, config::ErrorInfo>>
-  drain_residual_buffer(Sink& sink, boost::beast::flat_buffer& buffer) {
+  drain_residual_buffer(Sink& sink, boost::beast::flat_buffer& buffer,
+                        size_t limit) {
     size_t written = 0;
-    if (buffer.size() > 0) {
+    const size_t count = std::min(buffer.size(), limit);
+    if (count > 0) {
       boost::system::error_code ec;
       written = co_await boost::asio::async_write(
-          sink, buffer.data(),
+          sink, boost::asio::buffer(buffer.data(), count),
           boost::asio::redirect_error(boost::asio::use_awaitable, ec));
       if (ec) {
         co_return std::unexpected(config::ErrorInfo::From(
             config::AppError::NetworkError, "Drain error: " + ec.message()));
       }
-      buffer.consume(buffer.size());
+      buffer.consume(count);
     }
     co_return written;
   }
 
   /**
    * @brief Main transfer loop. Reads from the TCP stream and writes to the Sink
-   * until EOF or target size.
+   * until EOF or target size. Never reads past the target size.
    */
   template <config::AsyncWriteStream Sink>
   boost::asio::awaitable<std::expected<size_t, config::ErrorInfo>>
-  transfer_stream_data(Sink& sink, size_t remaining_size) {
+  transfer_stream_data(PooledConnection& conn, Sink& sink,
+                       std::optional<size_t> remaining_size) {
     size_t total_written = 0;
 
     // OPTIMIZED: Allocated directly on the coroutine frame.
@@ -205,10 +331,15 @@ class HttpStreamer {
     // std::make_shared.
     std::vector<uint8_t> buffer(TRANSFER_CHUNK_SIZE);
 
-    while (remaining_size == 0 || total_written < remaining_size) {
+    while (!remaining_size || total_written < *remaining_size) {
+      const size_t want =
+          remaining_size
+              ? std::min(buffer.size(), *remaining_size - total_written)
+              : buffer.size();
+
       boost::system::error_code ec;
-      size_t bytes_read = co_await stream_.async_read_some(
-          boost::asio::buffer(buffer),
+      size_t bytes_read = co_await conn.stream().async_read_some(
+          boost::asio::buffer(buffer.data(), want),
           boost::asio::redirect_error(boost::asio::use_awaitable, ec));
 
       if (ec == boost::asio::error::eof) break;
@@ -234,29 +365,31 @@ class HttpStreamer {
   /**
    * @brief Orchestrates the draining and streaming phases to fulfill the HTTP
    * body transfer.
+   * @param expected_size Content-Length, or nullopt to read until EOF.
    */
   template <config::AsyncWriteStream Sink>
   boost::asio::awaitable<std::expected<void, config::ErrorInfo>> stream_to_sink(
-      Sink& sink, boost::beast::flat_buffer& buffer, size_t expected_size) {
+      PooledConnection& conn, Sink& sink, std::optional<size_t> expected_size) {
     size_t total_written = 0;
 
-    auto drain_res = co_await drain_residual_buffer(sink, buffer);
+    auto drain_res = co_await drain_residual_buffer(
+        sink, conn.buffer(), expected_size.value_or(SIZE_MAX));
     if (!drain_res) co_return std::unexpected(drain_res.error());
     total_written += *drain_res;
 
-    if (expected_size == 0 || total_written < expected_size) {
-      size_t remaining =
-          (expected_size > 0) ? (expected_size - total_written) : 0;
-      auto transfer_res = co_await transfer_stream_data(sink, remaining);
+    if (!expected_size || total_written < *expected_size) {
+      std::optional<size_t> remaining;
+      if (expected_size) remaining = *expected_size - total_written;
+      auto transfer_res = co_await transfer_stream_data(conn, sink, remaining);
       if (!transfer_res) co_return std::unexpected(transfer_res.error());
       total_written += *transfer_res;
     }
 
-    if (expected_size > 0 && total_written != expected_size) {
+    if (expected_size && total_written != *expected_size) {
       co_return std::unexpected(config::ErrorInfo::From(
           config::AppError::NetworkError,
           std::format("Download truncated. Expected: {}, Got: {}",
-                      expected_size, total_written)));
+                      *expected_size, total_written)));
     }
 
     co_return std::expected<void, config::ErrorInfo>();
@@ -9,6 +9,13 @@
 #include <string>
 #include <sstream>
 
+#include "AssetCache.hpp"
+#include "AwsSigner.hpp"
+#include "BufferPool.hpp"
+#include "DownloadRegistry.hpp"
+#include "HttpConnectionPool.hpp"
+#include "RtcpChannel.hpp"
+#include "TranscodeCache.hpp"
 #include "Types.hpp"
 #include "boost/beast/http/verb.hpp"
 
@@ -270,6 +277,216 @@ std::expected<void, RouteError> Router::handle_metrics(const req_t& req,
       << "# TYPE hermes_available_webrtc_ports gauge\n"
       << "hermes_available_webrtc_ports " << active_.get_available_webrtc_ports_count() << "\n";
 
+  // Per-io_context FrameClock health (lateness rising => core overloaded)
+  auto clocks = pool_->get_frame_clock_stats();
+  oss << "# HELP hermes_frame_clock_sessions Sessions driven by a frame clock.\n"
+      << "# TYPE hermes_frame_clock_sessions gauge\n";
+  for (const auto& c : clocks) {
+    oss << "hermes_frame_clock_sessions{clock=\"" << c.index << "\"} " << c.subscribers << "\n";
+  }
+  oss << "# HELP hermes_frame_clock_ticks_total Ticks dispatched by a frame clock.\n"
+      << "# TYPE hermes_frame_clock_ticks_total counter\n";
+  for (const auto& c : clocks) {
+    oss << "hermes_frame_clock_ticks_total{clock=\"" << c.index << "\"} " << c.ticks << "\n";
+  }
+  oss << "# HELP hermes_frame_clock_late_ticks_total Ticks that fired later than the lateness threshold.\n"
+      << "# TYPE hermes_frame_clock_late_ticks_total counter\n";
+  for (const auto& c : clocks) {
+    oss << "hermes_frame_clock_late_ticks_total{clock=\"" << c.index << "\"} " << c.late_ticks << "\n";
+  }
+  oss << "# HELP hermes_frame_clock_skipped_ticks_total Ticks dropped when the clock resynced.\n"
+      << "# TYPE hermes_frame_clock_skipped_ticks_total counter\n";
+  for (const auto& c : clocks) {
+    oss << "hermes_frame_clock_skipped_ticks_total{clock=\"" << c.index << "\"} " << c.skipped_ticks << "\n";
+  }
+  oss << "# HELP hermes_frame_clock_lateness_us Lateness of the last tick in microseconds.\n"
+      << "# TYPE hermes_frame_clock_lateness_us gauge\n";
+  for (const auto& c : clocks) {
+    oss << "hermes_frame_clock_lateness_us{clock=\"" << c.index << "\"} " << c.last_lateness_us << "\n";
+  }
+  oss << "# HELP hermes_frame_clock_max_lateness_us Worst tick lateness in microseconds.\n"
+      << "# TYPE hermes_frame_clock_max_lateness_us gauge\n";
+  for (const auto& c : clocks) {
+    oss << "hermes_frame_clock_max_lateness_us{clock=\"" << c.index << "\"} " << c.max_lateness_us << "\n";
+  }
+  oss << "# HELP hermes_frame_clock_batch_us Time spent processing the last tick's sessions in microseconds.\n"
+      << "# TYPE hermes_frame_clock_batch_us gauge\n";
+  for (const auto& c : clocks) {
+    oss << "hermes_frame_clock_batch_us{clock=\"" << c.index << "\"} " << c.last_batch_us << "\n";
+  }
+
+  // Per-io_context UDP egress batching (datagrams per syscall = batching win)
+  auto egresses = pool_->get_udp_egress_stats();
+  oss << "# HELP hermes_udp_egress_datagrams_total Datagrams queued on an egress engine.\n"
+      << "# TYPE hermes_udp_egress_datagrams_total counter\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_datagrams_total{egress=\"" << e.index << "\"} " << e.datagrams << "\n";
+  }
+  oss << "# HELP hermes_udp_egress_syscalls_total Send syscalls issued by an egress engine.\n"
+      << "# TYPE hermes_udp_egress_syscalls_total counter\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_syscalls_total{egress=\"" << e.index << "\"} " << e.syscalls << "\n";
+  }
+  oss << "# HELP hermes_udp_egress_fallback_sends_total Datagrams sent asynchronously after a full socket buffer.\n"
+      << "# TYPE hermes_udp_egress_fallback_sends_total counter\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_fallback_sends_total{egress=\"" << e.index << "\"} " << e.fallback_sends << "\n";
+  }
+  oss << "# HELP hermes_udp_egress_send_errors_total Datagrams the kernel rejected.\n"
+      << "# TYPE hermes_udp_egress_send_errors_total counter\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_send_errors_total{egress=\"" << e.index << "\"} " << e.send_errors << "\n";
+  }
+  oss << "# HELP hermes_udp_egress_batch_size Datagrams in the last flushed batch.\n"
+      << "# TYPE hermes_udp_egress_batch_size gauge\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_batch_size{egress=\"" << e.index << "\"} " << e.last_batch_size << "\n";
+  }
+  // Encryption pass: packets/s per core = rate(packets) / rate(us) * 1e6
+  oss << "# HELP hermes_udp_egress_encrypted_packets_total Payloads encrypted by the batch pass.\n"
+      << "# TYPE hermes_udp_egress_encrypted_packets_total counter\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_encrypted_packets_total{egress=\"" << e.index << "\"} " << e.encrypted_packets << "\n";
+  }
+  oss << "# HELP hermes_udp_egress_encrypt_us_total Time spent in the batch encryption pass in microseconds.\n"
+      << "# TYPE hermes_udp_egress_encrypt_us_total counter\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_encrypt_us_total{egress=\"" << e.index << "\"} " << e.encrypt_ns / 1000 << "\n";
+  }
+  oss << "# HELP hermes_udp_egress_keystream_prefetches_total SRTP packet keystreams generated between ticks.\n"
+      << "# TYPE hermes_udp_egress_keystream_prefetches_total counter\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_keystream_prefetches_total{egress=\"" << e.index << "\"} " << e.keystream_prefetches << "\n";
+  }
+  oss << "# HELP hermes_udp_egress_prefetch_us_total Time spent prefetching SRTP keystream in microseconds.\n"
+      << "# TYPE hermes_udp_egress_prefetch_us_total counter\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_prefetch_us_total{egress=\"" << e.index << "\"} " << e.prefetch_ns / 1000 << "\n";
+  }
+  oss << "# HELP hermes_udp_egress_received_total Datagrams received on egress sockets (RTCP feedback).\n"
+      << "# TYPE hermes_udp_egress_received_total counter\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_received_total{egress=\"" << e.index << "\"} " << e.datagrams_received << "\n";
+  }
+  oss << "# HELP hermes_udp_egress_multicast_sockets Open per-target multicast sockets.\n"
+      << "# TYPE hermes_udp_egress_multicast_sockets gauge\n";
+  for (const auto& e : egresses) {
+    oss << "hermes_udp_egress_multicast_sockets{egress=\"" << e.index << "\"} " << e.multicast_lanes << "\n";
+  }
+
+  // Incoming RTCP
+  auto rtcp = hermes::net::rtp::RtcpRouter::instance().get_stats();
+  oss << "# HELP hermes_rtcp_received_total RTCP packets received.\n"
+      << "# TYPE hermes_rtcp_received_total counter\n"
+      << "hermes_rtcp_received_total " << rtcp.received << "\n"
+      << "# HELP hermes_rtcp_malformed_total RTCP packets that failed to parse.\n"
+      << "# TYPE hermes_rtcp_malformed_total counter\n"
+      << "hermes_rtcp_malformed_total " << rtcp.malformed << "\n"
+      << "# HELP hermes_rtcp_unmatched_total RTCP reports about no active stream.\n"
+      << "# TYPE hermes_rtcp_unmatched_total counter\n"
+      << "hermes_rtcp_unmatched_total " << rtcp.unmatched << "\n";
+
+  // Shared decoded-asset cache
+  auto cache = hermes::infra::AssetCache::instance().get_stats();
+  oss << "# HELP hermes_asset_cache_hits_total Asset lookups served from memory.\n"
+      << "# TYPE hermes_asset_cache_hits_total counter\n"
+      << "hermes_asset_cache_hits_total " << cache.hits << "\n"
+      << "# HELP hermes_asset_cache_misses_total Asset lookups that had to read the file.\n"
+      << "# TYPE hermes_asset_cache_misses_total counter\n"
+      << "hermes_asset_cache_misses_total " << cache.misses << "\n"
+      << "# HELP hermes_asset_cache_evictions_total Assets evicted to stay within capacity.\n"
+      << "# TYPE hermes_asset_cache_evictions_total counter\n"
+      << "hermes_asset_cache_evictions_total " << cache.evictions << "\n"
+      << "# HELP hermes_asset_cache_entries Assets currently resident.\n"
+      << "# TYPE hermes_asset_cache_entries gauge\n"
+      << "hermes_asset_cache_entries " << cache.entries << "\n"
+      << "# HELP hermes_asset_cache_bytes Decoded PCM bytes currently resident.\n"
+      << "# TYPE hermes_asset_cache_bytes gauge\n"
+      << "hermes_asset_cache_bytes " << cache.bytes << "\n";
+
+  // Background conversion of downloads to canonical PCM / A-law
+  auto transcode = hermes::infra::TranscodeCache::instance().get_stats();
+  oss << "# HELP hermes_transcode_completed_total Assets converted to canonical PCM.\n"
+      << "# TYPE hermes_transcode_completed_total counter\n"
+      << "hermes_transcode_completed_total " << transcode.completed << "\n"
+      << "# HELP hermes_transcode_skipped_total Assets that needed no conversion.\n"
+      << "# TYPE hermes_transcode_skipped_total counter\n"
+      << "hermes_transcode_skipped_total " << transcode.skipped << "\n"
+      << "# HELP hermes_transcode_failed_total Conversions that failed.\n"
+      << "# TYPE hermes_transcode_failed_total counter\n"
+      << "hermes_transcode_failed_total " << transcode.failed << "\n"
+      << "# HELP hermes_transcode_pending Conversions queued or running.\n"
+      << "# TYPE hermes_transcode_pending gauge\n"
+      << "hermes_transcode_pending " << transcode.pending << "\n";
+
+  // Single-flight asset downloads
+  auto downloads = hermes::infra::DownloadRegistry::instance().get_stats();
+  oss << "# HELP hermes_download_started_total Asset downloads actually issued.\n"
+      << "# TYPE hermes_download_started_total counter\n"
+      << "hermes_download_started_total " << downloads.started << "\n"
+      << "# HELP hermes_download_failed_total Asset downloads that failed.\n"
+      << "# TYPE hermes_download_failed_total counter\n"
+      << "hermes_download_failed_total " << downloads.failed << "\n"
+      << "# HELP hermes_download_hits_total Asset requests already on disk.\n"
+      << "# TYPE hermes_download_hits_total counter\n"
+      << "hermes_download_hits_total " << downloads.hits << "\n"
+      << "# HELP hermes_download_waits_total Asset requests that joined an in-flight download.\n"
+      << "# TYPE hermes_download_waits_total counter\n"
+      << "hermes_download_waits_total " << downloads.waits << "\n"
+      << "# HELP hermes_download_bytes_saved_total Bytes joined requests did not download again.\n"
+      << "# TYPE hermes_download_bytes_saved_total counter\n"
+      << "hermes_download_bytes_saved_total " << downloads.bytes_saved << "\n"
+      << "# HELP hermes_download_in_flight Asset downloads currently running.\n"
+      << "# TYPE hermes_download_in_flight gauge\n"
+      << "hermes_download_in_flight " << downloads.in_flight << "\n";
+
+  // Keep-alive S3 connections
+  auto http_pool = hermes::net::http::HttpConnectionPool::get_stats();
+  oss << "# HELP hermes_http_pool_connects_total HTTP connections opened.\n"
+      << "# TYPE hermes_http_pool_connects_total counter\n"
+      << "hermes_http_pool_connects_total " << http_pool.connects << "\n"
+      << "# HELP hermes_http_pool_reuses_total Requests sent on an idle keep-alive connection.\n"
+      << "# TYPE hermes_http_pool_reuses_total counter\n"
+      << "hermes_http_pool_reuses_total " << http_pool.reuses << "\n"
+      << "# HELP hermes_http_pool_pipelined_total Requests pipelined behind another.\n"
+      << "# TYPE hermes_http_pool_pipelined_total counter\n"
+      << "hermes_http_pool_pipelined_total " << http_pool.pipelined << "\n"
+      << "# HELP hermes_http_pool_waits_total Requests that waited for a free connection.\n"
+      << "# TYPE hermes_http_pool_waits_total counter\n"
+      << "hermes_http_pool_waits_total " << http_pool.waits << "\n"
+      << "# HELP hermes_http_pool_evictions_total Idle connections closed (timeout or failed health check).\n"
+      << "# TYPE hermes_http_pool_evictions_total counter\n"
+      << "hermes_http_pool_evictions_total " << http_pool.evictions << "\n"
+      << "# HELP hermes_http_pool_retries_total Requests retried after a stale connection.\n"
+      << "# TYPE hermes_http_pool_retries_total counter\n"
+      << "hermes_http_pool_retries_total " << http_pool.retries << "\n"
+      << "# HELP hermes_http_pool_open Connections currently open.\n"
+      << "# TYPE hermes_http_pool_open gauge\n"
+      << "hermes_http_pool_open " << http_pool.open << "\n";
+
+  // S3 request signing
+  auto signer = hermes::net::s3::AwsSigner::get_stats();
+  oss << "# HELP hermes_s3_signatures_total S3 requests signed.\n"
+      << "# TYPE hermes_s3_signatures_total counter\n"
+      << "hermes_s3_signatures_total " << signer.signatures << "\n"
+      << "# HELP hermes_s3_signing_key_derivations_total SigV4 signing keys derived (per thread, per day).\n"
+      << "# TYPE hermes_s3_signing_key_derivations_total counter\n"
+      << "hermes_s3_signing_key_derivations_total " << signer.key_derivations
+      << "\n";
+
+  // Recycled streaming blocks (reuses vs allocations = pooling hit rate)
+  auto blocks = hermes::infra::BufferPool::get_total_stats();
+  oss << "# HELP hermes_buffer_pool_blocks Streaming buffer blocks by state.\n"
+      << "# TYPE hermes_buffer_pool_blocks gauge\n"
+      << "hermes_buffer_pool_blocks{state=\"in_use\"} " << blocks.in_use << "\n"
+      << "hermes_buffer_pool_blocks{state=\"idle\"} " << blocks.idle << "\n"
+      << "# HELP hermes_buffer_pool_allocations_total Blocks allocated fresh from the heap.\n"
+      << "# TYPE hermes_buffer_pool_allocations_total counter\n"
+      << "hermes_buffer_pool_allocations_total " << blocks.allocations << "\n"
+      << "# HELP hermes_buffer_pool_reuses_total Blocks recycled from finished sessions.\n"
+      << "# TYPE hermes_buffer_pool_reuses_total counter\n"
+      << "hermes_buffer_pool_reuses_total " << blocks.reuses << "\n";
+
   // Per-session RTP stats
   auto stats = active_.get_all_session_rtp_stats();
   if (!stats.empty()) {
@@ -284,6 +501,33 @@ std::expected<void, RouteError> Router::handle_metrics(const req_t& req,
     for (const auto& s : stats) {
       oss << "hermes_rtp_packets_sent_total{session_id=\"" << s.id << "\"} " << s.packets_sent << "\n";
     }
+
+    // Per-client link quality from RTCP receiver reports
+    auto client_metric = [&](const char* name, const char* help,
+                             const char* type, auto&& value) {
+      oss << "# HELP " << name << " " << help << "\n"
+          << "# TYPE " << name << " " << type << "\n";
+      for (const auto& s : stats) {
+        for (const auto& c : s.clients) {
+          oss << name << "{session_id=\"" << s.id << "\",client=\"" << c.endpoint
+              << "\"} " << value(c) << "\n";
+        }
+      }
+    };
+    client_metric("hermes_rtcp_fraction_lost",
+                  "Fraction of packets lost (0-1) in the last RTCP report interval.",
+                  "gauge", [](const auto& c) { return c.fraction_lost; });
+    client_metric("hermes_rtcp_cumulative_lost",
+                  "Packets lost since the stream started, per RTCP.", "gauge",
+                  [](const auto& c) { return c.cumulative_lost; });
+    client_metric("hermes_rtcp_jitter_ms", "Interarrival jitter in milliseconds.",
+                  "gauge", [](const auto& c) { return c.jitter_ms; });
+    client_metric("hermes_rtcp_rtt_ms",
+                  "Round-trip time from RTCP LSR/DLSR in milliseconds (-1 = unknown).",
+                  "gauge", [](const auto& c) { return c.rtt_ms; });
+    client_metric("hermes_rtcp_nacked_packets_total",
+                  "Packets a client requested again with a generic NACK.",
+                  "counter", [](const auto& c) { return c.nacked_packets; });
   }
 
   ResponseBuilder::build_plaintext_response(res, oss.str(), req.version(), req.keep_alive());
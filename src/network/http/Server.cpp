@@ -12,7 +12,7 @@ using namespace hermes::infra;
 namespace hermes::net {
 std::expected<std::unique_ptr<Server>, ErrorInfo> Server::create(
     boost::asio::io_context& main_ioc, const hermes::config::AppConfig& cfg) {
-  auto pool_result = IoContextPool::create(cfg.server.threads);
+  auto pool_result = IoContextPool::create(cfg.server.threads, cfg.egress);
   if (!pool_result) {
     return std::unexpected(pool_result.error());
   }
@@ -1,16 +1,18 @@
 #pragma once
+#include <algorithm>
 #include <span>
 
 #include "CodecStrategy.hpp"
 #include "EncryptionStrategy.hpp"
 #include "RTPPacketizer.hpp"
+#include "RtpHeaderWriter.hpp"
 #include "spdlog/spdlog.h"
 /**
  * @brief Assembles RTP packets in-place (zero-copy) to avoid allocation.
  */
 namespace hermes::net::rtp {
 
-static constexpr size_t RTP_HEADER_SIZE = 12;
+static constexpr size_t RTP_HEADER_SIZE = PlainRtpHeader::SIZE;
 
 inline size_t packet_to_rtp(std::span<const uint8_t> pcmFrame,
                             RTPPacketizer& packetizer,
@@ -34,4 +36,22 @@ inline size_t packet_to_rtp(std::span<const uint8_t> pcmFrame,
   auto actual_payload = payload_buffer.first(encoded_size);
   return packetizer.packetize(actual_payload, outBuffer, encryptor);
 }
+
+/**
+ * @brief Same as packet_to_rtp() for a payload that is already encoded: it
+ * is copied in place of the encoder output.
+ */
+inline size_t encoded_to_rtp(std::span<const uint8_t> payload,
+                             RTPPacketizer& packetizer,
+                             crypto::IEncryptionStrategy* encryptor,
+                             std::span<uint8_t> outBuffer) {
+  if (outBuffer.size() < RTP_HEADER_SIZE + payload.size() || payload.empty()) {
+    spdlog::error("[PacketUtils] Buffer too small for payload");
+    return 0;
+  }
+
+  auto payload_buffer = outBuffer.subspan(RTP_HEADER_SIZE, payload.size());
+  std::copy(payload.begin(), payload.end(), payload_buffer.begin());
+  return packetizer.packetize(payload_buffer, outBuffer, encryptor);
+}
 }  // namespace hermes::net::rtp
@@ -1,11 +1,13 @@
 #include "RTPPacketizer.hpp"
 
-#include <Packet.hpp>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <random>
+#include <span>
 
 #include "EncryptionStrategy.hpp"
+#include "RtpHeaderWriter.hpp"
 #include "boost/core/span.hpp"
 namespace hermes::net::rtp {
 RTPPacketizer::RTPPacketizer(uint8_t payload_type, uint32_t ssrc,  // NOLINT
@@ -37,8 +39,20 @@ RTPPacketizer::RTPPacketizer(uint8_t payload_type, uint32_t ssrc,  // NOLINT
 size_t RTPPacketizer::packetize(boost::span<uint8_t> payload,  // NOLINT
                                 boost::span<uint8_t> out_buffer,  // NOLINT
                                 crypto::IEncryptionStrategy* ency) {
+  const size_t packet_size = PlainRtpHeader::SIZE + payload.size();
+  if (out_buffer.size() < packet_size) {
+    return 0;
+  }
+
   uint16_t current_seq = sequence_num_;
 
+  // The index is taken before the ROC moves: the packet carrying 0xFFFF
+  // still belongs to the old cycle (RFC 3711 §3.3.1). Legacy receivers were
+  // built against the old order and take it after.
+  constexpr int ROC_SHIFT = 16;
+  if (!legacy_index_) {
+    last_index_ = (static_cast<uint64_t>(roc_) << ROC_SHIFT) | current_seq;
+  }
 
   sequence_num_++;
 
@@ -46,33 +60,31 @@ size_t RTPPacketizer::packetize(boost::span<uint8_t> payload,  // NOLINT
   if (sequence_num_ == 0) {
     roc_++;
   }
-
-  RTPPacket::Header hdr{/* padding */ false,
-                        version_,
-                        /* payload_type */ payload_type_,
-                        /* marker */ false,
-                        current_seq,
-                        timestamp_,
-                        ssrc_,
-                        /* csrc_list */ {},
-                        /* extension */ std::nullopt};
+  if (legacy_index_) {
+    last_index_ = (static_cast<uint64_t>(roc_) << ROC_SHIFT) | current_seq;
+  }
 
   if (ency != nullptr) {
-    constexpr int ROC_SHIFT = 16;
-    uint64_t packet_index = (static_cast<uint64_t>(roc_) << ROC_SHIFT) | current_seq;
-    ency->encrypt(payload, packet_index);
+    ency->encrypt(payload, last_index_);
   }
 
-  RTPPacket packet{std::move(hdr), payload};
-
-  auto maybe_span = packet.to_buffer(out_buffer);
-
-  if (!maybe_span) {
-    return 0;
+  // Header written in place; the payload is usually already right behind it
+  // (PacketUtils encodes straight into the output buffer).
+  std::span<uint8_t> out(out_buffer.data(), out_buffer.size());
+  PlainRtpHeader::write(out, RtpFixedHeader{payload_type_, /* marker */ false,
+                                            current_seq, timestamp_, ssrc_});
+  uint8_t* payload_dst = out.data() + PlainRtpHeader::SIZE;
+  if (payload.data() != payload_dst) {
+    std::memmove(payload_dst, payload.data(), payload.size());
   }
 
   timestamp_ += timestamp_increment_;
-  return maybe_span->size();
+  return packet_size;
+}
+
+uint64_t RTPPacketizer::next_packet_index() const {
+  constexpr int ROC_SHIFT = 16;
+  return (static_cast<uint64_t>(roc_) << ROC_SHIFT) | sequence_num_;
 }
 
 void RTPPacketizer::update_timestamp() { timestamp_ += timestamp_increment_; }
@@ -80,4 +92,10 @@ void RTPPacketizer::update_timestamp() { timestamp_ += timestamp_increment_; }
 uint32_t RTPPacketizer::current_timestamp() const { return timestamp_; }
 
 uint32_t RTPPacketizer::current_ssrc() const { return ssrc_; }
+
+void RTPPacketizer::set_payload_format(uint8_t payload_type,
+                                       uint32_t timestamp_increment) {
+  payload_type_ = payload_type;
+  timestamp_increment_ = timestamp_increment;
+}
 }  // namespace hermes::net::rtp
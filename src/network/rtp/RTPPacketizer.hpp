@@ -18,8 +18,10 @@ class RTPPacketizer {
                 uint32_t timestamp_increment);
 
   /**
-   * @brief Serializes payload + header into the output buffer.
-   * @return The total size of the packet (Header + Payload) in bytes.
+   * @brief Serializes payload + header into the output buffer. The fixed
+   * header is written in place (PlainRtpHeader), without heap objects.
+   * @return The total size of the packet (Header + Payload) in bytes, or 0
+   * if 'out_buffer' is too small.
    * @warning 'out_buffer' must be at least 12 bytes larger than 'payload'.
    */
   size_t packetize(boost::span<uint8_t> payload,
@@ -28,6 +30,12 @@ class RTPPacketizer {
 
   void encrypt();
 
+  /**
+   * @brief Switches payload type and timestamp step (codec change before the
+   * first packet). SSRC, sequence and timestamp continue unchanged.
+   */
+  void set_payload_format(uint8_t payload_type, uint32_t timestamp_increment);
+
   /** @brief Advances the internal timestamp by the increment value. */
   void update_timestamp();
 
@@ -35,11 +43,32 @@ class RTPPacketizer {
   uint32_t current_timestamp() const;
   uint32_t current_ssrc() const;
 
+  /** @brief RTP timestamp of the last packetized packet (for RTCP SRs). */
+  uint32_t last_timestamp() const { return timestamp_ - timestamp_increment_; }
+
+  /**
+   * @brief SRTP index (ROC << 16 | SEQ) of the last packetized packet, for
+   * callers that encrypt the payload later (batched encryption).
+   */
+  uint64_t last_packet_index() const { return last_index_; }
+
+  /** @brief SRTP index the next packetize() call will use. */
+  uint64_t next_packet_index() const;
+
+  /**
+   * @brief Legacy (non-SRTP) encryption: index the packet after the ROC
+   * moved, as the legacy receivers expect (the packet carrying SEQ 0xFFFF
+   * gets the next cycle's ROC). Off by default (RFC 3711 indexing).
+   */
+  void set_legacy_index(bool legacy) { legacy_index_ = legacy; }
+
  private:
   uint8_t payload_type_;
   uint32_t ssrc_;
   uint16_t sequence_num_ = 0;
   uint32_t roc_ = 0;
+  uint64_t last_index_ = 0;
+  bool legacy_index_ = false;
   uint32_t timestamp_ = 0;
   uint32_t timestamp_increment_;
 
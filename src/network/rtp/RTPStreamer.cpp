@@ -14,78 +14,223 @@
 
 namespace hermes::net::rtp {
 
+namespace {
+
+config::RtcpConfig& rtcp_settings() {
+  static config::RtcpConfig cfg;
+  return cfg;
+}
+
+}  // namespace
+
+void RTPStreamer::configure(const config::RtcpConfig& cfg) {
+  rtcp_settings() = cfg;
+  if (!cfg.enabled) {
+    spdlog::info("[RTCP] Disabled.");
+    return;
+  }
+
+  infra::UdpEgress::set_datagram_handler(
+      [](std::span<const uint8_t> datagram, const udp::endpoint& from) {
+        RtcpRouter::instance().dispatch(datagram, from);
+      });
+  spdlog::info("[RTCP] Sender reports every {} ms, {}.", cfg.interval_ms,
+               cfg.mux ? "muxed on the RTP port" : "on RTP port + 1");
+}
+
  std::unique_ptr<RTPStreamer> RTPStreamer::create(
-    boost::asio::io_context& io, const config::CryptoConfig& crypto_cfg) {
-  return std::make_unique<RTPStreamer>(io, crypto_cfg);
+    infra::UdpEgress& egress, const config::CryptoConfig& crypto_cfg,
+    const config::FrameGeometry& geometry) {
+  return std::make_unique<RTPStreamer>(egress, crypto_cfg, geometry);
 }
 
-RTPStreamer::RTPStreamer(boost::asio::io_context& io,
-                         const hermes::config::CryptoConfig& crypto_cfg)
-    : socket_(io,
-              boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), 0)),
+RTPStreamer::RTPStreamer(infra::UdpEgress& egress,
+                         const hermes::config::CryptoConfig& crypto_cfg,
+                         const config::FrameGeometry& geometry)
+    : egress_(egress),
+      lane_(egress.assign_lane()),
+      counters_(std::make_shared<infra::EgressCounters>()),
+      geometry_(geometry),
+      max_packet_size_(config::RTP_HEADER_SIZE + geometry.frame_bytes()),
       session_master_key_(crypto_cfg.master_key),
-      session_salt_(crypto_cfg.salt) {
-  codec_ = std::make_unique<audio::ALawCodecStrategy>();
+      session_salt_(crypto_cfg.salt),
+      use_srtp_(crypto_cfg.srtp) {
+  codec_ = std::make_unique<audio::ALawCodecStrategy>(audio::ALawVariant::Simd,
+                                                      geometry_.sample_rate);
   packetizer_ = std::make_unique<RTPPacketizer>(
       codec_->get_payload_type(), generate_ssrc(),
-      codec_->get_timestamp_increment(config::FRAME_SIZE_BYTES));
+      codec_->get_timestamp_increment(geometry_.frame_bytes()));
 
-  for (int i = 0; i < RING_BUFFER_SIZE; ++i) {
-    packet_ring_[i] = std::make_shared<std::vector<uint8_t>>(
-        RTP_HEADER_SIZE + config::FRAME_SIZE_BYTES);
+  const auto& rtcp_cfg = rtcp_settings();
+  if (rtcp_cfg.enabled) {
+    rtcp_ = std::make_shared<RtcpChannel>(
+        packetizer_->current_ssrc(), codec_->get_clock_rate(),
+        std::chrono::milliseconds(rtcp_cfg.interval_ms));
+    rtcp_counters_ = std::make_shared<infra::EgressCounters>();
+    RtcpRouter::instance().add(rtcp_);
+    rtcp_enabled_ = true;
   }
 }
 
-void RTPStreamer::add_client(const std::string& host_or_ip, uint16_t port,
-                             double packet_loss_ratio) {
+RTPStreamer::~RTPStreamer() {
+  if (rtcp_) {
+    RtcpRouter::instance().remove(rtcp_.get());
+  }
+
+  std::vector<std::size_t> lanes;
+  for (const auto& client : clients_) {
+    if (client.owns_lane) {
+      lanes.push_back(client.lane);
+    }
+  }
+  release_lanes_later(std::move(lanes));
+}
+
+void RTPStreamer::release_lanes_later(std::vector<std::size_t> lanes) {
+  if (lanes.empty()) {
+    return;
+  }
+  // The egress outlives every stream (IoContextPool), so `egress` is safe.
+  asio::post(egress_.get_io_context(),
+             [&egress = egress_, lanes = std::move(lanes)] {
+               for (auto lane : lanes) {
+                 egress.release_lane(lane);
+               }
+             });
+}
+
+bool RTPStreamer::set_codec(audio::CodecKind kind) {
+  auto codec = audio::create_codec_strategy(kind, geometry_.sample_rate);
+  if (!codec) {
+    spdlog::error("Codec {} unavailable: {}", audio::to_string(kind),
+                  codec.error());
+    return false;
+  }
+
+  codec_ = std::move(*codec);
+  packetizer_->set_payload_format(
+      codec_->get_payload_type(),
+      codec_->get_timestamp_increment(geometry_.frame_bytes()));
+  if (rtcp_) {
+    rtcp_->set_clock_rate(codec_->get_clock_rate());
+  }
+  spdlog::info("RTP codec: {} (PT {}, {} Hz clock)", codec_->get_name(),
+               codec_->get_payload_type(), codec_->get_clock_rate());
+  return true;
+}
+
+std::optional<udp::endpoint> RTPStreamer::resolve(const std::string& host_or_ip,
+                                                  uint16_t port) {
   boost::system::error_code ec;
   auto addr = boost::asio::ip::make_address(host_or_ip, ec);
-  udp::endpoint ep;
-
   if (!ec) {
-    ep = udp::endpoint(addr, port);
-  } else {
-    asio::ip::udp::resolver resolver(socket_.get_executor());
-    auto results = resolver.resolve(asio::ip::udp::v4(), host_or_ip,
-                                    std::to_string(port), ec);
-    if (ec || results.empty()) {
-      spdlog::error("Invalid IP or Hostname: {} - {}", host_or_ip,
-                    ec.message());
-      return;
-    }
-    ep = *results.begin();
+    return udp::endpoint(addr, port);
+  }
+
+  asio::ip::udp::resolver resolver(egress_.get_io_context());
+  auto results = resolver.resolve(asio::ip::udp::v4(), host_or_ip,
+                                  std::to_string(port), ec);
+  if (ec || results.empty()) {
+    spdlog::error("Invalid IP or Hostname: {} - {}", host_or_ip, ec.message());
+    return std::nullopt;
+  }
+  return *results.begin();
+}
+
+void RTPStreamer::add_client(const std::string& host_or_ip, uint16_t port,
+                             double packet_loss_ratio) {
+  auto ep = resolve(host_or_ip, port);
+  if (!ep) {
+    return;
   }
 
   if (std::find_if(clients_.begin(), clients_.end(),
                    [&ep](const RtpClientTarget& client) {
-                     return client.endpoint == ep;
+                     return client.endpoint == *ep;
                    }) == clients_.end()) {
-    clients_.push_back({ep, packet_loss_ratio});
+    clients_.push_back({*ep, packet_loss_ratio, lane_});
+    update_rtcp_destinations();
     spdlog::info("RTP Client added: {}:{} (Loss: {}%)",
-                 ep.address().to_string(), port, packet_loss_ratio * 100.0);
+                 ep->address().to_string(), port, packet_loss_ratio * 100.0);
+  }
+}
+
+bool RTPStreamer::add_multicast_client(const std::string& group, uint16_t port,
+                                       const config::MulticastConfig& cfg,
+                                       double packet_loss_ratio) {
+  boost::system::error_code ec;
+  auto address = asio::ip::make_address_v4(group, ec);
+  if (ec || !address.is_multicast()) {
+    spdlog::error("Not an IPv4 multicast group: {}", group);
+    return false;
   }
+
+  udp::endpoint ep(address, port);
+  if (std::ranges::find(clients_, ep, &RtpClientTarget::endpoint) !=
+      clients_.end()) {
+    return true;
+  }
+
+  auto lane = egress_.open_multicast_lane(cfg);
+  if (!lane) {
+    spdlog::error("Multicast socket for {}:{} rejected: {}", group, port,
+                  lane.error().message());
+    return false;
+  }
+
+  clients_.push_back({ep, packet_loss_ratio, *lane, true});
+  update_rtcp_destinations();
+  spdlog::info("RTP Multicast group added: {}:{} (TTL {}, interface {}, "
+               "loopback {})",
+               group, port, cfg.ttl,
+               cfg.interface_address.empty() ? "default"
+                                             : cfg.interface_address,
+               cfg.loopback);
+  return true;
+}
+
+void RTPStreamer::update_rtcp_destinations() {
+  if (!rtcp_) {
+    return;
+  }
+
+  const bool mux = rtcp_settings().mux;
+  std::vector<udp::endpoint> rtp_endpoints;
+  rtcp_endpoints_.clear();
+  for (const auto& client : clients_) {
+    rtp_endpoints.push_back(client.endpoint);
+    udp::endpoint rtcp_endpoint = client.endpoint;
+    if (!mux) {
+      rtcp_endpoint.port(static_cast<uint16_t>(client.endpoint.port() + 1));
+    }
+    rtcp_endpoints_.push_back(rtcp_endpoint);
+  }
+
+  // Pointers last: rtcp_endpoints_ is final now.
+  rtcp_destinations_.clear();
+  for (std::size_t i = 0; i < clients_.size(); ++i) {
+    rtcp_destinations_.push_back({&rtcp_endpoints_[i], clients_[i].lane});
+  }
+  rtcp_->set_destinations(rtp_endpoints);
 }
 
 void RTPStreamer::remove_client(const std::string& host_or_ip, uint16_t port) {
   try {
-    boost::system::error_code ec;
-    auto addr = asio::ip::make_address(host_or_ip, ec);
-    udp::endpoint ep;
-
-    if (!ec) {
-      ep = udp::endpoint(addr, port);
-    } else {
-      asio::ip::udp::resolver resolver(socket_.get_executor());
-      auto results = resolver.resolve(asio::ip::udp::v4(), host_or_ip,
-                                      std::to_string(port), ec);
-      if (ec || results.empty()) {
-        return;
-      }
-      ep = *results.begin();
+    auto ep = resolve(host_or_ip, port);
+    if (!ep) {
+      return;
     }
 
-    std::erase(clients_, ep);
-    spdlog::info("RTP Client removed: {}:{}", ep.address().to_string(), port);
+    auto it = std::ranges::find(clients_, *ep, &RtpClientTarget::endpoint);
+    if (it == clients_.end()) {
+      return;
+    }
+    if (it->owns_lane) {
+      release_lanes_later({it->lane});
+    }
+    clients_.erase(it);
+    update_rtcp_destinations();
+    spdlog::info("RTP Client removed: {}:{}", ep->address().to_string(), port);
   } catch (const std::exception& e) {
     spdlog::trace("Ignored exception during client removal: {}", e.what());
   }
@@ -132,48 +277,136 @@ std::vector<uint8_t> RTPStreamer::derive_session_key(uint32_t ssrc) {
 void RTPStreamer::setup_security() {
   const auto& ssrc = packetizer_->current_ssrc();
   spdlog::debug("SSRC is {}", ssrc);
+
+  if (use_srtp_) {
+    srtp_ = std::make_shared<crypto::SrtpSender>(
+        session_master_key_,
+        std::span(session_salt_).first(crypto::SRTP_MASTER_SALT_SIZE), ssrc,
+        packetizer_->next_packet_index(), geometry_.frame_bytes());
+    egress_.add_srtp_sender(srtp_);
+    encryption_enabled_ = true;
+    if (rtcp_enabled_) {
+      // Clients of an SRTP stream expect SRTCP, which we do not implement:
+      // better no RTCP than reports they will reject.
+      RtcpRouter::instance().remove(rtcp_.get());
+      rtcp_enabled_ = false;
+      spdlog::debug("RTCP off for SRTP stream {}", ssrc);
+    }
+    spdlog::info("RTP Security Layer initialized (SRTP AES_CM_128_HMAC_SHA1_80)");
+    return;
+  }
   encryptor_ = crypto::create_aes_encryption_strategy(
       derive_session_key(ssrc), derive_iv_from_ssrc(ssrc));
+  packetizer_->set_legacy_index(true);
+  pending_encryption_ = infra::PendingEncryption{encryptor_, RTP_HEADER_SIZE, 0};
   encryption_enabled_ = true;
   spdlog::info("RTP Security Layer initialized successfully");
 }
 
-void RTPStreamer::send_frame(std::span<const uint8_t> pcm_frame) {
+bool RTPStreamer::select_destinations() {
   if (clients_.empty()) {
-    return;
-  }
-
-  auto packet_owner = packet_ring_[ring_index_];
-  ring_index_ = (ring_index_ + 1) % RING_BUFFER_SIZE;
-  std::span<uint8_t> packet_span(*packet_owner);
-
-  size_t packet_size = packet_to_rtp(pcm_frame, *packetizer_, *codec_,
-                                     encryptor_.get(), packet_span);
-  if (packet_size == 0) {
-    return;
+    return false;
   }
 
   static thread_local std::mt19937 gen(std::random_device{}());
   std::uniform_real_distribution<double> dist(0.0, 1.0);
 
+  pending_.clear();
   for (const auto& client : clients_) {
     if (client.packet_loss_ratio > 0.0) {
       if (dist(gen) < client.packet_loss_ratio) {
         continue;
       }
     }
+    pending_.push_back({&client.endpoint, client.lane});
+  }
+  return true;
+}
+
+void RTPStreamer::send_frame(std::span<const uint8_t> pcm_frame) {
+  if (!select_destinations()) {
+    return;
+  }
+
+  // Packetize straight into the egress batch; the packet is stored once and
+  // referenced by every destination. The payload stays plaintext until the
+  // egress encrypts the batch.
+  auto packet_span = egress_.reserve(reserve_size());
+  size_t packet_size = packet_to_rtp(pcm_frame, *packetizer_, *codec_, nullptr,
+                                     packet_span.first(max_packet_size_));
+  if (packet_size == 0) {
+    return;
+  }
+
+  commit(packet_span, packet_size);
+}
+
+void RTPStreamer::send_encoded(std::span<const uint8_t> payload) {
+  if (!select_destinations()) {
+    return;
+  }
+
+  auto packet_span = egress_.reserve(reserve_size());
+  size_t packet_size = encoded_to_rtp(payload, *packetizer_, nullptr,
+                                      packet_span.first(max_packet_size_));
+  if (packet_size == 0) {
+    return;
+  }
+
+  commit(packet_span, packet_size);
+}
+
+std::size_t RTPStreamer::reserve_size() const {
+  return srtp_ ? max_packet_size_ + crypto::SRTP_AUTH_TAG_SIZE
+               : max_packet_size_;
+}
+
+void RTPStreamer::commit(std::span<uint8_t> packet, std::size_t packet_size) {
+  const std::size_t payload_size = packet_size - RTP_HEADER_SIZE;
+  if (srtp_) {
+    packet_size = srtp_->protect(packet, RTP_HEADER_SIZE, payload_size,
+                                 packetizer_->last_packet_index());
+    egress_.commit(packet_size, pending_, counters_);
+    return;
+  }
+  if (!encryptor_) {
+    egress_.commit(packet_size, pending_, counters_);
+  } else {
+    pending_encryption_.packet_index = packetizer_->last_packet_index();
+    egress_.commit(packet_size, pending_, counters_, &pending_encryption_);
+  }
+
+  if (rtcp_enabled_) {
+    send_rtcp_if_due(payload_size);
+  }
+}
+
+void RTPStreamer::send_rtcp_if_due(std::size_t payload_size) {
+  rtcp_->on_rtp_sent(payload_size);
+  if (rtcp_destinations_.empty()) {
+    return;
+  }
+
+  // Rides in the same batch as the RTP packet, from the same socket, so the
+  // clients' reports come back to an egress socket.
+  auto report = egress_.reserve(rtcp::MAX_SENDER_REPORT_SIZE);
+  std::size_t size = rtcp_->write_sender_report_if_due(
+      report, packetizer_->last_timestamp(), std::chrono::steady_clock::now());
+  egress_.commit(size, rtcp_destinations_, rtcp_counters_);
+}
 
-    socket_.async_send_to(
-        asio::buffer(*packet_owner, packet_size), client.endpoint,
-        [this, packet_owner](const boost::system::error_code& ec,
-                             std::size_t bytes_transferred) {
-          if (!ec) {
-            bytes_sent_.fetch_add(bytes_transferred, std::memory_order_relaxed);
-            packets_sent_.fetch_add(1, std::memory_order_relaxed);
-          } else {
-            spdlog::debug("UDP send failed: {}", ec.message());
-          }
-        });
+std::vector<RtcpClientStats> RTPStreamer::get_rtcp_stats() const {
+  std::vector<RtcpClientStats> stats;
+  get_rtcp_stats(stats);
+  return stats;
+}
+
+void RTPStreamer::get_rtcp_stats(std::vector<RtcpClientStats>& out) const {
+  // rtcp_ never changes after construction, so any thread may read it.
+  if (rtcp_) {
+    rtcp_->get_stats(out);
+  } else {
+    out.clear();
   }
 }
 
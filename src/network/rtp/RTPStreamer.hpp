@@ -4,6 +4,7 @@
 #include <atomic>
 #include <boost/asio.hpp>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <vector>
@@ -11,6 +12,9 @@
 #include "CodecStrategy.hpp"
 #include "EncryptionStrategy.hpp"
 #include "RTPPacketizer.hpp"
+#include "RtcpChannel.hpp"
+#include "SrtpSender.hpp"
+#include "UdpEgress.hpp"
 
 namespace hermes::net::rtp {
 namespace asio = boost::asio;
@@ -27,6 +31,12 @@ struct RtpClientTarget {
   /// Simulated packet loss ratio (0.0 to 1.0). Useful for network testing.
   double packet_loss_ratio;
 
+  /// Egress socket the client is sent from.
+  std::size_t lane;
+
+  /// Multicast groups own their lane (per-target socket options).
+  bool owns_lane = false;
+
   /**
    * @brief Equality operator for finding or removing clients by endpoint.
    * Allows std::ranges::contains to work with direct endpoint comparisons.
@@ -39,25 +49,49 @@ struct RtpClientTarget {
  * @brief Manages the packetization, optional encryption, and network
  * transmission of audio frames.
  *
- * Utilizes a zero-copy scatter-gather ring buffer to efficiently fan out RTP
- * packets to multiple connected clients asynchronously.
+ * Streamers do not own sockets: each frame is packetized once, directly into
+ * the batch slab of the io_context's shared infra::UdpEgress, and queued for
+ * every client. The engine sends the whole tick's traffic in one batch.
+ * By default encrypted streams use the legacy transform: payloads are queued
+ * in plaintext and the engine encrypts the whole batch right before sending.
+ * With `[crypto] srtp = true`, each packet is instead protected as it is
+ * written: its keystream was prefetched by the engine between ticks, so only
+ * the XOR and the auth tag are left.
+ *
+ * Unless disabled, plain RTP streams also speak RTCP from the same socket:
+ * an SR goes to every client (RTP port + 1, or the RTP port with `mux`)
+ * each interval, and the clients' RRs / NACKs come back through the egress
+ * to the RtcpRouter, which feeds this stream's RtcpChannel.
  */
 class RTPStreamer {
  public:
+  /**
+   * @brief Applies the [rtcp] settings to streams created afterwards and, if
+   * enabled, routes datagrams received on egress sockets to the RtcpRouter.
+   * Call once at startup, before the IoContextPool is created.
+   */
+  static void configure(const config::RtcpConfig& cfg);
+
   /**
    * @brief Factory method to create an RTPStreamer with dynamic cryptographic
    * keys.
    */
    static std::unique_ptr<RTPStreamer> create(
-      boost::asio::io_context& io, const hermes::config::CryptoConfig& crypto_cfg);
+      infra::UdpEgress& egress, const hermes::config::CryptoConfig& crypto_cfg,
+      const config::FrameGeometry& geometry = {});
 
   /**
-   * @brief Constructs the RTP streamer and initializes the internal buffer
-   * ring.
-   * @param io The Boost.Asio I/O context for UDP socket operations.
+   * @brief Constructs the RTP streamer on a shared egress engine.
+   * @param egress The UDP egress of the io_context this stream runs on.
+   * @param geometry Rate and size of the PCM frames given to send_frame().
    */
-  explicit RTPStreamer(boost::asio::io_context& io,
-                       const hermes::config::CryptoConfig& crypto_cfg);
+  RTPStreamer(infra::UdpEgress& egress,
+              const hermes::config::CryptoConfig& crypto_cfg,
+              const config::FrameGeometry& geometry = {});
+  ~RTPStreamer();
+
+  RTPStreamer(const RTPStreamer&) = delete;
+  RTPStreamer& operator=(const RTPStreamer&) = delete;
 
   /**
    * @brief Resolves and adds a new destination client to the multicast stream.
@@ -69,6 +103,18 @@ class RTPStreamer {
   void add_client(const std::string& host_or_ip, uint16_t port,
                   double packet_loss_ratio = 0.0);
 
+  /**
+   * @brief Adds a multicast (or SSM, 232.0.0.0/8) group as one destination:
+   * each frame is sent to the group once, however many receivers joined it.
+   * The group gets its own egress socket carrying `cfg`'s TTL, outgoing
+   * interface and loopback settings.
+   * @return false if the address is not an IPv4 multicast group or the
+   * socket options were rejected.
+   */
+  bool add_multicast_client(const std::string& group, uint16_t port,
+                            const config::MulticastConfig& cfg,
+                            double packet_loss_ratio = 0.0);
+
   /**
    * @brief Removes an existing client from the stream.
    * @param host_or_ip The hostname or IP address of the client.
@@ -77,8 +123,19 @@ class RTPStreamer {
   void remove_client(const std::string& host_or_ip, uint16_t port);
 
   /**
-   * @brief Initializes AES-CTR SRTP encryption for the stream.
-   * Derives unique cryptographic keys and base IVs using the stream's SSRC.
+   * @brief Selects the wire codec. Builds the encoder (and its state) now so
+   * that send_frame() never allocates; call before the first frame.
+   * @return false if the codec is unavailable (the current codec is kept).
+   */
+  bool set_codec(audio::CodecKind kind);
+
+  std::string_view codec_name() const { return codec_->get_name(); }
+
+  /**
+   * @brief Initializes encryption for the stream: RFC 3711 SRTP
+   * (AES_CM_128_HMAC_SHA1_80) from the configured master key and salt, or,
+   * with `srtp = false`, the legacy payload-only AES-CTR whose keys and base
+   * IVs are derived from the stream's SSRC.
    */
   void setup_security();
 
@@ -89,13 +146,21 @@ class RTPStreamer {
    */
   void send_frame(std::span<const uint8_t> pcm_frame);
 
+  /**
+   * @brief Like send_frame(), for a payload already encoded with the current
+   * codec (passthrough): no encoding, only packetize / encrypt / send.
+   * @param payload One frame of codec output, e.g. samples_per_frame() bytes
+   * of PCMA.
+   */
+  void send_encoded(std::span<const uint8_t> payload);
+
   /**
    * @brief Retrieves the total number of bytes successfully dispatched to the
    * network.
    * @return uint64_t Number of bytes sent.
    */
   uint64_t get_bytes_sent() const {
-    return bytes_sent_.load(std::memory_order_relaxed);
+    return counters_->bytes_sent.load(std::memory_order_relaxed);
   }
 
   /**
@@ -104,9 +169,19 @@ class RTPStreamer {
    * @return uint64_t Number of packets sent.
    */
   uint64_t get_packets_sent() const {
-    return packets_sent_.load(std::memory_order_relaxed);
+    return counters_->packets_sent.load(std::memory_order_relaxed);
   }
 
+  /**
+   * @brief Per-client loss, jitter and RTT from RTCP receiver reports (empty
+   * with RTCP off, no reports for SRTP streams). Safe to call from any
+   * thread.
+   */
+  std::vector<RtcpClientStats> get_rtcp_stats() const;
+
+  /** @brief Same, into a caller-owned vector whose storage is reused. */
+  void get_rtcp_stats(std::vector<RtcpClientStats>& out) const;
+
  private:
   /**
    * @brief Derives the base Initialization Vector (IV) using the session SSRC.
@@ -122,22 +197,68 @@ class RTPStreamer {
    */
   std::vector<uint8_t> derive_session_key(uint32_t ssrc);
 
-  std::atomic<uint64_t> bytes_sent_{0};
-  std::atomic<uint64_t> packets_sent_{0};
+  /**
+   * @brief Fills pending_ with this frame's destinations (after loss
+   * simulation).
+   * @return false if there is nobody to send to.
+   */
+  bool select_destinations();
+
+  /** @brief Slab space one packet may need (tag included). */
+  std::size_t reserve_size() const;
 
-  static constexpr int RING_BUFFER_SIZE = 16;
-  std::array<std::shared_ptr<std::vector<uint8_t>>, RING_BUFFER_SIZE>
-      packet_ring_;
-  size_t ring_index_ = 0;
+  /**
+   * @brief Protects (SRTP) the packet just written into the egress slab, or
+   * marks its payload for the legacy batch encryption pass, then queues it.
+   */
+  void commit(std::span<uint8_t> packet, std::size_t packet_size);
+
+  /** @brief Counts the packet for the SR and sends one when it is due. */
+  void send_rtcp_if_due(std::size_t payload_size);
+
+  /** @brief Mirrors clients_ into the RTCP destinations and matcher. */
+  void update_rtcp_destinations();
+
+  /**
+   * @brief Closes multicast lanes once the current tick has been flushed
+   * (their packets may still be queued), on the egress thread.
+   */
+  void release_lanes_later(std::vector<std::size_t> lanes);
+
+  /**
+   * @brief Resolves a host or IP literal into a UDP endpoint.
+   */
+  std::optional<udp::endpoint> resolve(const std::string& host_or_ip,
+                                       uint16_t port);
+
+  infra::UdpEgress& egress_;
+  std::size_t lane_;
+  std::shared_ptr<infra::EgressCounters> counters_;
+
+  config::FrameGeometry geometry_;
+  /// No codec emits more bytes than the PCM it is given.
+  std::size_t max_packet_size_;
+
+  /// Destinations of the current frame that survived loss simulation.
+  std::vector<infra::EgressTarget> pending_;
 
   std::unique_ptr<RTPPacketizer> packetizer_;
   std::unique_ptr<audio::ICodecStrategy> codec_;
-  std::unique_ptr<crypto::IEncryptionStrategy> encryptor_;
+  std::shared_ptr<crypto::IEncryptionStrategy> encryptor_;
+  /// Handed to the egress with each packet while encryption is on.
+  infra::PendingEncryption pending_encryption_;
+  std::shared_ptr<crypto::SrtpSender> srtp_;
   std::vector<uint8_t> session_master_key_;
   std::vector<uint8_t> session_salt_;
-  udp::socket socket_;
+  bool use_srtp_;
   std::vector<RtpClientTarget> clients_;
 
+  std::shared_ptr<RtcpChannel> rtcp_;  // Null with RTCP off
+  bool rtcp_enabled_ = false;          // False for SRTP streams too
+  std::vector<udp::endpoint> rtcp_endpoints_;
+  std::vector<infra::EgressTarget> rtcp_destinations_;
+  std::shared_ptr<infra::EgressCounters> rtcp_counters_;
+
   bool encryption_enabled_ = false;
 };
 
@@ -0,0 +1,151 @@
+#include "Rtcp.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace hermes::net::rtp::rtcp {
+
+namespace {
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+constexpr uint8_t VERSION_2 = 0x80;
+constexpr std::size_t HEADER_SIZE = 4;
+constexpr std::size_t REPORT_BLOCK_SIZE = 24;
+constexpr uint8_t SDES_CNAME = 1;
+
+// Seconds between the NTP epoch (1900) and the Unix epoch (1970).
+constexpr uint64_t NTP_UNIX_OFFSET = 2208988800ULL;
+
+void put16(std::span<uint8_t> out, std::size_t at, uint16_t v) {
+  out[at] = static_cast<uint8_t>(v >> 8);
+  out[at + 1] = static_cast<uint8_t>(v);
+}
+
+void put32(std::span<uint8_t> out, std::size_t at, uint32_t v) {
+  put16(out, at, static_cast<uint16_t>(v >> 16));
+  put16(out, at + 2, static_cast<uint16_t>(v));
+}
+
+uint16_t get16(std::span<const uint8_t> in, std::size_t at) {
+  return static_cast<uint16_t>((in[at] << 8) | in[at + 1]);
+}
+
+uint32_t get32(std::span<const uint8_t> in, std::size_t at) {
+  return (static_cast<uint32_t>(get16(in, at)) << 16) | get16(in, at + 2);
+}
+
+void parse_report_blocks(std::span<const uint8_t> body, uint32_t reporter,
+                         std::size_t count, std::vector<ReportBlock>& reports) {
+  for (std::size_t i = 0; i < count; ++i) {
+    auto block = body.subspan(i * REPORT_BLOCK_SIZE, REPORT_BLOCK_SIZE);
+    // Cumulative loss is a signed 24-bit value.
+    auto lost = static_cast<int32_t>(get32(block, 4) << 8) >> 8;
+    reports.push_back(ReportBlock{reporter, get32(block, 0), block[4], lost,
+                                  get32(block, 8), get32(block, 12),
+                                  get32(block, 16), get32(block, 20)});
+  }
+}
+
+// NOLINTEND(readability-magic-numbers)
+
+}  // namespace
+
+uint64_t to_ntp(std::chrono::system_clock::time_point time) {
+  using namespace std::chrono;
+  auto since_epoch = time.time_since_epoch();
+  auto secs = duration_cast<seconds>(since_epoch);
+  auto frac = duration_cast<nanoseconds>(since_epoch - secs);
+  constexpr uint64_t NS_PER_S = 1'000'000'000ULL;
+  uint64_t ntp_secs = static_cast<uint64_t>(secs.count()) + NTP_UNIX_OFFSET;
+  uint64_t ntp_frac =
+      (static_cast<uint64_t>(frac.count()) << 32) / NS_PER_S;  // NOLINT
+  return (ntp_secs << 32) | ntp_frac;                          // NOLINT
+}
+
+bool is_rtcp(std::span<const uint8_t> datagram) {
+  constexpr uint8_t VERSION_MASK = 0xC0;
+  constexpr uint8_t FIRST_RTCP_PT = 192;
+  constexpr uint8_t LAST_RTCP_PT = 223;
+  return datagram.size() >= HEADER_SIZE &&
+         (datagram[0] & VERSION_MASK) == VERSION_2 &&
+         datagram[1] >= FIRST_RTCP_PT && datagram[1] <= LAST_RTCP_PT;
+}
+
+std::size_t write_sender_report(std::span<uint8_t> out, const SenderInfo& info,
+                                std::string_view cname) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  cname = cname.substr(0, MAX_CNAME);
+  constexpr std::size_t SR_SIZE = 28;
+  // SDES: header, SSRC, CNAME item (type, length, text), END, padding.
+  const std::size_t sdes_size = (HEADER_SIZE + 4 + 2 + cname.size() + 1 + 3) / 4 * 4;
+  if (out.size() < SR_SIZE + sdes_size) {
+    return 0;
+  }
+
+  out[0] = VERSION_2;  // No report blocks
+  out[1] = PT_SR;
+  put16(out, 2, SR_SIZE / 4 - 1);
+  put32(out, 4, info.ssrc);
+  put32(out, 8, static_cast<uint32_t>(info.ntp_timestamp >> 32));
+  put32(out, 12, static_cast<uint32_t>(info.ntp_timestamp));
+  put32(out, 16, info.rtp_timestamp);
+  put32(out, 20, info.packet_count);
+  put32(out, 24, info.octet_count);
+
+  auto sdes = out.subspan(SR_SIZE, sdes_size);
+  sdes[0] = VERSION_2 | 1;  // One chunk
+  sdes[1] = PT_SDES;
+  put16(sdes, 2, static_cast<uint16_t>(sdes_size / 4 - 1));
+  put32(sdes, 4, info.ssrc);
+  sdes[8] = SDES_CNAME;
+  sdes[9] = static_cast<uint8_t>(cname.size());
+  std::copy(cname.begin(), cname.end(), sdes.begin() + 10);
+  std::fill(sdes.begin() + 10 + static_cast<std::ptrdiff_t>(cname.size()),
+            sdes.end(), 0);  // END item + padding
+  // NOLINTEND(readability-magic-numbers)
+  return SR_SIZE + sdes_size;
+}
+
+bool parse_feedback(std::span<const uint8_t> packet,
+                    std::vector<ReportBlock>& reports,
+                    std::vector<Nack>& nacks) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  while (!packet.empty()) {
+    if (!is_rtcp(packet)) {
+      return false;
+    }
+    const std::size_t size = (static_cast<std::size_t>(get16(packet, 2)) + 1) * 4;
+    if (size > packet.size()) {
+      return false;
+    }
+    auto body = packet.subspan(HEADER_SIZE, size - HEADER_SIZE);
+    const uint8_t count = packet[0] & 0x1F;  // RC, or FMT for feedback
+    const uint8_t type = packet[1];
+
+    if (type == PT_SR || type == PT_RR) {
+      // An SR carries 20 bytes of sender info before its report blocks.
+      const std::size_t skip = type == PT_SR ? 24 : 4;
+      if (body.size() < skip + count * REPORT_BLOCK_SIZE) {
+        return false;
+      }
+      parse_report_blocks(body.subspan(skip), get32(body, 0), count, reports);
+    } else if (type == PT_RTPFB && count == FMT_GENERIC_NACK) {
+      if (body.size() < 8) {
+        return false;
+      }
+      Nack nack{get32(body, 0), get32(body, 4), 0};
+      // Each FCI: PID (lost) + a bitmask of 16 further lost packets.
+      for (std::size_t at = 8; at + 4 <= body.size(); at += 4) {
+        nack.lost_packets += 1 + std::popcount(get16(body, at + 2));
+      }
+      nacks.push_back(nack);
+    }
+
+    packet = packet.subspan(size);
+  }
+  // NOLINTEND(readability-magic-numbers)
+  return true;
+}
+
+}  // namespace hermes::net::rtp::rtcp
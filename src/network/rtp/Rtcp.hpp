@@ -0,0 +1,101 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file Rtcp.hpp
+ * @brief RFC 3550 / RFC 4585 RTCP wire format: the sender report we emit and
+ * the receiver feedback (RR report blocks, generic NACK) we ingest.
+ */
+namespace hermes::net::rtp {
+
+/**
+ * @brief What one RTP destination's receiver reports say about its link.
+ * Plain data: copied into SessionStats and /metrics.
+ */
+struct RtcpClientStats {
+  std::string endpoint;         ///< RTP destination, "ip:port"
+  double fraction_lost = 0.0;   ///< 0..1, over the last report interval
+  int64_t cumulative_lost = 0;  ///< Since the start of the stream
+  double jitter_ms = 0.0;       ///< Interarrival jitter
+  double rtt_ms = -1.0;         ///< -1 until a report echoes one of our SRs
+  uint64_t nacked_packets = 0;  ///< Packets requested again (RFC 4585 NACK)
+  uint64_t reports = 0;         ///< Report blocks received
+};
+
+}  // namespace hermes::net::rtp
+
+namespace hermes::net::rtp::rtcp {
+
+inline constexpr uint8_t PT_SR = 200;
+inline constexpr uint8_t PT_RR = 201;
+inline constexpr uint8_t PT_SDES = 202;
+inline constexpr uint8_t PT_RTPFB = 205;
+inline constexpr uint8_t FMT_GENERIC_NACK = 1;
+
+/// SR without report blocks + SDES with a CNAME of at most MAX_CNAME bytes.
+inline constexpr std::size_t MAX_CNAME = 64;
+inline constexpr std::size_t MAX_SENDER_REPORT_SIZE = 28 + 12 + MAX_CNAME;
+
+struct SenderInfo {
+  uint32_t ssrc = 0;
+  uint64_t ntp_timestamp = 0;  ///< 32.32 fixed point, seconds since 1900
+  uint32_t rtp_timestamp = 0;
+  uint32_t packet_count = 0;
+  uint32_t octet_count = 0;  ///< Payload bytes only
+};
+
+/** @brief One reception report block (from an SR or an RR). */
+struct ReportBlock {
+  uint32_t reporter_ssrc = 0;
+  uint32_t source_ssrc = 0;
+  uint8_t fraction_lost = 0;  ///< Fixed point, /256
+  int32_t cumulative_lost = 0;
+  uint32_t highest_sequence = 0;
+  uint32_t jitter = 0;  ///< In RTP timestamp units
+  uint32_t last_sr = 0;  ///< Middle 32 bits of the NTP time of our last SR
+  uint32_t delay_since_last_sr = 0;  ///< 1/65536 s
+};
+
+/** @brief A generic NACK (RFC 4585 §6.2.1), summed over its FCI entries. */
+struct Nack {
+  uint32_t reporter_ssrc = 0;
+  uint32_t media_ssrc = 0;
+  uint32_t lost_packets = 0;
+};
+
+/** @brief Wall clock as an NTP 32.32 timestamp. */
+uint64_t to_ntp(std::chrono::system_clock::time_point time);
+
+/** @brief Middle 32 bits of an NTP timestamp (the LSR / DLSR unit). */
+constexpr uint32_t ntp_compact(uint64_t ntp) {
+  return static_cast<uint32_t>(ntp >> 16);  // NOLINT
+}
+
+/**
+ * @brief True if the datagram looks like RTCP (RFC 5761 §4: version 2 and
+ * a packet type in 192..223), as opposed to RTP.
+ */
+bool is_rtcp(std::span<const uint8_t> datagram);
+
+/**
+ * @brief Writes a compound SR (no report blocks: we only send) + SDES CNAME.
+ * @return The packet size, or 0 if `out` is too small.
+ */
+std::size_t write_sender_report(std::span<uint8_t> out, const SenderInfo& info,
+                                std::string_view cname);
+
+/**
+ * @brief Walks a compound RTCP packet and appends every report block and
+ * generic NACK it carries. Unknown packet types are skipped.
+ * @return false if the packet is malformed (what was parsed so far is kept).
+ */
+bool parse_feedback(std::span<const uint8_t> packet,
+                    std::vector<ReportBlock>& reports, std::vector<Nack>& nacks);
+
+}  // namespace hermes::net::rtp::rtcp
@@ -0,0 +1,187 @@
+#include "RtcpChannel.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <format>
+
+namespace hermes::net::rtp {
+
+namespace {
+
+constexpr double MS_PER_S = 1000.0;
+constexpr double COMPACT_NTP_PER_S = 65536.0;
+constexpr double FRACTION_LOST_SCALE = 256.0;
+
+std::string to_string(const udp::endpoint& endpoint) {
+  return std::format("{}:{}", endpoint.address().to_string(), endpoint.port());
+}
+
+}  // namespace
+
+RtcpChannel::RtcpChannel(uint32_t ssrc, uint32_t clock_rate,
+                         std::chrono::milliseconds interval)
+    : ssrc_(ssrc),
+      cname_(std::format("hermes-{:08x}", ssrc)),
+      clock_rate_(clock_rate),
+      interval_(interval) {}
+
+void RtcpChannel::set_destinations(std::span<const udp::endpoint> destinations) {
+  std::lock_guard lock(mutex_);
+  std::vector<Client> clients;
+  clients.reserve(destinations.size());
+  for (const auto& destination : destinations) {
+    auto it = std::ranges::find(clients_, destination, &Client::destination);
+    if (it != clients_.end()) {
+      clients.push_back(std::move(*it));
+    } else {
+      clients.push_back(Client{destination, {.endpoint = to_string(destination)}});
+    }
+  }
+  clients_ = std::move(clients);
+}
+
+std::size_t RtcpChannel::write_sender_report_if_due(
+    std::span<uint8_t> out, uint32_t rtp_timestamp,
+    std::chrono::steady_clock::time_point now) {
+  if (now < next_report_) {
+    return 0;
+  }
+  next_report_ = now + interval_;
+
+  const rtcp::SenderInfo info{
+      .ssrc = ssrc_,
+      .ntp_timestamp = rtcp::to_ntp(std::chrono::system_clock::now()),
+      .rtp_timestamp = rtp_timestamp,
+      .packet_count = packets_sent_,
+      .octet_count = octets_sent_};
+  return rtcp::write_sender_report(out, info, cname_);
+}
+
+RtcpChannel::Client* RtcpChannel::find_client(const udp::endpoint& from) {
+  auto it = std::ranges::find_if(clients_, [&from](const Client& client) {
+    return client.destination.address() == from.address() &&
+           (client.destination.port() == from.port() ||
+            client.destination.port() + 1 == from.port());
+  });
+  return it != clients_.end() ? &*it : nullptr;
+}
+
+void RtcpChannel::on_report(const rtcp::ReportBlock& block,
+                            const udp::endpoint& from,
+                            uint32_t arrival_ntp_compact) {
+  const uint32_t clock_rate = clock_rate_.load(std::memory_order_relaxed);
+
+  std::lock_guard lock(mutex_);
+  Client* client = find_client(from);
+  if (client == nullptr) {
+    return;
+  }
+
+  auto& stats = client->stats;
+  stats.fraction_lost = block.fraction_lost / FRACTION_LOST_SCALE;
+  stats.cumulative_lost = block.cumulative_lost;
+  if (clock_rate != 0) {
+    stats.jitter_ms = block.jitter * MS_PER_S / clock_rate;
+  }
+  // RFC 3550 §6.4.1: RTT = A - LSR - DLSR, in 1/65536 s. A zero LSR means
+  // the receiver has not seen an SR yet; a "negative" result means its clock
+  // or the report is off.
+  if (block.last_sr != 0) {
+    const uint32_t rtt =
+        arrival_ntp_compact - block.last_sr - block.delay_since_last_sr;
+    if (static_cast<int32_t>(rtt) >= 0) {
+      stats.rtt_ms = rtt * MS_PER_S / COMPACT_NTP_PER_S;
+    }
+  }
+  ++stats.reports;
+}
+
+void RtcpChannel::on_nack(const rtcp::Nack& nack, const udp::endpoint& from) {
+  std::lock_guard lock(mutex_);
+  if (Client* client = find_client(from)) {
+    client->stats.nacked_packets += nack.lost_packets;
+  }
+}
+
+void RtcpChannel::get_stats(std::vector<RtcpClientStats>& out) const {
+  std::lock_guard lock(mutex_);
+  out.resize(clients_.size());
+  for (std::size_t i = 0; i < clients_.size(); ++i) {
+    out[i] = clients_[i].stats;  // Assignment keeps out[i].endpoint's buffer
+  }
+}
+
+RtcpRouter& RtcpRouter::instance() {
+  static RtcpRouter router;
+  return router;
+}
+
+void RtcpRouter::add(const std::shared_ptr<RtcpChannel>& channel) {
+  std::lock_guard lock(mutex_);
+  channels_[channel->ssrc()] = channel;
+}
+
+void RtcpRouter::remove(const RtcpChannel* channel) {
+  std::lock_guard lock(mutex_);
+  auto it = channels_.find(channel->ssrc());
+  if (it == channels_.end()) {
+    return;
+  }
+  auto current = it->second.lock();
+  if (!current || current.get() == channel) {
+    channels_.erase(it);
+  }
+}
+
+std::shared_ptr<RtcpChannel> RtcpRouter::find(uint32_t ssrc) const {
+  std::lock_guard lock(mutex_);
+  auto it = channels_.find(ssrc);
+  return it != channels_.end() ? it->second.lock() : nullptr;
+}
+
+void RtcpRouter::dispatch(std::span<const uint8_t> datagram,
+                          const udp::endpoint& from) {
+  if (!rtcp::is_rtcp(datagram)) {
+    return;  // Stray RTP or noise on the egress socket
+  }
+  received_.fetch_add(1, std::memory_order_relaxed);
+
+  // Scratch reused across datagrams: no allocation in steady state.
+  static thread_local std::vector<rtcp::ReportBlock> reports;
+  static thread_local std::vector<rtcp::Nack> nacks;
+  reports.clear();
+  nacks.clear();
+
+  if (!rtcp::parse_feedback(datagram, reports, nacks)) {
+    malformed_.fetch_add(1, std::memory_order_relaxed);
+    spdlog::debug("Malformed RTCP from {}:{}", from.address().to_string(),
+                  from.port());
+  }
+
+  const uint32_t arrival =
+      rtcp::ntp_compact(rtcp::to_ntp(std::chrono::system_clock::now()));
+  for (const auto& block : reports) {
+    if (auto channel = find(block.source_ssrc)) {
+      channel->on_report(block, from, arrival);
+    } else {
+      unmatched_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  for (const auto& nack : nacks) {
+    if (auto channel = find(nack.media_ssrc)) {
+      channel->on_nack(nack, from);
+    } else {
+      unmatched_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+RtcpRouterStats RtcpRouter::get_stats() const {
+  return RtcpRouterStats{
+      .received = received_.load(std::memory_order_relaxed),
+      .malformed = malformed_.load(std::memory_order_relaxed),
+      .unmatched = unmatched_.load(std::memory_order_relaxed)};
+}
+
+}  // namespace hermes::net::rtp
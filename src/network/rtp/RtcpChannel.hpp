@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <boost/asio/ip/udp.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Rtcp.hpp"
+
+namespace hermes::net::rtp {
+using udp = boost::asio::ip::udp;
+
+/**
+ * @brief The RTCP side of one outgoing RTP stream: builds its periodic
+ * sender reports and folds the receiver reports / NACKs its clients send
+ * back into per-client link stats.
+ *
+ * A report is attributed to the RTP destination with the same address whose
+ * port is the report's source port or the one just below it (RTCP on
+ * port + 1, or muxed on the RTP port). Reports from anybody else are ignored.
+ *
+ * =========================================================================
+ * THREAD SAFETY CONTRACT
+ * =========================================================================
+ * - on_rtp_sent(), write_sender_report_if_due() and set_clock_rate() run on
+ *   the stream's io_context thread.
+ * - on_report() / on_nack() arrive from whichever thread's socket received
+ *   the datagram; they, set_destinations() and get_stats() take the mutex.
+ * =========================================================================
+ */
+class RtcpChannel {
+ public:
+  RtcpChannel(uint32_t ssrc, uint32_t clock_rate,
+              std::chrono::milliseconds interval);
+
+  uint32_t ssrc() const { return ssrc_; }
+
+  void set_clock_rate(uint32_t clock_rate) {
+    clock_rate_.store(clock_rate, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Replaces the RTP destinations reports are matched against. Stats
+   * of destinations that are kept survive.
+   */
+  void set_destinations(std::span<const udp::endpoint> destinations);
+
+  /** @brief Sender-side accounting for the next SR. */
+  void on_rtp_sent(std::size_t payload_size) {
+    ++packets_sent_;
+    octets_sent_ += static_cast<uint32_t>(payload_size);
+  }
+
+  /**
+   * @brief Writes an SR into `out` once per interval.
+   * @param rtp_timestamp The stream's RTP timestamp for `now`.
+   * @return The SR size, or 0 if none is due (or `out` is too small).
+   */
+  std::size_t write_sender_report_if_due(
+      std::span<uint8_t> out, uint32_t rtp_timestamp,
+      std::chrono::steady_clock::time_point now);
+
+  void on_report(const rtcp::ReportBlock& block, const udp::endpoint& from,
+                 uint32_t arrival_ntp_compact);
+  void on_nack(const rtcp::Nack& nack, const udp::endpoint& from);
+
+  /**
+   * @brief Copies every client's stats into `out`, reusing its storage: no
+   * allocation once `out` has held as many clients (and endpoint strings).
+   */
+  void get_stats(std::vector<RtcpClientStats>& out) const;
+
+ private:
+  struct Client {
+    udp::endpoint destination;
+    RtcpClientStats stats;
+  };
+
+  /** @brief The client a report from `from` is about, or nullptr. */
+  Client* find_client(const udp::endpoint& from);
+
+  const uint32_t ssrc_;
+  const std::string cname_;
+  std::atomic<uint32_t> clock_rate_;
+  const std::chrono::milliseconds interval_;
+
+  // Stream thread only.
+  uint32_t packets_sent_ = 0;
+  uint32_t octets_sent_ = 0;
+  std::chrono::steady_clock::time_point next_report_{};
+
+  mutable std::mutex mutex_;
+  std::vector<Client> clients_;
+};
+
+struct RtcpRouterStats {
+  uint64_t received = 0;  ///< RTCP datagrams seen on egress sockets
+  uint64_t malformed = 0;
+  uint64_t unmatched = 0;  ///< Reports / NACKs about no stream of ours
+};
+
+/**
+ * @brief Routes incoming RTCP to the stream it is about, by media SSRC.
+ *
+ * Feedback reaches whichever egress socket (and thread) the client replies
+ * to, which with SO_REUSEPORT need not be the stream's own: hence one
+ * process-wide table rather than per-io_context state.
+ */
+class RtcpRouter {
+ public:
+  static RtcpRouter& instance();
+
+  void add(const std::shared_ptr<RtcpChannel>& channel);
+
+  /** @brief Forgets `channel` (not whatever else now uses its SSRC). */
+  void remove(const RtcpChannel* channel);
+
+  /** @brief Parses one datagram and hands its feedback to the streams. */
+  void dispatch(std::span<const uint8_t> datagram, const udp::endpoint& from);
+
+  RtcpRouterStats get_stats() const;
+
+ private:
+  RtcpRouter() = default;
+
+  std::shared_ptr<RtcpChannel> find(uint32_t ssrc) const;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<uint32_t, std::weak_ptr<RtcpChannel>> channels_;
+
+  std::atomic<uint64_t> received_{0};
+  std::atomic<uint64_t> malformed_{0};
+  std::atomic<uint64_t> unmatched_{0};
+};
+
+}  // namespace hermes::net::rtp
@@ -0,0 +1,168 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @file RtpHeaderWriter.hpp
+ * @brief Fixed-layout RTP header serialization for the send path.
+ *
+ * RTPPacket (Packet.hpp) models every header variant with vectors, which
+ * costs heap objects per packet. Outgoing packets never carry CSRCs, so the
+ * writer below only knows the 12 fixed bytes plus, optionally, RFC 8285
+ * one-byte header extensions whose sizes are template parameters: the
+ * header size is a compile-time constant and writing it touches nothing but
+ * the output buffer. Everything is constexpr.
+ */
+namespace hermes::net::rtp {
+
+/** @brief The per-packet fields of the 12-byte RTP header (V=2, no CSRC). */
+struct RtpFixedHeader {
+  uint8_t payload_type = 0;
+  bool marker = false;
+  uint16_t sequence = 0;
+  uint32_t timestamp = 0;
+  uint32_t ssrc = 0;
+};
+
+/**
+ * @brief One RFC 8285 one-byte header extension element. The ID is whatever
+ * the SDP extmap negotiated; the size is fixed by the element type.
+ */
+template <uint8_t Id, std::size_t Size>
+struct OneByteExtension {
+  static_assert(Id >= 1 && Id <= 14, "one-byte extension IDs are 1..14");
+  static_assert(Size >= 1 && Size <= 16, "one-byte extensions carry 1..16 bytes");
+
+  static constexpr uint8_t ID = Id;
+  static constexpr std::size_t SIZE = Size;
+
+  std::array<uint8_t, Size> data{};
+};
+
+/** @brief RFC 6464 client-to-mixer audio level: V flag + level in -dBov. */
+template <uint8_t Id>
+struct AudioLevelExtension : OneByteExtension<Id, 1> {
+  constexpr AudioLevelExtension(bool voice, uint8_t level_dbov) {
+    constexpr uint8_t VOICE_BIT = 0x80;
+    constexpr uint8_t LEVEL_MASK = 0x7F;
+    this->data[0] = static_cast<uint8_t>((voice ? VOICE_BIT : 0) |
+                                         (level_dbov & LEVEL_MASK));
+  }
+};
+
+/** @brief abs-send-time: 24-bit, 6.18 fixed-point seconds. */
+template <uint8_t Id>
+struct AbsSendTimeExtension : OneByteExtension<Id, 3> {
+  constexpr explicit AbsSendTimeExtension(uint32_t time_6_18) {
+    this->data[0] = static_cast<uint8_t>(time_6_18 >> 16);  // NOLINT
+    this->data[1] = static_cast<uint8_t>(time_6_18 >> 8);   // NOLINT
+    this->data[2] = static_cast<uint8_t>(time_6_18);
+  }
+};
+
+/**
+ * @brief Writes an RTP header with the given extension elements (none for
+ * the common case) in place.
+ */
+template <typename... Extensions>
+class RtpHeaderWriter {
+ public:
+  static constexpr std::size_t FIXED_SIZE = 12;
+  static constexpr bool HAS_EXTENSION = sizeof...(Extensions) > 0;
+
+  /// Elements (1-byte header + data each), padded to 32 bits.
+  static constexpr std::size_t EXTENSION_DATA_SIZE =
+      ((0 + ... + (1 + Extensions::SIZE)) + 3) / 4 * 4;
+
+  /// Total header size, known at compile time.
+  static constexpr std::size_t SIZE =
+      FIXED_SIZE + (HAS_EXTENSION ? 4 + EXTENSION_DATA_SIZE : 0);
+
+  /**
+   * @brief Writes the header into the first SIZE bytes of `out`.
+   * @return SIZE, or 0 if `out` is too small.
+   */
+  static constexpr std::size_t write(std::span<uint8_t> out,
+                                     const RtpFixedHeader& header,
+                                     const Extensions&... extensions) {
+    if (out.size() < SIZE) {
+      return 0;
+    }
+
+    // NOLINTBEGIN(readability-magic-numbers)
+    constexpr uint8_t VERSION_2 = 0x80;
+    constexpr uint8_t EXTENSION_BIT = 0x10;
+    out[0] = VERSION_2 | (HAS_EXTENSION ? EXTENSION_BIT : 0);
+    out[1] = static_cast<uint8_t>((header.marker ? 0x80 : 0) |
+                                  (header.payload_type & 0x7F));
+    put16(out, 2, header.sequence);
+    put32(out, 4, header.timestamp);
+    put32(out, 8, header.ssrc);
+
+    if constexpr (HAS_EXTENSION) {
+      constexpr uint16_t ONE_BYTE_PROFILE = 0xBEDE;
+      put16(out, 12, ONE_BYTE_PROFILE);
+      put16(out, 14, static_cast<uint16_t>(EXTENSION_DATA_SIZE / 4));
+
+      std::size_t pos = 16;
+      (put_element(out, pos, extensions), ...);
+      for (; pos < SIZE; ++pos) {
+        out[pos] = 0;  // Padding
+      }
+    }
+    // NOLINTEND(readability-magic-numbers)
+    return SIZE;
+  }
+
+ private:
+  static constexpr void put16(std::span<uint8_t> out, std::size_t at,
+                              uint16_t v) {
+    out[at] = static_cast<uint8_t>(v >> 8);  // NOLINT
+    out[at + 1] = static_cast<uint8_t>(v);
+  }
+
+  static constexpr void put32(std::span<uint8_t> out, std::size_t at,
+                              uint32_t v) {
+    put16(out, at, static_cast<uint16_t>(v >> 16));  // NOLINT
+    put16(out, at + 2, static_cast<uint16_t>(v));
+  }
+
+  template <typename Extension>
+  static constexpr void put_element(std::span<uint8_t> out, std::size_t& pos,
+                                    const Extension& extension) {
+    out[pos++] = static_cast<uint8_t>((Extension::ID << 4) |  // NOLINT
+                                      (Extension::SIZE - 1));
+    for (uint8_t byte : extension.data) {
+      out[pos++] = byte;
+    }
+  }
+};
+
+/// The header every outgoing packet uses today.
+using PlainRtpHeader = RtpHeaderWriter<>;
+
+static_assert(PlainRtpHeader::SIZE == 12);
+static_assert(RtpHeaderWriter<AudioLevelExtension<1>>::SIZE == 20);
+static_assert(RtpHeaderWriter<AudioLevelExtension<1>,
+                              AbsSendTimeExtension<3>>::SIZE == 24);
+
+namespace detail {
+// NOLINTBEGIN(readability-magic-numbers)
+constexpr bool header_writer_self_check() {
+  std::array<uint8_t, 20> buf{};
+  RtpHeaderWriter<AudioLevelExtension<1>>::write(
+      buf, {8, true, 0x1234, 0xA0B0C0D0, 0x01020304},
+      AudioLevelExtension<1>(true, 30));
+  constexpr std::array<uint8_t, 20> expected{
+      0x90, 0x88, 0x12, 0x34, 0xA0, 0xB0, 0xC0, 0xD0, 0x01, 0x02,
+      0x03, 0x04, 0xBE, 0xDE, 0x00, 0x01, 0x10, 0x9E, 0x00, 0x00};
+  return buf == expected;
+}
+// NOLINTEND(readability-magic-numbers)
+}  // namespace detail
+
+static_assert(detail::header_writer_self_check());
+
+}  // namespace hermes::net::rtp
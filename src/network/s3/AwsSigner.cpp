@@ -1,14 +1,63 @@
 #include "AwsSigner.hpp"
 
-#include <ctime>
-#include <map>
-#include <vector>
-
-#include "awssigv4.h"
+#include <cryptopp/hmac.h>
+#include <cryptopp/sha.h>
 
+#include <atomic>
+#include <span>
+#include <string_view>
 
 namespace hermes::net::s3 {
 
+namespace {
+
+// SHA-256 of the empty payload, precomputed.
+constexpr std::string_view EMPTY_PAYLOAD_SHA256 =
+    "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+constexpr std::string_view SIGNED_HEADERS = "host;x-amz-content-sha256;x-amz-date";
+constexpr std::string_view ALGORITHM = "AWS4-HMAC-SHA256";
+
+std::atomic<uint64_t> g_signatures{0};
+std::atomic<uint64_t> g_key_derivations{0};
+
+using Digest = std::array<uint8_t, 32>;
+
+Digest hmac_sha256(std::span<const uint8_t> key, std::string_view data) {
+  Digest out;
+  CryptoPP::HMAC<CryptoPP::SHA256> mac(key.data(), key.size());
+  mac.Update(reinterpret_cast<const CryptoPP::byte*>(data.data()), data.size());
+  mac.Final(out.data());
+  return out;
+}
+
+Digest sha256(std::string_view data) {
+  Digest out;
+  CryptoPP::SHA256().CalculateDigest(
+      out.data(), reinterpret_cast<const CryptoPP::byte*>(data.data()),
+      data.size());
+  return out;
+}
+
+/// Appends the lowercase hex of `digest` to `out`.
+void append_hex(std::string& out, const Digest& digest) {
+  constexpr std::string_view HEX = "0123456789abcdef";
+  for (uint8_t byte : digest) {
+    out.push_back(HEX[byte >> 4]);
+    out.push_back(HEX[byte & 0x0F]);
+  }
+}
+
+/// One thread's most recent signing key and what it was derived from.
+struct CachedKey {
+  std::string date;
+  std::string region;
+  std::string service;
+  std::string secret_key;
+  Digest key{};
+};
+
+}  // namespace
+
 std::tm AwsSigner::get_safe_gmtime(std::time_t timer) {
   std::tm tm_snapshot;
 #if defined(_WIN32)
@@ -19,46 +68,104 @@ std::tm AwsSigner::get_safe_gmtime(std::time_t timer) {
   return tm_snapshot;
 }
 
+const AwsSigner::Digest& AwsSigner::signing_key(const config::S3Config& cfg,
+                                                std::string_view date) {
+  thread_local CachedKey cached;
+  if (cached.date == date && cached.region == cfg.region &&
+      cached.service == cfg.service && cached.secret_key == cfg.secret_key) {
+    return cached.key;
+  }
+
+  // kSigning = HMAC(HMAC(HMAC(HMAC("AWS4" + secret, date), region),
+  //                      service), "aws4_request")
+  std::string seed = "AWS4" + cfg.secret_key;
+  auto k_date = hmac_sha256(
+      std::span(reinterpret_cast<const uint8_t*>(seed.data()), seed.size()),
+      date);
+  auto k_region = hmac_sha256(k_date, cfg.region);
+  auto k_service = hmac_sha256(k_region, cfg.service);
+  cached.key = hmac_sha256(k_service, "aws4_request");
+
+  cached.date = date;
+  cached.region = cfg.region;
+  cached.service = cfg.service;
+  cached.secret_key = cfg.secret_key;
+  g_key_derivations.fetch_add(1, std::memory_order_relaxed);
+  return cached.key;
+}
+
 SignedRequestHeaders AwsSigner::sign(const config::S3Config& cfg,
                                      boost::beast::http::verb method,
-                                     const std::string& host, // NOLINT(bugprone-easily-swappable-parameters)
+                                     const std::string& host,
                                      const std::string& uri_path) {
-  std::time_t now = std::time(nullptr);
-  std::tm timeinfo = get_safe_gmtime(now);
-
-  aws_sigv4::Signature signer(cfg.service, host, cfg.region, cfg.secret_key,
-                              cfg.access_key, now);
+  return sign(cfg, method, host, uri_path, std::time(nullptr));
+}
 
-  // Empty string hash to avoid redundent calculation
-  std::string payload_hash =
-      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+SignedRequestHeaders AwsSigner::sign(const config::S3Config& cfg,
+                                     boost::beast::http::verb method,
+                                     const std::string& host, // NOLINT(bugprone-easily-swappable-parameters)
+                                     const std::string& uri_path,
+                                     std::time_t now) {
+  std::tm timeinfo = get_safe_gmtime(now);
 
   constexpr size_t AWS_DATE_BUFFER_SIZE = 20;
   char amzdate[AWS_DATE_BUFFER_SIZE];
   std::strftime(amzdate, sizeof(amzdate), "%Y%m%dT%H%M%SZ", &timeinfo);
+  const std::string_view amz_date(amzdate);
+  const std::string_view date = amz_date.substr(0, 8);
+
+  // Reused across calls: after warm-up, signing allocates only the strings
+  // it returns.
+  thread_local std::string canonical;
+  thread_local std::string scope;
+  thread_local std::string string_to_sign;
 
-  // create Headers Map for Canonicalization
-  std::map<std::string, std::vector<std::string>> headers;
-  headers["host"] = {host};
-  headers["x-amz-content-sha256"] = {payload_hash};
-  headers["x-amz-date"] = {amzdate};
+  const auto verb = boost::beast::http::to_string(method);
+  canonical.clear();
+  canonical.append(verb.data(), verb.size()).push_back('\n');
+  canonical.append(uri_path).push_back('\n');
+  canonical.push_back('\n');  // Query string (empty)
+  canonical.append("host:").append(host).push_back('\n');
+  canonical.append("x-amz-content-sha256:")
+      .append(EMPTY_PAYLOAD_SHA256)
+      .push_back('\n');
+  canonical.append("x-amz-date:").append(amz_date).append("\n\n");
+  canonical.append(SIGNED_HEADERS).push_back('\n');
+  canonical.append(EMPTY_PAYLOAD_SHA256);
 
-  std::string method_str(boost::beast::http::to_string(method));
+  scope.clear();
+  scope.append(date).push_back('/');
+  scope.append(cfg.region).push_back('/');
+  scope.append(cfg.service).append("/aws4_request");
 
-  std::string canonical_req = signer.createCanonicalRequest(
-      method_str, uri_path,
-      "",  // Query string (empty)
-      headers,
-      ""  // Payload (handled via hash above for V4 usually, or passed empty)
-  );
+  string_to_sign.clear();
+  string_to_sign.append(ALGORITHM).push_back('\n');
+  string_to_sign.append(amz_date).push_back('\n');
+  string_to_sign.append(scope).push_back('\n');
+  append_hex(string_to_sign, sha256(canonical));
 
-  std::string string_to_sign = signer.createStringToSign(canonical_req);
-  std::string signature = signer.createSignature(string_to_sign);
-  std::string auth_header = signer.createAuthorizationHeader(signature);
+  auto signature = hmac_sha256(signing_key(cfg, date), string_to_sign);
+
+  SignedRequestHeaders headers;
+  auto& auth = headers.authorization;
+  auth.reserve(ALGORITHM.size() + cfg.access_key.size() + scope.size() +
+               SIGNED_HEADERS.size() + 96);
+  auth.append(ALGORITHM).append(" Credential=").append(cfg.access_key);
+  auth.push_back('/');
+  auth.append(scope);
+  auth.append(", SignedHeaders=").append(SIGNED_HEADERS);
+  auth.append(", Signature=");
+  append_hex(auth, signature);
+
+  headers.date = amz_date;
+  headers.content_sha256 = EMPTY_PAYLOAD_SHA256;
+  g_signatures.fetch_add(1, std::memory_order_relaxed);
+  return headers;
+}
 
-  return SignedRequestHeaders{.authorization = auth_header,
-                              .date = std::string(amzdate),
-                              .content_sha256 = payload_hash};
+AwsSignerStats AwsSigner::get_stats() {
+  return {g_signatures.load(std::memory_order_relaxed),
+          g_key_derivations.load(std::memory_order_relaxed)};
 }
 
 }  // namespace hermes::net::s3
@@ -1,6 +1,10 @@
 #pragma once
+#include <array>
 #include <boost/beast/http/verb.hpp>
+#include <cstdint>
+#include <ctime>
 #include <string>
+#include <string_view>
 
 #include "Config.hpp"
 
@@ -13,9 +17,21 @@ struct SignedRequestHeaders {
   std::string content_sha256;
 };
 
+struct AwsSignerStats {
+  uint64_t signatures = 0;       ///< Requests signed
+  uint64_t key_derivations = 0;  ///< Signing keys derived (cache misses)
+};
+
 /**
  * @brief Encapsulates AWS Signature V4 logic.
  * Handles canonicalization, date formatting, and signature generation.
+ *
+ * Requests always carry the same three signed headers (host,
+ * x-amz-content-sha256, x-amz-date) and an empty payload, so the canonical
+ * request is written straight into a reused per-thread buffer instead of
+ * going through a generic header map. The signing key (the HMAC chain over
+ * date, region and service) only changes once a day: each thread keeps the
+ * last one and re-derives it only when the date or credentials change.
  */
 class AwsSigner {
  public:
@@ -24,7 +40,8 @@ class AwsSigner {
    * @param cfg S3 Configuration (Access Key, Secret, Region, Service).
    * @param method HTTP Method (GET, PUT, etc.).
    * @param host The calculated Host header (e.g., "mybucket.s3.amazonaws.com").
-   * @param uri_path The absolute path (e.g., "/my-file.wav").
+   * @param uri_path The absolute, already URI-encoded path (e.g.,
+   * "/my-file.wav"), exactly as sent in the request line.
    * @return A struct containing the computed headers.
    */
   static SignedRequestHeaders sign(const config::S3Config& cfg,
@@ -32,8 +49,27 @@ class AwsSigner {
                                    const std::string& host,
                                    const std::string& uri_path);
 
+  /**
+   * @brief Same as above, at a given time.
+   */
+  static SignedRequestHeaders sign(const config::S3Config& cfg,
+                                   boost::beast::http::verb method,
+                                   const std::string& host,
+                                   const std::string& uri_path,
+                                   std::time_t now);
+
+  static AwsSignerStats get_stats();
+
  private:
+  using Digest = std::array<uint8_t, 32>;
+
   static std::tm get_safe_gmtime(std::time_t timer);
+
+  /**
+   * @brief The kSigning key for `date` (YYYYMMDD), from this thread's cache.
+   */
+  static const Digest& signing_key(const config::S3Config& cfg,
+                                   std::string_view date);
 };
 
 }  // namespace hermes::net::s3
@@ -0,0 +1,243 @@
+#include "S3RangedDownloader.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/experimental/channel.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <exception>
+#include <memory>
+
+#include "S3RequestFactory.hpp"
+
+using namespace hermes::config;
+namespace hermes::net::s3 {
+
+namespace {
+
+std::unexpected<ErrorInfo> download_error(std::string message) {
+  return std::unexpected(
+      ErrorInfo::From(AppError::NetworkError, std::move(message)));
+}
+
+}  // namespace
+
+S3RangedDownloader::S3RangedDownloader(boost::asio::io_context& ioc,
+                                       S3Config cfg)
+    : ioc_(ioc), cfg_(std::move(cfg)) {}
+
+std::expected<std::unique_ptr<S3RangedDownloader>, ErrorInfo>
+S3RangedDownloader::create(boost::asio::io_context& ioc, const S3Config& cfg) {
+  if (cfg.access_key.empty()) {
+    spdlog::error("S3RangedDownloader created without valid credentials.");
+    return std::unexpected(
+        ErrorInfo::From(AppError::ConfigError, "Missing S3 Configuration"));
+  }
+  return std::unique_ptr<S3RangedDownloader>(new S3RangedDownloader(ioc, cfg));
+}
+
+boost::asio::awaitable<std::expected<void, ErrorInfo>>
+S3RangedDownloader::download(
+    const std::string& file_key, const std::filesystem::path& destination,
+    std::shared_ptr<infra::DownloadProgress> progress) {
+  infra::PositionalFileSink sink(ioc_);
+  if (auto res = sink.Prepare(destination); !res) {
+    co_return std::unexpected(ErrorInfo::From(
+        AppError::FileSystemError, "Sink Prep Failed: " + res.error()));
+  }
+  if (progress) {
+    sink.on_prefix([progress](uint64_t bytes) { progress->advance(bytes); });
+  }
+
+  std::optional<uint64_t> first_last;
+  if (cfg_.part_size > 0) {
+    first_last = cfg_.part_size - 1;
+  }
+  // The object size is published as soon as the first headers arrive, so
+  // readers know the length before any body byte lands.
+  auto first = co_await fetch_range(
+      file_key, sink, 0, first_last, {},
+      [progress](const http::ResponseInfo& info) {
+        if (!progress) {
+          return;
+        }
+        if (info.status == 206 && info.complete_length) {
+          progress->set_total(*info.complete_length);
+        } else if (info.status == 200 && info.content_length) {
+          progress->set_total(*info.content_length);
+        }
+      });
+  if (!first) {
+    co_return std::unexpected(first.error());
+  }
+
+  // 200: the whole object (no Range asked, or the server ignored it).
+  uint64_t total = first->content_length.value_or(0);
+  if (first->status == 206) {
+    if (!first->complete_length) {
+      co_return download_error("Ranged GET without object size for " +
+                               file_key);
+    }
+    total = *first->complete_length;
+    if (total > cfg_.part_size) {
+      spdlog::info("[S3] {}: {} bytes in {} byte ranges, {} at a time.",
+                   file_key, total, cfg_.part_size,
+                   std::max<size_t>(cfg_.part_concurrency, 1));
+      if (first->etag.empty()) {
+        spdlog::warn("[S3] {}: no ETag, ranges cannot detect an overwrite.",
+                     file_key);
+      }
+      auto parts = co_await fetch_parts(file_key, sink, cfg_.part_size, total,
+                                        first->etag);
+      if (!parts) {
+        co_return std::unexpected(parts.error());
+      }
+    }
+  }
+
+  if (first->status == 206 || first->content_length) {
+    auto size = sink.Size();
+    if (!size) {
+      co_return std::unexpected(
+          ErrorInfo::From(AppError::FileSystemError, size.error()));
+    }
+    if (*size != total) {
+      co_return download_error(
+          std::format("Download size mismatch for {}. Expected: {}, Got: {}",
+                      file_key, total, *size));
+    }
+  }
+
+  if (auto res = sink.Commit(); !res) {
+    co_return std::unexpected(ErrorInfo::From(
+        AppError::FileSystemError, "Sink Commit Failed: " + res.error()));
+  }
+  co_return std::expected<void, ErrorInfo>();
+}
+
+boost::asio::awaitable<std::expected<http::ResponseInfo, ErrorInfo>>
+S3RangedDownloader::fetch_range(const std::string& file_key,
+                                infra::PositionalFileSink& sink,
+                                uint64_t first, std::optional<uint64_t> last,
+                                const std::string& if_match,
+                                std::function<void(const http::ResponseInfo&)>
+                                    on_headers) {
+  auto req = S3RequestFactory::create_signed_get_request(
+      cfg_, boost::beast::http::verb::get, file_key);
+  if (last) {
+    req.set(boost::beast::http::field::range,
+            std::format("bytes={}-{}", first, *last));
+  }
+  if (!if_match.empty()) {
+    req.set(boost::beast::http::field::if_match, if_match);
+  }
+
+  auto cursor = sink.at(first);
+  http::HttpStreamer streamer(ioc_);
+  auto info = co_await streamer.fetch(cfg_.host, cfg_.port, std::move(req),
+                                      cursor, std::move(on_headers));
+  if (!info) {
+    co_return std::unexpected(info.error());
+  }
+  if (info->status == 412) {
+    co_return download_error(std::format(
+        "Object {} changed during download (ETag {} no longer matches)",
+        file_key, if_match));
+  }
+
+  // A 206 must carry exactly the range asked for, clipped to the object
+  // end; a 200 is only acceptable for the first request.
+  if (info->status == 206 && last) {
+    uint64_t want = *last - first + 1;
+    if (info->complete_length && *info->complete_length > first) {
+      want = std::min(want, *info->complete_length - first);
+    }
+    if (cursor.written() != want) {
+      co_return download_error(std::format("Range {}-{} of {} returned {} bytes",
+                                           first, *last, file_key,
+                                           cursor.written()));
+    }
+  } else if (info->status == 200 && first != 0) {
+    co_return download_error("Server ignored Range for " + file_key);
+  }
+  co_return info;
+}
+
+boost::asio::awaitable<std::expected<void, ErrorInfo>>
+S3RangedDownloader::fetch_parts(const std::string& file_key,
+                                infra::PositionalFileSink& sink,
+                                uint64_t begin, uint64_t total,
+                                const std::string& etag) {
+  // Workers run on this io_context only, so the queue needs no lock.
+  struct PartQueue {
+    uint64_t next;
+    bool failed = false;
+  };
+  auto queue = std::make_shared<PartQueue>(PartQueue{begin});
+
+  const uint64_t part_size = cfg_.part_size;
+  const uint64_t parts = (total - begin + part_size - 1) / part_size;
+  const size_t workers = static_cast<size_t>(std::min<uint64_t>(
+      std::max<size_t>(cfg_.part_concurrency, 1), parts));
+
+  using ChannelType = boost::asio::experimental::channel<void(
+      boost::system::error_code, std::expected<void, ErrorInfo>)>;
+  auto ch = std::make_shared<ChannelType>(ioc_, workers);
+
+  for (size_t i = 0; i < workers; ++i) {
+    boost::asio::co_spawn(
+        ioc_,
+        [this, &file_key, &sink, &etag, queue, ch, part_size,
+         total]() -> boost::asio::awaitable<void> {
+          std::expected<void, ErrorInfo> res;
+          try {
+            while (!queue->failed && queue->next < total) {
+              const uint64_t first = queue->next;
+              const uint64_t last = std::min(first + part_size, total) - 1;
+              queue->next = last + 1;
+
+              auto info =
+                  co_await fetch_range(file_key, sink, first, last, etag);
+              if (info && (info->status != 206 ||
+                           info->complete_length != total ||
+                           (!etag.empty() && info->etag != etag))) {
+                info = download_error("Object " + file_key +
+                                      " changed during download");
+              }
+              if (!info) {
+                queue->failed = true;
+                res = std::unexpected(info.error());
+                break;
+              }
+            }
+          } catch (const std::exception& e) {
+            queue->failed = true;
+            res = std::unexpected(
+                ErrorInfo::From(AppError::Critical, e.what()));
+          }
+          ch->try_send(boost::system::error_code{}, res);
+        },
+        boost::asio::detached);
+  }
+
+  std::expected<void, ErrorInfo> final_res;
+  for (size_t i = 0; i < workers; ++i) {
+    boost::system::error_code ec;
+    auto res = co_await ch->async_receive(
+        boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+    if (ec) {
+      if (final_res) {
+        final_res = download_error("Channel sync error");
+      }
+    } else if (!res && final_res) {
+      final_res = res;
+    }
+  }
+  ch->close();
+  co_return final_res;
+}
+
+}  // namespace hermes::net::s3
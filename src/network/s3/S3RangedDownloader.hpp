@@ -0,0 +1,86 @@
+#pragma once
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "Config.hpp"
+#include "DownloadProgress.hpp"
+#include "HttpStreamer.hpp"
+#include "PositionalFileSink.hpp"
+#include "Types.hpp"
+
+namespace hermes::net::s3 {
+
+/**
+ * @brief Downloads an S3 object to a file as concurrent Range GETs.
+ *
+ * The first request asks for bytes [0, part_size); its Content-Range gives
+ * the object size. Anything beyond the first part is split into part_size
+ * ranges fetched by up to `part_concurrency` workers, each streaming its
+ * body straight to its offset in the file. The transfer only succeeds when
+ * every range came back with exactly the requested length and the file adds
+ * up to the object size. A server that ignores Range answers the first
+ * request with the whole object (200), which is accepted as is.
+ *
+ * Later ranges carry If-Match with the first response's ETag, so an object
+ * overwritten mid-transfer fails the download (412) instead of stitching
+ * two versions together.
+ *
+ * With a DownloadProgress, the object size and the growth of the written
+ * prefix are published as they happen, for progressive playback.
+ *
+ * Requests go through the io_context's HttpConnectionPool, so at most
+ * `http_pool.max_per_host` ranges are on separate connections; the rest
+ * pipeline behind them.
+ */
+class S3RangedDownloader {
+ public:
+  static std::expected<std::unique_ptr<S3RangedDownloader>, config::ErrorInfo>
+  create(boost::asio::io_context& ioc, const config::S3Config& cfg);
+
+  /**
+   * @brief Fetches `file_key` into `destination` (written as
+   * "<destination>.part" and renamed once complete).
+   * @param progress Optional; receives the size and prefix as they grow.
+   * The caller publishes the final result.
+   */
+  boost::asio::awaitable<std::expected<void, config::ErrorInfo>> download(
+      const std::string& file_key, const std::filesystem::path& destination,
+      std::shared_ptr<infra::DownloadProgress> progress = nullptr);
+
+ private:
+  /**
+   * @brief GETs bytes [first, last] (or the whole object when `last` is
+   * nullopt) into the sink at `first`.
+   * @param if_match ETag the object must still have ("" = unconditional);
+   * a 412 comes back as an "object changed" error.
+   */
+  boost::asio::awaitable<std::expected<http::ResponseInfo, config::ErrorInfo>>
+  fetch_range(const std::string& file_key, infra::PositionalFileSink& sink,
+              uint64_t first, std::optional<uint64_t> last,
+              const std::string& if_match = {},
+              std::function<void(const http::ResponseInfo&)> on_headers = {});
+
+  /**
+   * @brief Fetches [begin, total) in part_size ranges, part_concurrency at a
+   * time, each conditional on `etag`. Returns the first failure after all
+   * workers have stopped.
+   */
+  boost::asio::awaitable<std::expected<void, config::ErrorInfo>> fetch_parts(
+      const std::string& file_key, infra::PositionalFileSink& sink,
+      uint64_t begin, uint64_t total, const std::string& etag);
+
+  S3RangedDownloader(boost::asio::io_context& ioc, config::S3Config cfg);
+
+  boost::asio::io_context& ioc_;
+  config::S3Config cfg_;
+};
+
+}  // namespace hermes::net::s3
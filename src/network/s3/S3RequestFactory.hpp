@@ -2,7 +2,6 @@
 
 #include "Config.hpp"
 #include "Types.hpp"
-#include "awssigv4.h"
 #include "boost/beast/http/empty_body.hpp"
 
 namespace hermes::net::s3 {
@@ -28,6 +28,18 @@ class WebSocketSessionObserver : public service::ISessionObserver {
       j["bytes"] = stats.total_bytes_sent;
       j["packets"] = stats.packets_sent;
       j["underruns"] = stats.underruns;
+      boost::json::array clients;
+      for (const auto& client : stats.clients) {
+        boost::json::object c;
+        c["endpoint"] = client.endpoint;
+        c["fraction_lost"] = client.fraction_lost;
+        c["cumulative_lost"] = client.cumulative_lost;
+        c["jitter_ms"] = client.jitter_ms;
+        c["rtt_ms"] = client.rtt_ms;
+        c["nacked_packets"] = client.nacked_packets;
+        clients.push_back(std::move(c));
+      }
+      j["clients"] = std::move(clients);
       session->send(boost::json::serialize(j));
     }
   }
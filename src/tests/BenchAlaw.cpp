@@ -0,0 +1,119 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Alaw.hpp"
+#include "BenchSupport.hpp"
+
+/**
+ * @file BenchAlaw.cpp
+ * @brief A-law encode / decode variants against the per-sample reference,
+ * for one 20 ms 8 kHz frame (the RTP hot path) and a 64 K-sample block
+ * (transcoding).
+ */
+using namespace hermes::audio;
+using namespace hermes::bench;
+
+namespace {
+
+constexpr std::size_t FRAME = 160;
+constexpr std::size_t BLOCK = 65536;
+
+void bench_encode(const std::vector<int16_t>& pcm, std::size_t n,
+                  int iterations) {
+  std::vector<uint8_t> out(n);
+  std::vector<uint8_t> want(n);
+  std::printf("encode %zu samples\n", n);
+
+  const double reference = ns_per_call(
+      [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+          want[i] = encode_alaw_reference(pcm[i]);
+        }
+        do_not_optimize(want);
+      },
+      iterations);
+  print_row("reference", reference, reference);
+
+  struct {
+    const char* name;
+    ALawVariant variant;
+  } const variants[] = {{"table", ALawVariant::Table},
+                        {"branchless", ALawVariant::Branchless},
+                        {"simd", ALawVariant::Simd}};
+  for (const auto& v : variants) {
+    boost::span<const int16_t> in(pcm.data(), n);
+    const double ns = ns_per_call(
+        [&] {
+          encode_alaw(in, out, v.variant);
+          do_not_optimize(out);
+        },
+        iterations);
+    print_row(v.name, ns, reference);
+    if (out != want) {
+      std::fprintf(stderr, "%s: output differs from reference\n", v.name);
+      std::exit(EXIT_FAILURE);
+    }
+  }
+}
+
+void bench_decode(const std::vector<uint8_t>& alaw, std::size_t n,
+                  int iterations) {
+  std::vector<int16_t> out(n);
+  std::vector<int16_t> want(n);
+  std::printf("decode %zu samples\n", n);
+
+  const double reference = ns_per_call(
+      [&] {
+        for (std::size_t i = 0; i < n; ++i) {
+          want[i] = decode_alaw_reference(alaw[i]);
+        }
+        do_not_optimize(want);
+      },
+      iterations);
+  print_row("reference", reference, reference);
+
+  boost::span<const uint8_t> in(alaw.data(), n);
+  const double table = ns_per_call(
+      [&] {
+        decode_alaw_table(in, out);
+        do_not_optimize(out);
+      },
+      iterations);
+  print_row("table", table, reference);
+  const bool table_ok = out == want;
+
+  const double simd = ns_per_call(
+      [&] {
+        decode_alaw(in, out);
+        do_not_optimize(out);
+      },
+      iterations);
+  print_row("simd", simd, reference);
+
+  if (!table_ok || out != want) {
+    std::fprintf(stderr, "decode output differs from reference\n");
+    std::exit(EXIT_FAILURE);
+  }
+}
+
+}  // namespace
+
+int main() {
+  // Speech-like spread over all segments rather than one constant.
+  std::vector<int16_t> pcm(BLOCK);
+  std::vector<uint8_t> alaw(BLOCK);
+  uint32_t state = 1;
+  for (std::size_t i = 0; i < BLOCK; ++i) {
+    state = state * 1664525U + 1013904223U;
+    pcm[i] = static_cast<int16_t>(state >> 16);
+    alaw[i] = static_cast<uint8_t>(state >> 24);
+  }
+
+  bench_encode(pcm, FRAME, 200000);
+  bench_encode(pcm, BLOCK, 500);
+  bench_decode(alaw, FRAME, 200000);
+  bench_decode(alaw, BLOCK, 500);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "AudioMath.hpp"
+#include "AudioMathSimd.hpp"
+#include "BenchSupport.hpp"
+#include "PcmCast.hpp"
+
+/**
+ * @file BenchMix.cpp
+ * @brief Mixer kernels: SSE4.1 / AVX2 against the scalar *_reference path.
+ *
+ * Mixes 16 inputs into one 20 ms 48 kHz stereo frame per call, the worst
+ * case MixerNode accepts. Variants the CPU lacks are skipped.
+ */
+using namespace hermes::audio;
+using namespace hermes::bench;
+
+namespace {
+
+constexpr std::size_t FRAME_SAMPLES = 1920;
+constexpr std::size_t INPUTS = 16;
+constexpr int ITERATIONS = 20000;
+
+using SumFn = void (*)(std::span<int32_t>, std::span<const int16_t>);
+using ExportFn = void (*)(std::span<const int32_t>, std::span<uint8_t>);
+
+struct Variant {
+  const char* name;
+  simd::MixIsa needs;
+  SumFn sum;
+  ExportFn compress;
+};
+
+const Variant VARIANTS[] = {
+    {"reference (std::tanh)", simd::MixIsa::Scalar,
+     AudioMath::sum_buffers_reference, AudioMath::compress_and_export_reference},
+    {"scalar (fast_tanh)", simd::MixIsa::Scalar, simd::sum_buffers_scalar,
+     simd::compress_and_export_scalar},
+    {"SSE4.1", simd::MixIsa::Sse41, simd::sum_buffers_sse41,
+     simd::compress_and_export_sse41},
+    {"AVX2", simd::MixIsa::Avx2, simd::sum_buffers_avx2,
+     simd::compress_and_export_avx2},
+};
+
+}  // namespace
+
+int main() {
+  // Loud inputs so the soft clip is exercised, not just the linear region.
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> sample(-20000, 20000);
+  std::vector<std::vector<int16_t>> inputs(INPUTS,
+                                           std::vector<int16_t>(FRAME_SAMPLES));
+  for (auto& input : inputs) {
+    for (auto& s : input) {
+      s = static_cast<int16_t>(sample(rng));
+    }
+  }
+
+  std::vector<int32_t> accumulator(FRAME_SAMPLES);
+  std::vector<uint8_t> output(FRAME_SAMPLES * sizeof(int16_t));
+  std::vector<int32_t> expected_acc(FRAME_SAMPLES);
+  std::vector<uint8_t> expected_out(output.size());
+
+  auto mix = [&](const Variant& v, std::span<int32_t> acc,
+                 std::span<uint8_t> out) {
+    std::fill(acc.begin(), acc.end(), 0);
+    for (const auto& input : inputs) {
+      v.sum(acc, input);
+    }
+    v.compress(acc, out);
+  };
+
+  mix(VARIANTS[0], expected_acc, expected_out);
+
+  std::printf("Mix %zu x %zu samples, active ISA: %.*s\n", INPUTS,
+              FRAME_SAMPLES, static_cast<int>(simd::to_string(simd::active_isa()).size()),
+              simd::to_string(simd::active_isa()).data());
+
+  int mismatches = 0;
+  double baseline = 0.0;
+  for (const auto& v : VARIANTS) {
+    if (v.needs > simd::active_isa()) {
+      std::printf("  %-28s %10s\n", v.name, "(unsupported)");
+      continue;
+    }
+
+    mix(v, accumulator, output);
+    if (accumulator != expected_acc) {
+      std::fprintf(stderr, "%s: accumulator differs from reference\n", v.name);
+      ++mismatches;
+    }
+    for (std::size_t i = 0; i < FRAME_SAMPLES; ++i) {
+      const int diff = pcm::read_sample(output.data(), i) -
+                       pcm::read_sample(expected_out.data(), i);
+      if (std::abs(diff) > 1) {
+        std::fprintf(stderr, "%s: sample %zu off by %d LSB\n", v.name, i, diff);
+        ++mismatches;
+        break;
+      }
+    }
+
+    const double ns = ns_per_call(
+        [&] {
+          mix(v, accumulator, output);
+          do_not_optimize(output);
+        },
+        ITERATIONS);
+    if (baseline == 0.0) {
+      baseline = ns;
+    }
+    print_row(v.name, ns, baseline);
+  }
+  return mismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "BenchSupport.hpp"
+#include "Resampler.hpp"
+
+/**
+ * @file BenchResampler.cpp
+ * @brief Cost of converting one 20 ms output frame of a WAV input to the
+ * session rate: 48 kHz and 44.1 kHz (mono and stereo) down to 8 kHz, and
+ * 44.1 kHz up to 48 kHz.
+ */
+using namespace hermes::audio;
+using namespace hermes::bench;
+
+namespace {
+
+constexpr int ITERATIONS = 20000;
+
+struct Case {
+  const char* name;
+  uint32_t input_rate;
+  uint32_t output_rate;
+  uint16_t channels;
+};
+
+/** @brief ns per output frame, pushing only what each pull needs. */
+double run(const Case& c, double& baseline) {
+  const size_t out_frame = c.output_rate / 50;
+  // Enough input for one frame at the worst rounding, in sample frames.
+  const size_t in_frame = (out_frame * c.input_rate / c.output_rate) + 2;
+
+  std::vector<int16_t> input(in_frame * c.channels);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<int16_t>(
+        10000.0 * std::sin(2.0 * std::numbers::pi * 440.0 *
+                           static_cast<double>(i / c.channels) / c.input_rate));
+  }
+  std::vector<int16_t> output(out_frame);
+
+  Resampler resampler(c.input_rate, c.output_rate, c.channels, out_frame,
+                      in_frame);
+  size_t cursor = 0;
+  auto frame = [&] {
+    while (!resampler.can_produce(out_frame)) {
+      // A quarter of a frame at a time, like a streaming source.
+      const size_t frames = std::min<size_t>(in_frame / 4 + 1, in_frame);
+      if (cursor + frames > in_frame) {
+        cursor = 0;
+      }
+      resampler.push(std::span<const int16_t>(
+          input.data() + (cursor * c.channels), frames * c.channels));
+      cursor += frames;
+    }
+    resampler.pull(output);
+    do_not_optimize(output);
+  };
+
+  const double ns = ns_per_call(frame, ITERATIONS);
+  if (baseline == 0.0) {
+    baseline = ns;
+  }
+  print_row(c.name, ns, baseline);
+  return ns;
+}
+
+}  // namespace
+
+int main() {
+  std::printf("Resampler, one 20 ms output frame, dot product: %.*s\n",
+              static_cast<int>(Resampler::active_isa().size()),
+              Resampler::active_isa().data());
+
+  const Case cases[] = {
+      {"48k mono -> 8k", 48000, 8000, 1},
+      {"48k stereo -> 8k", 48000, 8000, 2},
+      {"44.1k mono -> 8k", 44100, 8000, 1},
+      {"44.1k stereo -> 8k", 44100, 8000, 2},
+      {"44.1k stereo -> 48k", 44100, 48000, 2},
+  };
+  double baseline = 0.0;
+  for (const auto& c : cases) {
+    run(c, baseline);
+  }
+  return EXIT_SUCCESS;
+}
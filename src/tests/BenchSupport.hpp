@@ -0,0 +1,66 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+
+/**
+ * @file BenchSupport.hpp
+ * @brief Timing helpers for the micro-benchmark executables.
+ *
+ * Benchmarks are plain executables (not CTest targets): they print
+ * nanoseconds per call and exit non-zero only when a variant under test
+ * disagrees with its reference implementation.
+ */
+namespace hermes::bench {
+
+/** @brief Keeps the optimizer from discarding a result it cannot see used. */
+template <typename T>
+inline void do_not_optimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * @brief Best-of-`rounds` mean time of `body()`, in ns per call.
+ * The minimum filters out scheduler noise better than the mean.
+ */
+template <typename Body>
+double ns_per_call(Body&& body, int iterations, int rounds = 5) {
+  using clock = std::chrono::steady_clock;
+  double best = 0.0;
+  for (int round = 0; round < rounds; ++round) {
+    const auto start = clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      body();
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+        clock::now() - start;
+    const double per_call = elapsed.count() / iterations;
+    if (round == 0 || per_call < best) {
+      best = per_call;
+    }
+  }
+  return best;
+}
+
+inline void print_row(std::string_view name, double ns, double baseline_ns) {
+  std::printf("  %-28.*s %10.1f ns  %6.2fx\n", static_cast<int>(name.size()),
+              name.data(), ns, baseline_ns / ns);
+}
+
+/**
+ * @brief print_row() plus throughput: `items` (packets, signatures, ...)
+ * are handled per call of `ns`.
+ */
+inline void print_rate_row(std::string_view name, double ns, double baseline_ns,
+                           double items, std::string_view unit) {
+  std::printf("  %-28.*s %10.1f ns  %6.2fx  %12.0f %.*s/s\n",
+              static_cast<int>(name.size()), name.data(), ns, baseline_ns / ns,
+              items * 1e9 / ns, static_cast<int>(unit.size()), unit.data());
+}
+
+}  // namespace hermes::bench
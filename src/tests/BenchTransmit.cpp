@@ -0,0 +1,136 @@
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <boost/asio/post.hpp>
+#include <boost/json.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ActiveSessions.hpp"
+#include "BenchSupport.hpp"
+#include "IoContextPool.hpp"
+#include "NodeFactory.hpp"
+#include "NodeRegistry.hpp"
+#include "RTPStreamer.hpp"
+
+/**
+ * @file BenchTransmit.cpp
+ * @brief Session build + teardown through the /transmit path: the request
+ * body is parsed and handed to ActiveSessions::create_session() (graph,
+ * executor, streamer), then the session is stopped with remove_session()
+ * and destroyed on its io_context thread, as in production. Reports p50 /
+ * p99 latency with graph nodes from node_memory_resource() and with plain
+ * new/delete. Streaming blocks (BufferPool) are only taken when a session
+ * starts, so they are not on this path.
+ */
+using namespace hermes;
+using namespace hermes::bench;
+namespace json = boost::json;
+
+namespace {
+
+constexpr int WARMUP = 500;
+constexpr int ITERATIONS = 20000;
+
+// Four files with options into a mixer, streamed to two clients.
+constexpr const char* BODY = R"({"flow": {
+  "start_node": {"id": "mix"},
+  "nodes": [
+    {"id": "a", "type": "fileInput", "data": {"fileName": "bench_a.wav"}},
+    {"id": "b", "type": "fileInput", "data": {"fileName": "bench_b.wav"}},
+    {"id": "c", "type": "fileInput", "data": {"fileName": "bench_c.wav"}},
+    {"id": "d", "type": "fileInput", "data": {"fileName": "bench_d.wav"}},
+    {"id": "oa", "type": "fileOptions", "data": {"gain": 0.5, "pitch_shift": 0.0}},
+    {"id": "ob", "type": "fileOptions", "data": {"gain": 0.5, "pitch_shift": 0.0}},
+    {"id": "oc", "type": "fileOptions", "data": {"gain": 0.5, "pitch_shift": 0.0}},
+    {"id": "od", "type": "fileOptions", "data": {"gain": 0.5, "pitch_shift": 0.0}},
+    {"id": "mix", "type": "mixer", "data": {}},
+    {"id": "out", "type": "clients", "data": {"clients": [
+      {"ip": "127.0.0.1", "port": 40000},
+      {"ip": "127.0.0.1", "port": 40002}]}}],
+  "edges": [
+    {"source": "oa", "target": "a"}, {"source": "ob", "target": "b"},
+    {"source": "oc", "target": "c"}, {"source": "od", "target": "d"},
+    {"source": "a", "target": "mix"}, {"source": "b", "target": "mix"},
+    {"source": "c", "target": "mix"}, {"source": "d", "target": "mix"}]}})";
+
+/**
+ * @brief One POST /transmit and its stop, until the session is gone. The
+ * pool has one io_context, so a post queued after the stop runs after the
+ * session's teardown.
+ */
+double transmit_and_stop_ns(service::ActiveSessions& active,
+                            infra::IoContextPool& pool) {
+  using clock = std::chrono::steady_clock;
+  const auto start = clock::now();
+
+  const json::value body = json::parse(BODY);
+  auto id =
+      active.create_session(body.as_object(), config::SessionType::Standard);
+  if (!id) {
+    std::fprintf(stderr, "create_session: %s\n", id.error().message.c_str());
+    std::exit(EXIT_FAILURE);
+  }
+  active.remove_session(*id);
+
+  std::promise<void> torn_down;
+  boost::asio::post(pool.get_io_context(),
+                    [&torn_down] { torn_down.set_value(); });
+  torn_down.get_future().wait();
+
+  const std::chrono::duration<double, std::nano> elapsed =
+      clock::now() - start;
+  return elapsed.count();
+}
+
+void bench_sessions(const char* name, bool pooled,
+                    service::ActiveSessions& active,
+                    infra::IoContextPool& pool) {
+  audio::node_pooling_enabled() = pooled;
+  for (int i = 0; i < WARMUP; ++i) {
+    do_not_optimize(transmit_and_stop_ns(active, pool));
+  }
+
+  std::vector<double> ns(ITERATIONS);
+  for (auto& sample : ns) {
+    sample = transmit_and_stop_ns(active, pool);
+  }
+  std::ranges::sort(ns);
+  const auto at = [&ns](double q) {
+    return ns[static_cast<std::size_t>(q * static_cast<double>(ns.size() - 1))];
+  };
+  std::printf("  %-28s p50 %8.1f us  p99 %8.1f us\n", name, at(0.50) / 1e3,
+              at(0.99) / 1e3);
+}
+
+}  // namespace
+
+int main() {
+  // create/remove log every session at info (and warn without a WebSocket).
+  spdlog::set_level(spdlog::level::err);
+
+  const config::AppConfig cfg{};
+  audio::register_builtin_nodes();
+  net::rtp::RTPStreamer::configure(cfg.rtcp);
+
+  auto pool = infra::IoContextPool::create(1, cfg.egress);
+  if (!pool) {
+    std::fprintf(stderr, "IoContextPool: %s\n", pool.error().message.c_str());
+    return EXIT_FAILURE;
+  }
+  (*pool)->run();
+  auto active = std::make_shared<service::ActiveSessions>(**pool, cfg);
+
+  std::printf("POST /transmit + stop, %d sessions (10-node graph)\n",
+              ITERATIONS);
+  bench_sessions("pooled nodes", true, *active, **pool);
+  bench_sessions("new/delete nodes", false, *active, **pool);
+
+  (*pool)->stop();
+  return EXIT_SUCCESS;
+}
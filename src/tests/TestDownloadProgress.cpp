@@ -0,0 +1,125 @@
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "DownloadProgress.hpp"
+#include "TestSupport.hpp"
+
+/**
+ * @file TestDownloadProgress.cpp
+ * @brief wait_for() releases a reader once its bytes are on disk or the
+ * download ended, never earlier, also across io_contexts.
+ */
+using namespace hermes;
+using infra::DownloadProgress;
+namespace asio = boost::asio;
+
+namespace {
+
+/** @brief Spawns wait_for(bytes) and bumps `woken` when it returns. */
+void spawn_wait(asio::io_context& io, std::shared_ptr<DownloadProgress> progress,
+                uint64_t bytes, int& woken) {
+  asio::co_spawn(
+      io,
+      [progress = std::move(progress), bytes,
+       &woken]() -> asio::awaitable<void> {
+        co_await progress->wait_for(bytes);
+        ++woken;
+      },
+      asio::detached);
+}
+
+}  // namespace
+
+HERMES_TEST(download_progress_wait_for_returns_at_threshold) {
+  asio::io_context io;
+  auto progress = std::make_shared<DownloadProgress>();
+  int small = 0;
+  int large = 0;
+  spawn_wait(io, progress, 100, small);
+  spawn_wait(io, progress, 300, large);
+  io.poll();
+  HERMES_CHECK_EQ(small + large, 0);
+
+  progress->advance(99);
+  io.poll();
+  HERMES_CHECK_EQ(small, 0);
+
+  progress->advance(100);
+  io.poll();
+  HERMES_CHECK_EQ(small, 1);
+  HERMES_CHECK_EQ(large, 0);
+
+  // The prefix never shrinks: a stale report neither lowers it nor wakes.
+  progress->advance(50);
+  HERMES_CHECK_EQ(progress->available(), 100U);
+
+  progress->advance(1000);
+  io.poll();
+  HERMES_CHECK_EQ(large, 1);
+  HERMES_CHECK(!progress->done());
+}
+
+HERMES_TEST(download_progress_satisfied_wait_does_not_suspend) {
+  asio::io_context io;
+  auto progress = std::make_shared<DownloadProgress>();
+  progress->advance(64);
+  int woken = 0;
+  spawn_wait(io, progress, 64, woken);
+  io.poll();
+  HERMES_CHECK_EQ(woken, 1);
+}
+
+HERMES_TEST(download_progress_finish_releases_every_waiter) {
+  asio::io_context io;
+  auto progress = std::make_shared<DownloadProgress>();
+  progress->set_total(1000);
+  int woken = 0;
+  spawn_wait(io, progress, 500, woken);
+  spawn_wait(io, progress, 1000, woken);
+  progress->advance(10);
+  io.poll();
+  HERMES_CHECK_EQ(woken, 0);
+
+  // A failed download still ends the wait; readers then check result().
+  progress->finish(std::unexpected(config::ErrorInfo::From(
+      config::AppError::NetworkError, "simulated failure")));
+  io.poll();
+  HERMES_CHECK_EQ(woken, 2);
+  HERMES_CHECK(progress->done());
+  HERMES_CHECK(!progress->result().has_value());
+  HERMES_CHECK(progress->total() == std::optional<uint64_t>(1000));
+
+  // Waiting on a finished download returns immediately.
+  io.restart();
+  spawn_wait(io, progress, 5000, woken);
+  io.poll();
+  HERMES_CHECK_EQ(woken, 3);
+}
+
+HERMES_TEST(download_progress_wakes_reader_on_another_io_context) {
+  asio::io_context reader_io;
+  auto progress = std::make_shared<DownloadProgress>();
+  int woken = 0;
+  spawn_wait(reader_io, progress, 256, woken);
+  reader_io.poll();
+
+  // The writer publishes from its own thread; the reader's run() returns
+  // only once its waiter was woken there.
+  std::thread writer([progress] {
+    asio::io_context writer_io;
+    asio::post(writer_io, [progress] {
+      progress->advance(128);
+      progress->advance(256);
+    });
+    writer_io.run();
+  });
+  reader_io.run();
+  writer.join();
+  HERMES_CHECK_EQ(woken, 1);
+}
@@ -0,0 +1,190 @@
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "DownloadRegistry.hpp"
+#include "TestSupport.hpp"
+
+/**
+ * @file TestDownloadRegistry.cpp
+ * @brief Single-flight semantics: joins share one transfer, a finished
+ * flight is never joined, failures are not cached.
+ */
+using namespace hermes;
+using infra::DownloadRegistry;
+namespace asio = boost::asio;
+
+namespace {
+
+/** @brief A fresh, empty directory under the system temp dir. */
+std::filesystem::path scratch_dir(const std::string& name) {
+  auto dir = std::filesystem::temp_directory_path() / ("hermes_tests_" + name);
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  return dir;
+}
+
+/**
+ * @brief A downloader that counts its calls, waits a little (so others can
+ * join) and then writes `bytes` bytes to `path`, or fails.
+ */
+DownloadRegistry::Downloader fake_download(asio::io_context& io,
+                                           std::filesystem::path path,
+                                           std::shared_ptr<int> calls,
+                                           bool succeed, std::size_t bytes = 64) {
+  return [&io, path = std::move(path), calls, succeed, bytes](
+             std::shared_ptr<infra::DownloadProgress> progress)
+             -> asio::awaitable<DownloadRegistry::Result> {
+    ++*calls;
+    progress->set_total(bytes);
+    asio::steady_timer timer(io, std::chrono::milliseconds(20));
+    co_await timer.async_wait(asio::use_awaitable);
+    if (!succeed) {
+      co_return std::unexpected(config::ErrorInfo::From(
+          config::AppError::NetworkError, "simulated failure"));
+    }
+    std::ofstream(path, std::ios::binary) << std::string(bytes, 'x');
+    progress->advance(bytes);
+    co_return DownloadRegistry::Result{};
+  };
+}
+
+/** @brief Spawns an ensure() whose outcome lands in `ok` (1 / 0). */
+void spawn_ensure(asio::io_context& io, const std::string& key,
+                  const std::filesystem::path& path,
+                  DownloadRegistry::Downloader download, int& ok) {
+  asio::co_spawn(
+      io,
+      [key, path, download = std::move(download),
+       &ok]() -> asio::awaitable<void> {
+        auto result =
+            co_await DownloadRegistry::instance().ensure(key, path, download);
+        ok = result.has_value() ? 1 : 0;
+      },
+      asio::detached);
+}
+
+}  // namespace
+
+HERMES_TEST(download_registry_existing_file_is_a_hit) {
+  auto dir = scratch_dir("dl_hit");
+  auto path = dir / "present.wav";
+  std::ofstream(path) << "data";
+
+  asio::io_context io;
+  auto calls = std::make_shared<int>(0);
+  const auto before = DownloadRegistry::instance().get_stats();
+  auto progress = DownloadRegistry::instance().start(
+      io.get_executor(), "present.wav", path,
+      fake_download(io, path, calls, true));
+  io.run();
+
+  const auto after = DownloadRegistry::instance().get_stats();
+  HERMES_CHECK(progress == nullptr);
+  HERMES_CHECK_EQ(*calls, 0);
+  HERMES_CHECK_EQ(after.hits, before.hits + 1);
+  HERMES_CHECK_EQ(after.started, before.started);
+  std::filesystem::remove_all(dir);
+}
+
+HERMES_TEST(download_registry_concurrent_requests_share_one_transfer) {
+  auto dir = scratch_dir("dl_join");
+  auto path = dir / "shared.wav";
+
+  asio::io_context io;
+  auto calls = std::make_shared<int>(0);
+  const auto before = DownloadRegistry::instance().get_stats();
+
+  int first = -1;
+  int second = -1;
+  int third = -1;
+  spawn_ensure(io, "shared.wav", path, fake_download(io, path, calls, true),
+               first);
+  spawn_ensure(io, "shared.wav", path, fake_download(io, path, calls, true),
+               second);
+  spawn_ensure(io, "shared.wav", path, fake_download(io, path, calls, true),
+               third);
+  io.run();
+
+  const auto after = DownloadRegistry::instance().get_stats();
+  HERMES_CHECK_EQ(*calls, 1);
+  HERMES_CHECK(first == 1 && second == 1 && third == 1);
+  HERMES_CHECK_EQ(after.started, before.started + 1);
+  HERMES_CHECK_EQ(after.waits, before.waits + 2);
+  HERMES_CHECK_EQ(after.bytes_saved, before.bytes_saved + 2 * 64);
+  HERMES_CHECK_EQ(after.in_flight, 0U);
+  HERMES_CHECK(std::filesystem::exists(path));
+
+  // The flight is retired: the next request finds the file, not the flight.
+  auto progress = DownloadRegistry::instance().start(
+      io.get_executor(), "shared.wav", path,
+      fake_download(io, path, calls, true));
+  HERMES_CHECK(progress == nullptr);
+  HERMES_CHECK_EQ(*calls, 1);
+  std::filesystem::remove_all(dir);
+}
+
+HERMES_TEST(download_registry_failure_reaches_every_waiter_and_is_retried) {
+  auto dir = scratch_dir("dl_fail");
+  auto path = dir / "broken.wav";
+
+  asio::io_context io;
+  auto calls = std::make_shared<int>(0);
+  const auto before = DownloadRegistry::instance().get_stats();
+
+  int first = -1;
+  int second = -1;
+  spawn_ensure(io, "broken.wav", path, fake_download(io, path, calls, false),
+               first);
+  spawn_ensure(io, "broken.wav", path, fake_download(io, path, calls, false),
+               second);
+  io.run();
+
+  HERMES_CHECK_EQ(*calls, 1);
+  HERMES_CHECK(first == 0 && second == 0);
+  HERMES_CHECK_EQ(DownloadRegistry::instance().get_stats().failed,
+                  before.failed + 1);
+  HERMES_CHECK(!std::filesystem::exists(path));
+
+  // A failure is not remembered: the next request downloads again.
+  int retry = -1;
+  io.restart();
+  spawn_ensure(io, "broken.wav", path, fake_download(io, path, calls, true),
+               retry);
+  io.run();
+  HERMES_CHECK_EQ(*calls, 2);
+  HERMES_CHECK_EQ(retry, 1);
+  std::filesystem::remove_all(dir);
+}
+
+HERMES_TEST(download_registry_joiners_see_progress_before_completion) {
+  auto dir = scratch_dir("dl_progress");
+  auto path = dir / "progressive.wav";
+
+  asio::io_context io;
+  auto calls = std::make_shared<int>(0);
+  auto leader = DownloadRegistry::instance().start(
+      io.get_executor(), "progressive.wav", path,
+      fake_download(io, path, calls, true, 128));
+  auto joiner = DownloadRegistry::instance().start(
+      io.get_executor(), "progressive.wav", path,
+      fake_download(io, path, calls, true, 128));
+
+  HERMES_CHECK(leader != nullptr);
+  HERMES_CHECK(leader == joiner);
+  HERMES_CHECK(!leader->done());
+
+  io.run();
+  HERMES_CHECK(leader->done());
+  HERMES_CHECK(leader->result().has_value());
+  HERMES_CHECK_EQ(leader->available(), 128U);
+  HERMES_CHECK(leader->total() == std::optional<uint64_t>(128));
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,199 @@
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/json.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "AudioExecutor.hpp"
+#include "Json2Graph.hpp"
+#include "NodeRegistry.hpp"
+#include "TestSupport.hpp"
+
+/**
+ * @file TestFrameAllocations.cpp
+ * @brief AudioExecutor::get_next_frame must not touch the heap.
+ *
+ * Replaces the global operator new with a counter that only counts while
+ * the test thread is inside the measured loop, then drives prepared graphs
+ * for FRAMES frames each. Background threads (transcoding, logging) may
+ * allocate freely.
+ */
+
+namespace {
+thread_local bool counting = false;
+std::size_t allocations = 0;
+
+void* counted_alloc(std::size_t size, std::size_t alignment) {
+  if (counting) {
+    ++allocations;
+  }
+  if (size == 0) {
+    size = 1;
+  }
+  void* p = alignment > alignof(std::max_align_t)
+                ? std::aligned_alloc(alignment,
+                                     (size + alignment - 1) / alignment * alignment)
+                : std::malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+}  // namespace
+
+void* operator new(std::size_t size) { return counted_alloc(size, 0); }
+void* operator new[](std::size_t size) { return counted_alloc(size, 0); }
+void* operator new(std::size_t size, std::align_val_t al) {
+  return counted_alloc(size, static_cast<std::size_t>(al));
+}
+void* operator new[](std::size_t size, std::align_val_t al) {
+  return counted_alloc(size, static_cast<std::size_t>(al));
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+using namespace hermes;
+
+namespace {
+
+constexpr int WARMUP_FRAMES = 10;
+constexpr int FRAMES = 400;
+
+/** @brief Writes a 16-bit PCM WAV of `seconds` of a square-ish tone. */
+void write_wav(const std::string& path, uint32_t rate, uint16_t channels,
+               uint32_t seconds) {
+  const uint32_t samples = rate * seconds * channels;
+  const uint32_t data_bytes = samples * 2;
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  auto u32 = [&](uint32_t v) { out.write(reinterpret_cast<char*>(&v), 4); };
+  auto u16 = [&](uint16_t v) { out.write(reinterpret_cast<char*>(&v), 2); };
+  out.write("RIFF", 4);
+  u32(36 + data_bytes);
+  out.write("WAVEfmt ", 8);
+  u32(16);
+  u16(1);  // PCM
+  u16(channels);
+  u32(rate);
+  u32(rate * channels * 2);
+  u16(static_cast<uint16_t>(channels * 2));
+  u16(16);
+  out.write("data", 4);
+  u32(data_bytes);
+  for (uint32_t i = 0; i < samples; ++i) {
+    u16(static_cast<uint16_t>((i / 40) % 2 == 0 ? 8000 : -8000));
+  }
+}
+
+/**
+ * @brief Parses and prepares `flow_json`, then counts the heap allocations
+ * made by FRAMES calls to get_next_frame().
+ */
+void expect_no_frame_allocations(const char* flow_json) {
+  boost::asio::io_context io;
+  auto graph = infra::parse_graph(io, boost::json::parse(flow_json).as_object());
+  HERMES_CHECK(graph.has_value());
+  if (!graph) {
+    return;
+  }
+
+  auto executor = audio::AudioExecutor::create(io, *graph, config::S3Config{});
+  HERMES_CHECK(executor.has_value());
+  if (!executor) {
+    return;
+  }
+
+  bool prepared = false;
+  boost::asio::co_spawn(
+      io, (*executor)->prepare(),
+      [&prepared](std::exception_ptr e,
+                  std::expected<void, config::ErrorInfo> result) {
+        prepared = !e && result.has_value();
+      });
+  io.run();
+  HERMES_CHECK(prepared);
+  if (!prepared) {
+    return;
+  }
+
+  std::vector<uint8_t> frame(config::MAX_FRAME_SIZE_BYTES);
+  const auto& geometry = (*executor)->geometry();
+  auto out = std::span(frame).first((*executor)->is_passthrough()
+                                        ? geometry.samples_per_frame()
+                                        : geometry.frame_bytes());
+  for (int i = 0; i < WARMUP_FRAMES; ++i) {
+    (*executor)->get_next_frame(out);
+  }
+
+  allocations = 0;
+  bool all_produced = true;
+  counting = true;
+  for (int i = 0; i < FRAMES; ++i) {
+    auto [more, status] = (*executor)->get_next_frame(out);
+    all_produced = all_produced && more && status.ok();
+  }
+  counting = false;
+
+  HERMES_CHECK(all_produced);
+  HERMES_CHECK_EQ(allocations, 0U);
+  if (allocations != 0) {
+    std::fprintf(stderr, "  %zu allocation(s) in %d frames\n", allocations,
+                 FRAMES);
+  }
+}
+
+}  // namespace
+
+HERMES_TEST(single_file_8k) {
+  expect_no_frame_allocations(R"({"flow": {
+    "start_node": {"id": "a"},
+    "nodes": [{"id": "a", "type": "fileInput", "data": {"fileName": "alloc_8k.wav"}}],
+    "edges": []}})");
+}
+
+HERMES_TEST(mixer_with_gain_8k) {
+  expect_no_frame_allocations(R"({"flow": {
+    "start_node": {"id": "mix"},
+    "nodes": [
+      {"id": "a", "type": "fileInput", "data": {"fileName": "alloc_8k.wav"}},
+      {"id": "b", "type": "fileInput", "data": {"fileName": "alloc_8k_b.wav"}},
+      {"id": "opts", "type": "fileOptions", "data": {"gain": 0.5, "pitch_shift": 0.0}},
+      {"id": "mix", "type": "mixer", "data": {}}],
+    "edges": [
+      {"source": "opts", "target": "b"},
+      {"source": "a", "target": "mix"},
+      {"source": "b", "target": "mix"}]}})");
+}
+
+HERMES_TEST(resampled_44k1_stereo_into_48k) {
+  expect_no_frame_allocations(R"({"flow": {
+    "audio": {"sampleRate": 48000, "frameMs": 20},
+    "start_node": {"id": "a"},
+    "nodes": [{"id": "a", "type": "fileInput", "data": {"fileName": "alloc_44k1.wav"}}],
+    "edges": []}})");
+}
+
+int main(int argc, char** argv) {
+  std::filesystem::create_directories("downloads");
+  write_wav("downloads/alloc_8k.wav", 8000, 1, 12);
+  write_wav("downloads/alloc_8k_b.wav", 8000, 1, 12);
+  write_wav("downloads/alloc_44k1.wav", 44100, 2, 12);
+  audio::register_builtin_nodes();
+  return tests::run_all(argc, argv);
+}
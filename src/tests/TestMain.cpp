@@ -0,0 +1,8 @@
+#include "TestSupport.hpp"
+
+/**
+ * @file TestMain.cpp
+ * @brief Entry point of hermes_tests: runs every HERMES_TEST linked in, or
+ * only those named on the command line.
+ */
+int main(int argc, char** argv) { return hermes::tests::run_all(argc, argv); }
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "PositionalFileSink.hpp"
+#include "TestSupport.hpp"
+
+/**
+ * @file TestPositionalFileSink.cpp
+ * @brief Extents written out of order merge into one prefix, and the prefix
+ * listener fires exactly when [0, n) grows.
+ */
+using namespace hermes;
+using infra::PositionalFileSink;
+namespace asio = boost::asio;
+
+namespace {
+
+/** @brief A fresh, empty directory under the system temp dir. */
+std::filesystem::path scratch_dir(const std::string& name) {
+  auto dir = std::filesystem::temp_directory_path() / ("hermes_tests_" + name);
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  return dir;
+}
+
+/** @brief Writes `count` copies of `fill` at `offset` and runs to completion. */
+void write_at(asio::io_context& io, PositionalFileSink& sink, uint64_t offset,
+              std::size_t count, char fill) {
+  const std::string data(count, fill);
+  auto cursor = sink.at(offset);
+  std::size_t left = data.size();
+  while (left > 0) {
+    std::size_t done = 0;
+    cursor.async_write_some(
+        asio::buffer(data.data() + (data.size() - left), left),
+        [&done](boost::system::error_code ec, std::size_t n) {
+          HERMES_CHECK(!ec);
+          done = n;
+        });
+    io.restart();
+    io.run();
+    HERMES_CHECK(done > 0);
+    left -= done;
+  }
+  HERMES_CHECK_EQ(cursor.written(), count);
+}
+
+}  // namespace
+
+HERMES_TEST(positional_sink_prefix_grows_only_from_zero) {
+  auto dir = scratch_dir("pfs_prefix");
+  asio::io_context io;
+  PositionalFileSink sink(io);
+  HERMES_CHECK(sink.Prepare(dir / "asset.wav").has_value());
+
+  std::vector<uint64_t> prefixes;
+  sink.on_prefix([&prefixes](uint64_t n) { prefixes.push_back(n); });
+
+  // Gaps in front: nothing is readable yet.
+  write_at(io, sink, 30, 10, 'd');
+  write_at(io, sink, 10, 10, 'b');
+  HERMES_CHECK(prefixes.empty());
+
+  // [0, 10) touches [10, 20): the prefix jumps past the merged extent.
+  // (A short write may report an intermediate length first.)
+  write_at(io, sink, 0, 10, 'a');
+  HERMES_CHECK(!prefixes.empty());
+  HERMES_CHECK_EQ(prefixes.back(), 20U);
+
+  // Filling the hole merges both neighbours at once.
+  write_at(io, sink, 20, 10, 'c');
+  HERMES_CHECK_EQ(prefixes.back(), 40U);
+
+  // A rewrite inside the prefix reports it unchanged, never shorter.
+  const std::size_t reported = prefixes.size();
+  write_at(io, sink, 5, 10, 'x');
+  HERMES_CHECK(prefixes.size() > reported);
+  for (std::size_t i = reported; i < prefixes.size(); ++i) {
+    HERMES_CHECK_EQ(prefixes[i], 40U);
+  }
+
+  // An extent that bridges several others swallows them all.
+  write_at(io, sink, 50, 5, 'f');
+  write_at(io, sink, 60, 5, 'h');
+  write_at(io, sink, 45, 25, 'g');
+  HERMES_CHECK_EQ(prefixes.back(), 40U);
+  write_at(io, sink, 40, 5, 'e');
+  HERMES_CHECK_EQ(prefixes.back(), 70U);
+  HERMES_CHECK(std::ranges::is_sorted(prefixes));
+
+  HERMES_CHECK(sink.Commit().has_value());
+  std::ifstream in(dir / "asset.wav", std::ios::binary);
+  const std::string content{std::istreambuf_iterator<char>(in), {}};
+  HERMES_CHECK_EQ(content.size(), 70U);
+  HERMES_CHECK_EQ(content.substr(0, 20), "aaaaaxxxxxxxxxxbbbbb");
+  HERMES_CHECK_EQ(content.substr(20, 20), std::string(10, 'c') +
+                                              std::string(10, 'd'));
+  HERMES_CHECK_EQ(content.substr(40), std::string(5, 'e') +
+                                          std::string(25, 'g'));
+  HERMES_CHECK(!std::filesystem::exists(dir / "asset.wav.part"));
+  std::filesystem::remove_all(dir);
+}
+
+HERMES_TEST(positional_sink_uncommitted_file_is_removed) {
+  auto dir = scratch_dir("pfs_abort");
+  {
+    asio::io_context io;
+    PositionalFileSink sink(io);
+    HERMES_CHECK(sink.Prepare(dir / "aborted.wav").has_value());
+    write_at(io, sink, 0, 16, 'z');
+    HERMES_CHECK(std::filesystem::exists(dir / "aborted.wav.part"));
+  }
+  HERMES_CHECK(!std::filesystem::exists(dir / "aborted.wav.part"));
+  HERMES_CHECK(!std::filesystem::exists(dir / "aborted.wav"));
+  std::filesystem::remove_all(dir);
+}
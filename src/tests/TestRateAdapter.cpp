@@ -0,0 +1,101 @@
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+
+#include "RateAdapter.hpp"
+#include "TestSupport.hpp"
+
+/**
+ * @file TestRateAdapter.cpp
+ * @brief Codec-side rate conversion: pass-through, tone levels, anti-aliasing.
+ */
+using namespace hermes::audio;
+
+namespace {
+
+constexpr double AMPLITUDE = 10000.0;
+
+/**
+ * @brief Feeds `frames` 20 ms frames of a `freq` Hz sine through the adapter
+ * and returns the RMS of the output, skipping the first frames (filter
+ * delay).
+ */
+double output_rms(RateAdapter& adapter, double freq, int frames) {
+  const size_t in_per_frame = adapter.input_rate() / 50;
+  std::vector<int16_t> frame(in_per_frame);
+  double sum_sq = 0.0;
+  size_t counted = 0;
+  size_t n = 0;
+  for (int f = 0; f < frames; ++f) {
+    for (auto& s : frame) {
+      s = static_cast<int16_t>(
+          AMPLITUDE * std::sin(2.0 * std::numbers::pi * freq *
+                               static_cast<double>(n++) / adapter.input_rate()));
+    }
+    auto out = adapter.process(frame);
+    HERMES_CHECK_EQ(out.size(),
+                    in_per_frame * adapter.output_rate() / adapter.input_rate());
+    if (f < 2) {
+      continue;
+    }
+    for (int16_t s : out) {
+      sum_sq += static_cast<double>(s) * s;
+      ++counted;
+    }
+  }
+  return counted == 0 ? 0.0 : std::sqrt(sum_sq / static_cast<double>(counted));
+}
+
+double db(double rms) { return 20.0 * std::log10(rms / (AMPLITUDE / std::sqrt(2.0))); }
+
+}  // namespace
+
+HERMES_TEST(rate_adapter_equal_rates_pass_through) {
+  RateAdapter adapter(8000, 8000);
+  std::vector<int16_t> frame(160, 1234);
+  auto out = adapter.process(frame);
+  HERMES_CHECK(out.data() == frame.data());
+  HERMES_CHECK_EQ(out.size(), frame.size());
+}
+
+HERMES_TEST(rate_adapter_downsampling_keeps_the_pass_band) {
+  for (uint32_t input : {16000U, 48000U}) {
+    RateAdapter adapter(input, 8000);
+    const double level = db(output_rms(adapter, 1000.0, 20));
+    HERMES_CHECK(std::abs(level) < 0.5);
+  }
+}
+
+HERMES_TEST(rate_adapter_downsampling_rejects_aliases) {
+  // 6 kHz and 5 kHz would fold to 2 kHz and 3 kHz at 8 kHz. A 2- or
+  // 6-sample box average lets them through at -3 to -12 dB.
+  for (uint32_t input : {16000U, 48000U}) {
+    for (double freq : {5000.0, 6000.0}) {
+      RateAdapter adapter(input, 8000);
+      const double level = db(output_rms(adapter, freq, 20));
+      HERMES_CHECK(level < -40.0);
+    }
+  }
+}
+
+HERMES_TEST(rate_adapter_upsampling_keeps_the_tone) {
+  RateAdapter adapter(8000, 16000);
+  const double level = db(output_rms(adapter, 1000.0, 20));
+  HERMES_CHECK(std::abs(level) < 1.0);
+}
+
+HERMES_TEST(rate_adapter_reset_restarts_cleanly) {
+  RateAdapter adapter(48000, 8000);
+  std::vector<int16_t> loud(960, 20000);
+  std::vector<int16_t> silence(960, 0);
+  adapter.process(loud);
+  adapter.reset();
+  auto out = adapter.process(silence);
+  bool silent = true;
+  for (int16_t s : out) {
+    silent = silent && s == 0;
+  }
+  HERMES_CHECK(silent);
+}
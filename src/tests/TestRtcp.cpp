@@ -0,0 +1,202 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Rtcp.hpp"
+#include "TestSupport.hpp"
+
+/**
+ * @file TestRtcp.cpp
+ * @brief RTCP wire format: the SR + SDES we send, byte for byte, and the
+ * RR / SR report blocks and generic NACKs we parse out of compound packets.
+ */
+using namespace hermes::net::rtp;
+
+namespace {
+
+/** @brief Appends `v` big-endian. */
+void put32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(static_cast<uint8_t>(v >> 24));
+  out.push_back(static_cast<uint8_t>(v >> 16));
+  out.push_back(static_cast<uint8_t>(v >> 8));
+  out.push_back(static_cast<uint8_t>(v));
+}
+
+uint32_t get32(const std::vector<uint8_t>& in, std::size_t at) {
+  return (static_cast<uint32_t>(in[at]) << 24) |
+         (static_cast<uint32_t>(in[at + 1]) << 16) |
+         (static_cast<uint32_t>(in[at + 2]) << 8) | in[at + 3];
+}
+
+/** @brief RTCP header: V=2, `count` in RC/FMT, length in words minus one. */
+void put_header(std::vector<uint8_t>& out, uint8_t count, uint8_t type,
+                std::size_t words) {
+  out.push_back(static_cast<uint8_t>(0x80 | count));
+  out.push_back(type);
+  out.push_back(static_cast<uint8_t>((words - 1) >> 8));
+  out.push_back(static_cast<uint8_t>(words - 1));
+}
+
+/** @brief One 24-byte report block; `lost` is the raw 24-bit field. */
+void put_block(std::vector<uint8_t>& out, uint32_t source, uint8_t fraction,
+               uint32_t lost, uint32_t jitter, uint32_t lsr, uint32_t dlsr) {
+  put32(out, source);
+  put32(out, (static_cast<uint32_t>(fraction) << 24) | (lost & 0xFFFFFF));
+  put32(out, 0x0001'0203);  // Extended highest sequence
+  put32(out, jitter);
+  put32(out, lsr);
+  put32(out, dlsr);
+}
+
+}  // namespace
+
+HERMES_TEST(rtcp_sender_report_layout) {
+  const rtcp::SenderInfo info{.ssrc = 0x1122'3344,
+                              .ntp_timestamp = 0xAABB'CCDD'0102'0304,
+                              .rtp_timestamp = 0x0A0B'0C0D,
+                              .packet_count = 500,
+                              .octet_count = 80000};
+  std::array<uint8_t, rtcp::MAX_SENDER_REPORT_SIZE> buf{};
+  const std::size_t n = rtcp::write_sender_report(buf, info, "hermes-1");
+
+  // SR: 28 bytes. SDES: 4 header + 4 SSRC + 2 + 8 CNAME + 1 END = 19 -> 20.
+  HERMES_CHECK_EQ(n, 48U);
+  const std::vector<uint8_t> out(buf.begin(), buf.begin() + n);
+  HERMES_CHECK(rtcp::is_rtcp(out));
+  HERMES_CHECK_EQ(out[0], 0x80);  // V=2, no report blocks
+  HERMES_CHECK_EQ(out[1], rtcp::PT_SR);
+  HERMES_CHECK_EQ(out[3], 6);  // 7 words
+  HERMES_CHECK_EQ(get32(out, 4), 0x1122'3344U);
+  HERMES_CHECK_EQ(get32(out, 8), 0xAABB'CCDDU);
+  HERMES_CHECK_EQ(get32(out, 12), 0x0102'0304U);
+  HERMES_CHECK_EQ(get32(out, 16), 0x0A0B'0C0DU);
+  HERMES_CHECK_EQ(get32(out, 20), 500U);
+  HERMES_CHECK_EQ(get32(out, 24), 80000U);
+
+  HERMES_CHECK_EQ(out[28], 0x81);  // One SDES chunk
+  HERMES_CHECK_EQ(out[29], rtcp::PT_SDES);
+  HERMES_CHECK_EQ(out[31], 4);  // 5 words
+  HERMES_CHECK_EQ(get32(out, 32), 0x1122'3344U);
+  HERMES_CHECK_EQ(out[36], 1);  // CNAME
+  HERMES_CHECK_EQ(out[37], 8);
+  HERMES_CHECK_EQ(std::string(out.begin() + 38, out.begin() + 46), "hermes-1");
+  HERMES_CHECK(out[46] == 0 && out[47] == 0);  // END + padding
+
+  // Our own report carries no report blocks.
+  std::vector<rtcp::ReportBlock> reports;
+  std::vector<rtcp::Nack> nacks;
+  HERMES_CHECK(rtcp::parse_feedback(out, reports, nacks));
+  HERMES_CHECK(reports.empty() && nacks.empty());
+}
+
+HERMES_TEST(rtcp_sender_report_bounds) {
+  std::array<uint8_t, rtcp::MAX_SENDER_REPORT_SIZE> buf{};
+  const std::string long_cname(200, 'x');
+  const std::size_t n = rtcp::write_sender_report(buf, {}, long_cname);
+  HERMES_CHECK_EQ(n, rtcp::MAX_SENDER_REPORT_SIZE);  // CNAME cut to MAX_CNAME
+  HERMES_CHECK_EQ(buf[28 + 9], rtcp::MAX_CNAME);
+
+  std::array<uint8_t, 40> small{};
+  HERMES_CHECK_EQ(rtcp::write_sender_report(small, {}, "hermes-1"), 0U);
+}
+
+HERMES_TEST(rtcp_parses_compound_rr_sdes_and_nack) {
+  std::vector<uint8_t> packet;
+  // RR with two blocks, the second with a negative cumulative loss.
+  put_header(packet, 2, rtcp::PT_RR, 2 + 2 * 6);
+  put32(packet, 0xDEAD'0001);
+  put_block(packet, 0x0000'00A1, 64, 12, 160, 0x1234'5678, 0x0001'0000);
+  put_block(packet, 0x0000'00A2, 0, 0xFFFFFE, 0, 0, 0);
+  // SDES: skipped.
+  put_header(packet, 1, rtcp::PT_SDES, 3);
+  put32(packet, 0xDEAD'0001);
+  put32(packet, 0x0100'0000);
+  // Generic NACK: PID + BLP with 3 bits, then PID alone: 4 + 1 lost.
+  put_header(packet, rtcp::FMT_GENERIC_NACK, rtcp::PT_RTPFB, 5);
+  put32(packet, 0xDEAD'0001);
+  put32(packet, 0x0000'00A1);
+  put32(packet, (100U << 16) | 0b1000'0000'0000'0101);
+  put32(packet, 200U << 16);
+
+  std::vector<rtcp::ReportBlock> reports;
+  std::vector<rtcp::Nack> nacks;
+  HERMES_CHECK(rtcp::parse_feedback(packet, reports, nacks));
+  HERMES_CHECK_EQ(reports.size(), 2U);
+  HERMES_CHECK_EQ(nacks.size(), 1U);
+
+  const auto& first = reports[0];
+  HERMES_CHECK_EQ(first.reporter_ssrc, 0xDEAD'0001U);
+  HERMES_CHECK_EQ(first.source_ssrc, 0xA1U);
+  HERMES_CHECK_EQ(first.fraction_lost, 64);
+  HERMES_CHECK_EQ(first.cumulative_lost, 12);
+  HERMES_CHECK_EQ(first.highest_sequence, 0x0001'0203U);
+  HERMES_CHECK_EQ(first.jitter, 160U);
+  HERMES_CHECK_EQ(first.last_sr, 0x1234'5678U);
+  HERMES_CHECK_EQ(first.delay_since_last_sr, 0x0001'0000U);
+  HERMES_CHECK_EQ(reports[1].source_ssrc, 0xA2U);
+  HERMES_CHECK_EQ(reports[1].cumulative_lost, -2);  // Sign-extended 24 bits
+
+  HERMES_CHECK_EQ(nacks[0].reporter_ssrc, 0xDEAD'0001U);
+  HERMES_CHECK_EQ(nacks[0].media_ssrc, 0xA1U);
+  HERMES_CHECK_EQ(nacks[0].lost_packets, 5U);
+}
+
+HERMES_TEST(rtcp_parses_report_blocks_after_sender_info) {
+  std::vector<uint8_t> packet;
+  put_header(packet, 1, rtcp::PT_SR, 7 + 6);
+  put32(packet, 0xBEEF'0002);
+  for (int i = 0; i < 5; ++i) {
+    put32(packet, 0xFFFF'FFFF);  // Sender info: must not be read as a block
+  }
+  put_block(packet, 0x0000'00B1, 128, 3, 80, 0, 0);
+
+  std::vector<rtcp::ReportBlock> reports;
+  std::vector<rtcp::Nack> nacks;
+  HERMES_CHECK(rtcp::parse_feedback(packet, reports, nacks));
+  HERMES_CHECK_EQ(reports.size(), 1U);
+  HERMES_CHECK_EQ(reports[0].reporter_ssrc, 0xBEEF'0002U);
+  HERMES_CHECK_EQ(reports[0].source_ssrc, 0xB1U);
+  HERMES_CHECK_EQ(reports[0].fraction_lost, 128);
+  HERMES_CHECK_EQ(reports[0].jitter, 80U);
+}
+
+HERMES_TEST(rtcp_malformed_keeps_what_was_parsed) {
+  std::vector<uint8_t> packet;
+  put_header(packet, 1, rtcp::PT_RR, 2 + 6);
+  put32(packet, 0xDEAD'0001);
+  put_block(packet, 0x0000'00A1, 0, 1, 0, 0, 0);
+  // Second RR claims a block it does not carry.
+  put_header(packet, 1, rtcp::PT_RR, 2);
+  put32(packet, 0xDEAD'0001);
+
+  std::vector<rtcp::ReportBlock> reports;
+  std::vector<rtcp::Nack> nacks;
+  HERMES_CHECK(!rtcp::parse_feedback(packet, reports, nacks));
+  HERMES_CHECK_EQ(reports.size(), 1U);
+
+  // Length past the end of the datagram.
+  std::vector<uint8_t> overrun;
+  put_header(overrun, 0, rtcp::PT_RR, 10);
+  put32(overrun, 0xDEAD'0001);
+  reports.clear();
+  HERMES_CHECK(!rtcp::parse_feedback(overrun, reports, nacks));
+  HERMES_CHECK(reports.empty());
+
+  // RTP (PT 0) is not RTCP.
+  const std::vector<uint8_t> rtp = {0x80, 0x00, 0x12, 0x34, 0, 0, 0, 0};
+  HERMES_CHECK(!rtcp::is_rtcp(rtp));
+  HERMES_CHECK(!rtcp::parse_feedback(rtp, reports, nacks));
+}
+
+HERMES_TEST(rtcp_ntp_conversion) {
+  using namespace std::chrono;
+  // The Unix epoch is 2208988800 s after the NTP epoch; half a second is
+  // 0x80000000 in the fraction.
+  const auto half = system_clock::time_point(milliseconds(500));
+  const uint64_t ntp = rtcp::to_ntp(half);
+  HERMES_CHECK_EQ(ntp >> 32, 2208988800ULL);
+  HERMES_CHECK_EQ(ntp & 0xFFFF'FFFF, 0x8000'0000ULL);
+  HERMES_CHECK_EQ(rtcp::ntp_compact(ntp), 0x0000'8000U | (2208988800U << 16));
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdio>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file TestSupport.hpp
+ * @brief Minimal self-registering test harness for the in-tree CTest targets.
+ *
+ * Checks stay active in Release builds (no assert()), and a failing check
+ * does not abort the test, so one run reports every broken expectation.
+ */
+namespace hermes::tests {
+
+struct TestCase {
+  std::string_view name;
+  void (*run)();
+};
+
+inline std::vector<TestCase>& registry() {
+  static std::vector<TestCase> tests;
+  return tests;
+}
+
+/** @brief Failed checks so far; a test binary exits non-zero if any. */
+inline int& failures() {
+  static int count = 0;
+  return count;
+}
+
+struct Registrar {
+  Registrar(std::string_view name, void (*run)()) {
+    registry().push_back({name, run});
+  }
+};
+
+inline void report_failure(const char* file, int line, const char* expr) {
+  std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+  ++failures();
+}
+
+/** @brief Runs every registered test, optionally only those named in argv. */
+inline int run_all(int argc, char** argv) {
+  int ran = 0;
+  for (const auto& test : registry()) {
+    bool selected = argc <= 1;
+    for (int i = 1; i < argc; ++i) {
+      selected = selected || test.name == argv[i];
+    }
+    if (!selected) {
+      continue;
+    }
+    const int before = failures();
+    test.run();
+    std::printf("[%s] %s\n", failures() == before ? "  OK  " : " FAIL ",
+                test.name.data());
+    ++ran;
+  }
+  std::printf("%d test(s), %d failed check(s)\n", ran, failures());
+  return failures() == 0 && ran > 0 ? 0 : 1;
+}
+
+}  // namespace hermes::tests
+
+#define HERMES_TEST(name)                                              \
+  static void name();                                                  \
+  static const ::hermes::tests::Registrar name##_registrar{#name, name}; \
+  static void name()
+
+#define HERMES_CHECK(expr)                                              \
+  do {                                                                  \
+    if (!(expr)) {                                                      \
+      ::hermes::tests::report_failure(__FILE__, __LINE__, #expr);       \
+    }                                                                   \
+  } while (false)
+
+#define HERMES_CHECK_EQ(a, b) HERMES_CHECK((a) == (b))
@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "TestSupport.hpp"
+#include "WavUtils.hpp"
+
+/**
+ * @file TestWavFormat.cpp
+ * @brief parse_format() reads the "fmt " chunk, and is_pcm16() rejects what
+ * the decoders cannot take: other encodings and sample rates the resampler
+ * would divide by zero on or build an unbounded filter bank for.
+ */
+using namespace hermes::audio;
+
+namespace {
+
+template <typename T>
+void put(std::vector<uint8_t>& out, T v) {
+  const auto at = out.size();
+  out.resize(at + sizeof(T));
+  std::memcpy(out.data() + at, &v, sizeof(T));
+}
+
+/** @brief RIFF/WAVE header with a 16-byte "fmt " chunk and an empty "data". */
+std::vector<uint8_t> wav_header(uint32_t rate, uint16_t channels = 1,
+                                uint16_t bits = 16) {
+  const auto block_align = static_cast<uint16_t>(channels * bits / 8);
+  std::vector<uint8_t> out;
+  out.insert(out.end(), {'R', 'I', 'F', 'F'});
+  put<uint32_t>(out, 36);
+  out.insert(out.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+  put<uint32_t>(out, 16);
+  put<uint16_t>(out, wav::WavFormat::FORMAT_PCM);
+  put<uint16_t>(out, channels);
+  put<uint32_t>(out, rate);
+  put<uint32_t>(out, rate * block_align);
+  put<uint16_t>(out, block_align);
+  put<uint16_t>(out, bits);
+  out.insert(out.end(), {'d', 'a', 't', 'a'});
+  put<uint32_t>(out, 0);
+  return out;
+}
+
+}  // namespace
+
+HERMES_TEST(wav_parse_format_reads_fmt_chunk) {
+  const auto header = wav_header(44100, 2);
+  const auto format = wav::parse_format(header);
+  HERMES_CHECK(format.has_value());
+  HERMES_CHECK_EQ(format->sample_rate, 44100U);
+  HERMES_CHECK_EQ(format->channels, 2);
+  HERMES_CHECK_EQ(format->block_align, 4);
+  HERMES_CHECK(format->is_pcm16());
+  HERMES_CHECK_EQ(wav::get_audio_data_offset(header), header.size());
+
+  const std::vector<uint8_t> raw(64, 0);
+  HERMES_CHECK(!wav::parse_format(raw).has_value());
+}
+
+HERMES_TEST(wav_is_pcm16_bounds_sample_rate) {
+  for (uint32_t rate : {1U, 8000U, 48000U, wav::WavFormat::MAX_SAMPLE_RATE}) {
+    HERMES_CHECK(wav::parse_format(wav_header(rate))->is_pcm16());
+  }
+  // Zero would divide by zero in Resampler::output_length(); a huge (prime)
+  // rate would size the filter bank by it.
+  for (uint32_t rate :
+       {0U, wav::WavFormat::MAX_SAMPLE_RATE + 1, 4294967291U}) {
+    HERMES_CHECK(!wav::parse_format(wav_header(rate))->is_pcm16());
+  }
+}
+
+HERMES_TEST(wav_is_pcm16_rejects_other_encodings) {
+  HERMES_CHECK(!wav::parse_format(wav_header(8000, 1, 8))->is_pcm16());
+  HERMES_CHECK(!wav::parse_format(wav_header(8000, 1, 24))->is_pcm16());
+  HERMES_CHECK(!wav::parse_format(wav_header(8000, 0))->is_pcm16());
+
+  auto format = *wav::parse_format(wav_header(8000));
+  format.audio_format = 3;  // IEEE float
+  HERMES_CHECK(!format.is_pcm16());
+  format.audio_format = wav::WavFormat::FORMAT_EXTENSIBLE;
+  HERMES_CHECK(format.is_pcm16());
+  format.block_align = 4;  // Disagrees with one 16-bit channel
+  HERMES_CHECK(!format.is_pcm16());
+}
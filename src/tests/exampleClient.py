@@ -3,6 +3,8 @@ import struct
 import audioop
 import pyaudio
 import binascii
+import hashlib
+import hmac
 import sys
 
 # Handle TOML parsing depending on Python version
@@ -38,17 +40,33 @@ def load_crypto_config(config_path="../../config.toml"):
         # Convert hex strings back to raw 16-byte arrays
         master_key = binascii.unhexlify(key_hex)
         salt = binascii.unhexlify(salt_hex)
+        use_srtp = config["crypto"].get("srtp", False)
 
         if len(master_key) != 16 or len(salt) != 16:
             raise ValueError("Master key and salt must both be exactly 16 bytes (32 hex chars).")
 
-        return master_key, salt
+        return master_key, salt, use_srtp
     except Exception as e:
         print(f"[!] Failed to load crypto config from {config_path}: {e}")
         sys.exit(1)
 
 # Load the keys globally for the session
-MASTER_KEY, MASTER_SALT = load_crypto_config()
+MASTER_KEY, MASTER_SALT, USE_SRTP = load_crypto_config()
+
+# RFC 3711 SRTP (AES_CM_128_HMAC_SHA1_80): the master salt is the first 14
+# bytes of the configured salt; session keys come from the AES-CM PRF.
+SRTP_TAG_SIZE = 10
+
+def srtp_derive(label, length):
+    iv = bytearray(MASTER_SALT[:14]) + b"\x00\x00"
+    iv[7] ^= label
+    prf = Cipher(algorithms.AES(MASTER_KEY), modes.CTR(bytes(iv)), backend=default_backend()).encryptor()
+    return prf.update(b"\x00" * length) + prf.finalize()
+
+if USE_SRTP:
+    SRTP_KEY = srtp_derive(0x00, 16)
+    SRTP_AUTH_KEY = srtp_derive(0x01, 20)
+    SRTP_SALT = srtp_derive(0x02, 14)
 
 # ============================================================================
 # 2. Audio Hardware Setup
@@ -67,7 +85,7 @@ audio_stream = p.open(
 sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
 sock.bind((LISTEN_IP, LISTEN_PORT))
 print(f"[*] Hermes-Flow Receiver Online")
-print(f"[*] Listening for AES-CTR SRTP on {LISTEN_IP}:{LISTEN_PORT}...")
+print(f"[*] Listening for {'SRTP' if USE_SRTP else 'AES-CTR'} on {LISTEN_IP}:{LISTEN_PORT}...")
 print(f"[*] Loaded dynamic config keys.")
 
 # ============================================================================
@@ -151,14 +169,35 @@ try:
         # 5. Calculate Per-Packet IV (AES-CTR Counter Logic)
         packet_index = (v_roc << 16) | seq_num
 
-        iv_mutable = bytearray(base_iv)
-        tail_64bit = struct.unpack('<Q', iv_mutable[8:16])[0]
-        tail_64bit ^= packet_index
-        iv_mutable[8:16] = struct.pack('<Q', tail_64bit)
-        current_iv = bytes(iv_mutable)
+        if USE_SRTP:
+            # Verify the HMAC-SHA1-80 tag over header || payload || ROC
+            if len(packet) < 12 + SRTP_TAG_SIZE:
+                continue
+            authenticated, tag = packet[:-SRTP_TAG_SIZE], packet[-SRTP_TAG_SIZE:]
+            expected = hmac.new(SRTP_AUTH_KEY, authenticated + struct.pack('!I', v_roc), hashlib.sha1).digest()
+            if not hmac.compare_digest(expected[:SRTP_TAG_SIZE], tag):
+                print("[!] SRTP authentication failed, dropping packet")
+                continue
+            encrypted_payload = authenticated[12:]
+
+            # IV = salt ^ (SSRC << 64) ^ (index << 16)
+            iv_mutable = bytearray(SRTP_SALT) + b"\x00\x00"
+            for i, b in enumerate(struct.pack('!I', ssrc)):
+                iv_mutable[4 + i] ^= b
+            for i, b in enumerate(packet_index.to_bytes(6, 'big')):
+                iv_mutable[8 + i] ^= b
+            current_iv = bytes(iv_mutable)
+            key = SRTP_KEY
+        else:
+            iv_mutable = bytearray(base_iv)
+            tail_64bit = struct.unpack('<Q', iv_mutable[8:16])[0]
+            tail_64bit ^= packet_index
+            iv_mutable[8:16] = struct.pack('<Q', tail_64bit)
+            current_iv = bytes(iv_mutable)
+            key = session_key
 
         # 6. Decrypt Payload
-        cipher = Cipher(algorithms.AES(session_key), modes.CTR(current_iv), backend=default_backend())
+        cipher = Cipher(algorithms.AES(key), modes.CTR(current_iv), backend=default_backend())
         decryptor = cipher.decryptor()
         decrypted_alaw = decryptor.update(encrypted_payload) + decryptor.finalize()
 